@@ -0,0 +1,493 @@
+#include "driver_socketcan.hpp"
+
+#include <fcntl.h>
+#include <net/if.h>
+#include <unistd.h>
+
+#include <linux/can/raw.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+
+#include <cstring>
+#include <ctime>
+
+#include "gn10_can/core/fdcan_frame.hpp"
+
+namespace gn10_can {
+namespace drivers {
+
+namespace {
+
+// 送信時刻の取得に使う SO_TIMESTAMPING のフラグ (ソフトウェアタイムスタンプ)
+constexpr int TX_TIMESTAMPING_FLAGS = SOF_TIMESTAMPING_TX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+
+int64_t to_nanoseconds(const timespec& time)
+{
+    return static_cast<int64_t>(time.tv_sec) * 1000000000 + static_cast<int64_t>(time.tv_nsec);
+}
+
+/**
+ * @brief CLOCK_REALTIME から CLOCK_MONOTONIC への差を求める
+ *
+ * カーネルのタイムスタンプは CLOCK_REALTIME のため、取り出した時点の差で CLOCK_MONOTONIC に変換します。
+ *
+ * @return int64_t CLOCK_REALTIME - CLOCK_MONOTONIC [ns]
+ */
+int64_t realtime_offset()
+{
+    timespec realtime;
+    timespec monotonic;
+    clock_gettime(CLOCK_REALTIME, &realtime);
+    clock_gettime(CLOCK_MONOTONIC, &monotonic);
+    return to_nanoseconds(realtime) - to_nanoseconds(monotonic);
+}
+
+/**
+ * @brief カーネルのタイムスタンプを CLOCK_MONOTONIC [ns] に変換する
+ *
+ * @param time カーネルのタイムスタンプ (CLOCK_REALTIME)
+ * @param offset realtime_offset() の値
+ * @return uint64_t CLOCK_MONOTONIC [ns] (時刻なしの場合は0)
+ */
+uint64_t to_monotonic(const timespec& time, int64_t offset)
+{
+    if (time.tv_sec == 0 && time.tv_nsec == 0) {
+        return 0;
+    }
+    const int64_t monotonic = to_nanoseconds(time) - offset;
+    if (monotonic <= 0) {
+        return 1;
+    }
+    return static_cast<uint64_t>(monotonic);
+}
+
+}  // namespace
+
+template <std::size_t MaxDLC>
+BasicDriverSocketCAN<MaxDLC>::BasicDriverSocketCAN(bool bit_rate_switch)
+    : bit_rate_switch_(bit_rate_switch)
+{
+}
+
+template <std::size_t MaxDLC>
+BasicDriverSocketCAN<MaxDLC>::~BasicDriverSocketCAN()
+{
+    close();
+}
+
+template <std::size_t MaxDLC>
+bool BasicDriverSocketCAN<MaxDLC>::open(const char* interface_name)
+{
+    const unsigned int index = if_nametoindex(interface_name);
+    if (index == 0) {
+        return false;
+    }
+
+    int fd = ::socket(PF_CAN, SOCK_RAW | SOCK_CLOEXEC, CAN_RAW);
+    if (fd < 0) {
+        return false;
+    }
+
+    // CAN FD フレームの送受信を有効にする (インターフェースが未対応なら失敗する)
+    if constexpr (MaxDLC > 8) {
+        int enable = 1;
+        if (setsockopt(fd, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &enable, sizeof(enable)) != 0) {
+            ::close(fd);
+            return false;
+        }
+    }
+
+    sockaddr_can address{};
+    address.can_family  = AF_CAN;
+    address.can_ifindex = static_cast<int>(index);
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    if (!adopt(fd)) {
+        return false;
+    }
+    if (!apply_filters()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+template <std::size_t MaxDLC>
+bool BasicDriverSocketCAN<MaxDLC>::adopt(int fd)
+{
+    close();
+    if (fd < 0) {
+        return false;
+    }
+
+    const int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    // 受信時刻と受信キューのオーバーフロー数は取得できる場合だけ使用する
+    int enable = 1;
+    setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable));
+    setsockopt(fd, SOL_SOCKET, SO_RXQ_OVFL, &enable, sizeof(enable));
+
+    fd_                = fd;
+    rx_overrun_count_  = 0;
+    rx_oversize_count_ = 0;
+    last_rx_timestamp_ = 0;
+    if (tx_events_ && !apply_tx_timestamping()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+template <std::size_t MaxDLC>
+bool BasicDriverSocketCAN<MaxDLC>::enable_tx_events()
+{
+    tx_events_ = true;
+
+    // 開く前は open() / adopt() で設定する
+    if (fd_ < 0) {
+        return true;
+    }
+    return apply_tx_timestamping();
+}
+
+template <std::size_t MaxDLC>
+bool BasicDriverSocketCAN<MaxDLC>::apply_tx_timestamping()
+{
+    const int flags = TX_TIMESTAMPING_FLAGS;
+    return setsockopt(fd_, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) == 0;
+}
+
+template <std::size_t MaxDLC>
+void BasicDriverSocketCAN<MaxDLC>::close()
+{
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+template <std::size_t MaxDLC>
+bool BasicDriverSocketCAN<MaxDLC>::send(const Frame& frame)
+{
+    if (fd_ < 0) {
+        return false;
+    }
+
+    RawFrame raw;
+    const std::size_t size = encode(frame, raw);
+    return ::send(fd_, &raw, size, MSG_DONTWAIT) == static_cast<ssize_t>(size);
+}
+
+template <std::size_t MaxDLC>
+bool BasicDriverSocketCAN<MaxDLC>::receive(Frame& out_frame)
+{
+    return receive_many(&out_frame, 1) == 1;
+}
+
+template <std::size_t MaxDLC>
+bool BasicDriverSocketCAN<MaxDLC>::receive_tx_event(TxEvent& out_event)
+{
+    if (fd_ < 0 || !tx_events_) {
+        return false;
+    }
+
+    // エラーキューには送信したフレームが送出時刻の制御メッセージ付きで積まれる
+    while (true) {
+        RawFrame raw{};
+        std::array<char, CONTROL_SIZE> control{};
+        iovec buffer{&raw, sizeof(raw)};
+        msghdr header{};
+        header.msg_iov        = &buffer;
+        header.msg_iovlen     = 1;
+        header.msg_control    = control.data();
+        header.msg_controllen = control.size();
+
+        const ssize_t length = recvmsg(fd_, &header, MSG_ERRQUEUE | MSG_DONTWAIT);
+        if (length < 0) {
+            return false;
+        }
+        if (length != static_cast<ssize_t>(CAN_MTU) && length != static_cast<ssize_t>(CANFD_MTU)) {
+            continue;
+        }
+
+        uint64_t timestamp = 0;
+        for (cmsghdr* item = CMSG_FIRSTHDR(&header); item != nullptr;
+             item          = CMSG_NXTHDR(&header, item)) {
+            if (item->cmsg_level == SOL_SOCKET && item->cmsg_type == SCM_TIMESTAMPING) {
+                scm_timestamping times;
+                std::memcpy(&times, CMSG_DATA(item), sizeof(times));
+                timestamp = to_monotonic(times.ts[0], realtime_offset());
+            }
+        }
+        if (timestamp == 0) {
+            continue;
+        }
+
+        out_event.is_extended = (raw.can_id & CAN_EFF_FLAG) != 0;
+        if (out_event.is_extended) {
+            out_event.id = raw.can_id & CAN_EFF_MASK;
+        } else {
+            out_event.id = raw.can_id & CAN_SFF_MASK;
+        }
+        out_event.timestamp = timestamp;
+        return true;
+    }
+}
+
+template <std::size_t MaxDLC>
+std::size_t BasicDriverSocketCAN<MaxDLC>::send_many(const Frame* frames, std::size_t count)
+{
+    if (fd_ < 0) {
+        return 0;
+    }
+
+    std::size_t sent = 0;
+    while (sent < count) {
+        std::size_t batch_count = count - sent;
+        if (batch_count > BATCH_SIZE) {
+            batch_count = BATCH_SIZE;
+        }
+
+        for (std::size_t i = 0; i < batch_count; i++) {
+            iovec& buffer     = tx_batch_.iovecs[i];
+            msghdr& header    = tx_batch_.messages[i].msg_hdr;
+            buffer.iov_base   = &tx_batch_.frames[i];
+            buffer.iov_len    = encode(frames[sent + i], tx_batch_.frames[i]);
+            header            = msghdr{};
+            header.msg_iov    = &buffer;
+            header.msg_iovlen = 1;
+        }
+
+        // 送信バッファが埋まったら (EAGAIN / ENOBUFS) 残りは CANBus の送信キューに任せる
+        const int result = sendmmsg(
+            fd_, tx_batch_.messages.data(), static_cast<unsigned int>(batch_count), MSG_DONTWAIT
+        );
+        if (result <= 0) {
+            return sent;
+        }
+        sent += static_cast<std::size_t>(result);
+        if (static_cast<std::size_t>(result) < batch_count) {
+            return sent;
+        }
+    }
+    return sent;
+}
+
+template <std::size_t MaxDLC>
+std::size_t BasicDriverSocketCAN<MaxDLC>::receive_many(Frame* out_frames, std::size_t max_count)
+{
+    if (fd_ < 0) {
+        return 0;
+    }
+
+    std::size_t received = 0;
+    while (received < max_count) {
+        std::size_t batch_count = max_count - received;
+        if (batch_count > BATCH_SIZE) {
+            batch_count = BATCH_SIZE;
+        }
+
+        for (std::size_t i = 0; i < batch_count; i++) {
+            iovec& buffer         = rx_batch_.iovecs[i];
+            msghdr& header        = rx_batch_.messages[i].msg_hdr;
+            buffer.iov_base       = &rx_batch_.frames[i];
+            buffer.iov_len        = sizeof(RawFrame);
+            header                = msghdr{};
+            header.msg_iov        = &buffer;
+            header.msg_iovlen     = 1;
+            header.msg_control    = controls_[i].data();
+            header.msg_controllen = controls_[i].size();
+        }
+
+        const int result = recvmmsg(
+            fd_,
+            rx_batch_.messages.data(),
+            static_cast<unsigned int>(batch_count),
+            MSG_DONTWAIT,
+            nullptr
+        );
+        if (result <= 0) {
+            break;
+        }
+
+        const int64_t clock_offset = realtime_offset();
+        for (int i = 0; i < result; i++) {
+            mmsghdr& message = rx_batch_.messages[i];
+            // 長さ0のメッセージはストリームの終端 (socketpair の相手が閉じた)
+            if (message.msg_len == 0) {
+                return received;
+            }
+            Frame& out_frame = out_frames[received];
+            if (decode(
+                    rx_batch_.frames[i], message.msg_len, message.msg_hdr, clock_offset, out_frame
+                )) {
+                received++;
+            }
+        }
+        // 要求数に満たなければ受信データは尽きている
+        if (static_cast<std::size_t>(result) < batch_count) {
+            break;
+        }
+    }
+    return received;
+}
+
+template <std::size_t MaxDLC>
+bool BasicDriverSocketCAN<MaxDLC>::set_filters(const AcceptanceFilter* filters, std::size_t count)
+{
+    if (count > filters_.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        filters_[i] = filters[i];
+    }
+    filter_count_ = count;
+    filtering_    = true;
+
+    // 開く前は open() で設定する
+    if (fd_ < 0) {
+        return true;
+    }
+    return apply_filters();
+}
+
+template <std::size_t MaxDLC>
+bool BasicDriverSocketCAN<MaxDLC>::clear_filters()
+{
+    filter_count_ = 0;
+    filtering_    = false;
+
+    if (fd_ < 0) {
+        return true;
+    }
+    return apply_filters();
+}
+
+template <std::size_t MaxDLC>
+bool BasicDriverSocketCAN<MaxDLC>::apply_filters()
+{
+    if (!filtering_) {
+        can_filter accept_all{};
+        return setsockopt(fd_, SOL_CAN_RAW, CAN_RAW_FILTER, &accept_all, sizeof(accept_all)) == 0;
+    }
+
+    // 標準IDのデータフレームだけを通す (フィルタがない場合は何も受信しない)
+    std::array<can_filter, MAX_FILTERS> raw_filters{};
+    for (std::size_t i = 0; i < filter_count_; i++) {
+        raw_filters[i].can_id   = filters_[i].id & CAN_SFF_MASK;
+        raw_filters[i].can_mask = (filters_[i].mask & CAN_SFF_MASK) | CAN_EFF_FLAG | CAN_RTR_FLAG;
+    }
+    const socklen_t size = static_cast<socklen_t>(filter_count_ * sizeof(can_filter));
+    const void* data     = nullptr;
+    if (filter_count_ > 0) {
+        data = raw_filters.data();
+    }
+    return setsockopt(fd_, SOL_CAN_RAW, CAN_RAW_FILTER, data, size) == 0;
+}
+
+template <std::size_t MaxDLC>
+std::size_t BasicDriverSocketCAN<MaxDLC>::encode(const Frame& frame, RawFrame& out_raw) const
+{
+    out_raw = RawFrame{};
+    if (frame.is_extended) {
+        out_raw.can_id = (frame.id & CAN_EFF_MASK) | CAN_EFF_FLAG;
+    } else {
+        out_raw.can_id = frame.id & CAN_SFF_MASK;
+    }
+
+    uint8_t length = frame.dlc;
+    if (length > MaxDLC) {
+        length = MaxDLC;
+    }
+    std::memcpy(out_raw.data, frame.data.data(), length);
+
+    // 8バイト以下はクラシックCANのノードも受信できるようにクラシックCANのフレームで送る
+    if (!fd::requires_fd_format(length)) {
+        out_raw.len = length;
+        return CAN_MTU;
+    }
+
+    // CAN FD で表現できないデータ長は、送信する長さまでパディングする
+    const uint8_t padded = fd::padded_length(length);
+    std::memset(out_raw.data + length, fd::PADDING_BYTE, padded - length);
+    out_raw.len = padded;
+    if (bit_rate_switch_) {
+        out_raw.flags = CANFD_BRS;
+    }
+    return CANFD_MTU;
+}
+
+template <std::size_t MaxDLC>
+bool BasicDriverSocketCAN<MaxDLC>::decode(
+    const RawFrame& raw,
+    std::size_t length,
+    msghdr& header,
+    int64_t clock_offset,
+    Frame& out_frame
+)
+{
+    // 制御メッセージは変換できないフレームでも読み取る (オーバーフロー数を取りこぼさない)
+    uint64_t timestamp = 0;
+    for (cmsghdr* control = CMSG_FIRSTHDR(&header); control != nullptr;
+         control          = CMSG_NXTHDR(&header, control)) {
+        if (control->cmsg_level != SOL_SOCKET) {
+            continue;
+        }
+        if (control->cmsg_type == SCM_TIMESTAMPNS) {
+            timespec time;
+            std::memcpy(&time, CMSG_DATA(control), sizeof(time));
+            timestamp = to_monotonic(time, clock_offset);
+        } else if (control->cmsg_type == SO_RXQ_OVFL) {
+            std::memcpy(&rx_overrun_count_, CMSG_DATA(control), sizeof(rx_overrun_count_));
+        }
+    }
+
+    if (length != CAN_MTU && length != CANFD_MTU) {
+        return false;
+    }
+    // エラーフレームとリモートフレームは扱わない
+    if ((raw.can_id & (CAN_ERR_FLAG | CAN_RTR_FLAG)) != 0) {
+        return false;
+    }
+
+    uint8_t dlc = raw.len;
+    if (length == CAN_MTU && dlc > 8) {
+        dlc = 8;
+    }
+    // 扱えるデータ長を超えるフレーム (クラシックCAN用ドライバでの CAN FD フレーム) は破棄して記録する
+    if (dlc > MaxDLC) {
+        rx_oversize_count_++;
+        return false;
+    }
+
+    out_frame.is_extended = (raw.can_id & CAN_EFF_FLAG) != 0;
+    if (out_frame.is_extended) {
+        out_frame.id = raw.can_id & CAN_EFF_MASK;
+    } else {
+        out_frame.id = raw.can_id & CAN_SFF_MASK;
+    }
+    // 変換に使う時計の差は取り出すたびに変わるため、前の受信時刻より戻さない
+    if (timestamp != 0) {
+        if (timestamp < last_rx_timestamp_) {
+            timestamp = last_rx_timestamp_;
+        }
+        last_rx_timestamp_ = timestamp;
+    }
+    out_frame.dlc       = dlc;
+    out_frame.timestamp = timestamp;
+    std::memcpy(out_frame.data.data(), raw.data, dlc);
+    return true;
+}
+
+template class BasicDriverSocketCAN<8>;
+template class BasicDriverSocketCAN<64>;
+
+}  // namespace drivers
+}  // namespace gn10_can
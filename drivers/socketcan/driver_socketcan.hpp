@@ -0,0 +1,246 @@
+/**
+ * @file driver_socketcan.hpp
+ * @author Gento Aiba (aiba-gento)
+ * @brief Linux SocketCANのドライバ具体化クラスのヘッダファイル
+ * @version 0.1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <linux/can.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "gn10_can/drivers/can_driver_interface.hpp"
+#include "gn10_can/drivers/fdcan_driver_interface.hpp"
+
+namespace gn10_can {
+namespace drivers {
+
+/**
+ * @brief Linux SocketCAN ドライバ
+ * @details
+ * CAN_RAW ソケットをノンブロッキングで使用します。receive_many() / send_many() は
+ * recvmmsg / sendmmsg で1回のシステムコールにまとめて送受信します。
+ * 受信フレームの timestamp にはカーネルの受信時刻 (SO_TIMESTAMPNS) を CLOCK_MONOTONIC [ns] に
+ * 変換した値が入ります。NTP などで時計が変更されても時刻は戻りません。
+ * カーネルの受信キューがあふれて失われたフレーム数 (SO_RXQ_OVFL) を rx_overrun_count() で取得できます。
+ * MaxDLC を超えるデータ長のフレームは切り詰めずに破棄し、受信オーバーランとして数えます。
+ *
+ * enable_tx_events() を呼ぶと、カーネルがフレームを送出した時刻 (SO_TIMESTAMPING のソフトウェア
+ * タイムスタンプ、CLOCK_MONOTONIC [ns]) を receive_tx_event() で取得できます。
+ *
+ * 受信フィルタは CAN_RAW_FILTER としてカーネルに設定するため、他ノード宛てのフレームは
+ * ユーザー空間に届きません。CANBus が接続デバイスに合わせて set_filters() で設定します。
+ *
+ * MaxDLC が 64 の場合は CAN_RAW_FD_FRAMES を有効にし、8バイトを超えるフレームを CAN FD フレームで送信します。
+ * 8バイト以下のフレームはクラシックCANのフレーム (CAN_MTU) で送信するため、同じインターフェース上の
+ * クラシックCANのみのノードも受信できます。CAN FD で表現できないデータ長は fd::PADDING_BYTE で埋めます。
+ *
+ * @tparam MaxDLC 扱うフレームの最大データ長 (CAN: 8, CAN FD: 64)
+ */
+template <std::size_t MaxDLC>
+class BasicDriverSocketCAN : public detail::ICANDriver<MaxDLC>
+{
+public:
+    using Frame = detail::CANFrame<MaxDLC>;
+
+    static constexpr std::size_t BATCH_SIZE  = 16;  // 1回のシステムコールで送受信する最大フレーム数
+    static constexpr std::size_t MAX_FILTERS = MAX_ACCEPTANCE_FILTERS;  // 設定する受信フィルタの最大数
+
+    /**
+     * @brief BasicDriverSocketCANクラスのコンストラクタ
+     *
+     * @param bit_rate_switch CAN FD フレームのデータフェーズをデータビットレートで送るか
+     * (MaxDLC が 64 の場合のみ有効)
+     */
+    explicit BasicDriverSocketCAN(bool bit_rate_switch = true);
+
+    ~BasicDriverSocketCAN() override;
+
+    // ソケットを所有するためコピーとムーブを禁止
+    BasicDriverSocketCAN(const BasicDriverSocketCAN&)            = delete;
+    BasicDriverSocketCAN& operator=(const BasicDriverSocketCAN&) = delete;
+
+    /**
+     * @brief CANインターフェースのソケットを開く
+     *
+     * open() の前に設定された受信フィルタはここで設定します。
+     *
+     * @param interface_name インターフェース名 ("can0", "vcan0" など)
+     * @return true 成功
+     * @return false 失敗 (インターフェースがない、CAN FD に未対応など)
+     */
+    bool open(const char* interface_name);
+
+    /**
+     * @brief 開いているソケットを使用する
+     *
+     * socketpair など、CAN フレームをそのままデータグラムとして送受信するソケットを使用します (テスト用)。
+     * ソケットの所有権はドライバに移り、close() で閉じられます。
+     *
+     * @param fd ソケットのファイルディスクリプタ
+     * @return true 成功
+     * @return false 失敗
+     */
+    bool adopt(int fd);
+
+    /**
+     * @brief ソケットを閉じる
+     */
+    void close();
+
+    /**
+     * @brief 送信完了イベント (送出時刻) の取得を有効にする
+     *
+     * ソケットのエラーキューに送信時刻が積まれるため、有効にした場合は receive_tx_event() で
+     * 定期的に取り出してください (取り出さないと epoll がエラーキューの通知を返し続けます)。
+     * open() / adopt() の前に呼んだ場合は、ソケットを開いたときに設定します。
+     *
+     * @return true 成功
+     * @return false 失敗 (カーネルが SO_TIMESTAMPING に未対応など)
+     */
+    bool enable_tx_events();
+
+    /**
+     * @brief ソケットのファイルディスクリプタを取得する
+     *
+     * epoll などで受信を待つ場合に使用します。
+     *
+     * @return int ファイルディスクリプタ (開いていない場合は -1)
+     */
+    int fd() const
+    {
+        return fd_;
+    }
+
+    bool send(const Frame& frame) override;
+    bool receive(Frame& out_frame) override;
+    std::size_t send_many(const Frame* frames, std::size_t count) override;
+    std::size_t receive_many(Frame* out_frames, std::size_t max_count) override;
+
+    bool receive_tx_event(TxEvent& out_event) override;
+
+    /**
+     * @brief 受信オーバーランで失われたフレーム数を取得する
+     *
+     * カーネルの受信キューで失われたフレーム数と、MaxDLC を超えるデータ長で破棄したフレーム数の合計です。
+     *
+     * @return uint32_t 受信オーバーランの回数
+     */
+    uint32_t rx_overrun_count() const override
+    {
+        return rx_overrun_count_ + rx_oversize_count_;
+    }
+
+    /**
+     * @brief 扱えるデータ長 (MaxDLC) を超えるため破棄した受信フレーム数を取得する
+     *
+     * @return uint32_t 破棄したフレーム数
+     */
+    uint32_t rx_oversize_count() const
+    {
+        return rx_oversize_count_;
+    }
+
+    std::size_t filter_capacity() const override
+    {
+        return MAX_FILTERS;
+    }
+
+    bool set_filters(const AcceptanceFilter* filters, std::size_t count) override;
+    bool clear_filters() override;
+
+private:
+    // CAN_MTU / CANFD_MTU の両方を格納できる受信・送信バッファ
+    using RawFrame = struct canfd_frame;
+
+    // SO_TIMESTAMPNS・SO_TIMESTAMPING・SO_RXQ_OVFL の制御メッセージを格納できる大きさ
+    static constexpr std::size_t CONTROL_SIZE = 128;
+
+    /**
+     * @brief 送信時刻の取得をソケットに設定する
+     *
+     * @return true 設定成功
+     * @return false 設定失敗
+     */
+    bool apply_tx_timestamping();
+
+    /**
+     * @brief 保持している受信フィルタをソケットに設定する
+     *
+     * @return true 設定成功
+     * @return false 設定失敗
+     */
+    bool apply_filters();
+
+    /**
+     * @brief フレームを送信用のバッファに書き込む
+     *
+     * @param frame 送信フレーム
+     * @param out_raw 書き込み先
+     * @return std::size_t 送信するバイト数 (8バイト以下は CAN_MTU、それ以外は CANFD_MTU)
+     */
+    std::size_t encode(const Frame& frame, RawFrame& out_raw) const;
+
+    /**
+     * @brief 受信したメッセージをフレームに変換する
+     *
+     * @param raw 受信バッファ
+     * @param length 受信したバイト数
+     * @param header 受信したメッセージのヘッダ (制御メッセージを含む)
+     * @param clock_offset CLOCK_REALTIME から CLOCK_MONOTONIC への差 [ns]
+     * @param out_frame 変換先
+     * @return true 変換成功
+     * @return false 扱えないメッセージ
+     */
+    bool decode(
+        const RawFrame& raw,
+        std::size_t length,
+        msghdr& header,
+        int64_t clock_offset,
+        Frame& out_frame
+    );
+
+    /**
+     * @brief recvmmsg / sendmmsg に渡す1回分のバッファ
+     */
+    struct Batch {
+        std::array<RawFrame, BATCH_SIZE> frames{};   // フレームの送受信バッファ
+        std::array<iovec, BATCH_SIZE> iovecs{};      // frames を指す iovec
+        std::array<mmsghdr, BATCH_SIZE> messages{};  // メッセージのヘッダ
+    };
+
+    int fd_ = -1;                                                        // ソケット (開いていない場合は -1)
+    bool bit_rate_switch_;                                               // CAN FD フレームをビットレートスイッチ付きで送るか
+    std::array<AcceptanceFilter, MAX_FILTERS> filters_{};                // 設定する受信フィルタ
+    std::size_t filter_count_   = 0;                                     // 設定する受信フィルタ数
+    bool filtering_             = false;                                 // 受信フィルタで絞るか (false: 全て受信)
+    uint32_t rx_overrun_count_  = 0;                                     // カーネルの受信キューで失われたフレーム数
+    uint32_t rx_oversize_count_ = 0;                                     // データ長が MaxDLC を超えるため破棄したフレーム数
+    uint64_t last_rx_timestamp_ = 0;                                     // 最後の受信時刻 (時刻を戻さないため)
+    bool tx_events_             = false;                                 // 送信完了イベントを取得するか
+    Batch rx_batch_;                                                     // 受信バッファ (受信側のみ使用)
+    Batch tx_batch_;                                                     // 送信バッファ (送信側のみ使用)
+    std::array<std::array<char, CONTROL_SIZE>, BATCH_SIZE> controls_{};  // 受信した制御メッセージ
+};
+
+extern template class BasicDriverSocketCAN<8>;
+extern template class BasicDriverSocketCAN<64>;
+
+// クラシックCANのフレーム (最大8バイト) を扱う SocketCAN ドライバ (CANBus 用)
+using DriverSocketCAN = BasicDriverSocketCAN<8>;
+
+// CAN FD のフレーム (最大64バイト) を扱う SocketCAN ドライバ (FDCANBus 用)
+using DriverSocketCANFD = BasicDriverSocketCAN<64>;
+
+}  // namespace drivers
+}  // namespace gn10_can
@@ -0,0 +1,260 @@
+#include "epoll_executor.hpp"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace gn10_can {
+namespace drivers {
+
+EpollExecutor::EpollExecutor(std::size_t frames_per_update) : frames_per_update_(frames_per_update)
+{
+    if (frames_per_update_ == 0) {
+        frames_per_update_ = 1;
+    }
+
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd_  = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd_ < 0 || wake_fd_ < 0) {
+        return;
+    }
+
+    epoll_event event{};
+    event.events  = EPOLLIN;
+    event.data.fd = wake_fd_;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event) != 0) {
+        ::close(wake_fd_);
+        wake_fd_ = -1;
+    }
+}
+
+EpollExecutor::~EpollExecutor()
+{
+    // タイマーはこのクラスが作成したため閉じる
+    for (std::size_t i = 0; i < source_count_; i++) {
+        if (sources_[i].owned) {
+            ::close(sources_[i].fd);
+        }
+    }
+    if (wake_fd_ >= 0) {
+        ::close(wake_fd_);
+    }
+    if (epoll_fd_ >= 0) {
+        ::close(epoll_fd_);
+    }
+}
+
+int EpollExecutor::add_timer(std::chrono::nanoseconds period, TimerCallback callback, void* context)
+{
+    if (callback == nullptr || period.count() <= 0) {
+        return -1;
+    }
+
+    const int fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+
+    itimerspec spec{};
+    spec.it_interval.tv_sec  = static_cast<time_t>(period.count() / 1000000000);
+    spec.it_interval.tv_nsec = static_cast<long>(period.count() % 1000000000);
+    spec.it_value            = spec.it_interval;
+    if (timerfd_settime(fd, 0, &spec, nullptr) != 0) {
+        ::close(fd);
+        return -1;
+    }
+
+    Source source;
+    source.fd       = fd;
+    source.context  = context;
+    source.on_timer = callback;
+    source.counter  = true;
+    source.owned    = true;
+    if (!add_source(source)) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool EpollExecutor::add_event(int fd, TimerCallback callback, void* context)
+{
+    Source source;
+    source.fd       = fd;
+    source.context  = context;
+    source.on_timer = callback;
+    source.counter  = true;
+    return add_source(source);
+}
+
+bool EpollExecutor::remove(int fd)
+{
+    for (std::size_t i = 0; i < source_count_; i++) {
+        if (sources_[i].fd != fd) {
+            continue;
+        }
+
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+        if (sources_[i].owned) {
+            ::close(fd);
+        }
+        // 末尾の登録で埋める
+        source_count_--;
+        sources_[i] = sources_[source_count_];
+        return true;
+    }
+    return false;
+}
+
+std::size_t EpollExecutor::run_once(int timeout_ms)
+{
+    if (!valid()) {
+        return 0;
+    }
+    round_++;
+
+    for (std::size_t i = 0; i < source_count_; i++) {
+        Source& source = sources_[i];
+        if (source.counter) {
+            continue;
+        }
+        // 配送しきれなかったフレームがあれば待たない
+        if (source.backlog) {
+            timeout_ms = 0;
+        }
+        // 前回から今回までに (タイマーの処理や run_once() の外で) 送信キューに積まれたフレームも
+        // 送り出せるようにする
+        watch_writable(source);
+    }
+
+    std::array<epoll_event, MAX_SOURCES + 1> events;
+    const int count =
+        epoll_wait(epoll_fd_, events.data(), static_cast<int>(events.size()), timeout_ms);
+
+    std::size_t handled = 0;
+    for (int i = 0; i < count; i++) {
+        const int fd = events[i].data.fd;
+        if (fd == wake_fd_) {
+            uint64_t value;
+            while (::read(wake_fd_, &value, sizeof(value)) == sizeof(value)) {
+            }
+            continue;
+        }
+
+        Source* source = find(fd);
+        if (source == nullptr) {
+            continue;
+        }
+
+        if (source->counter) {
+            uint64_t expirations = 0;
+            if (::read(fd, &expirations, sizeof(expirations)) == sizeof(expirations)) {
+                if (source->on_timer != nullptr) {
+                    source->on_timer(source->context);
+                }
+                handled++;
+            }
+            continue;
+        }
+
+        if ((events[i].events & EPOLLOUT) != 0) {
+            source->on_writable(source->context);
+        }
+        if ((events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) != 0) {
+            service(*source);
+            handled++;
+        }
+        // 相手が閉じたソケットは読み込み可能のままになるため待ち受けをやめる
+        if ((events[i].events & EPOLLHUP) != 0) {
+            epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+        }
+    }
+
+    for (std::size_t i = 0; i < source_count_; i++) {
+        Source& source = sources_[i];
+        if (source.counter) {
+            continue;
+        }
+        // イベントがなくても、前回配送しきれなかったフレームを処理する
+        if (source.backlog && source.round != round_) {
+            service(source);
+            handled++;
+        }
+    }
+    return handled;
+}
+
+void EpollExecutor::run()
+{
+    while (!stop_requested_.load(std::memory_order_acquire)) {
+        run_once(-1);
+    }
+    stop_requested_.store(false, std::memory_order_release);
+}
+
+void EpollExecutor::stop()
+{
+    stop_requested_.store(true, std::memory_order_release);
+    if (wake_fd_ >= 0) {
+        const uint64_t value = 1;
+        ssize_t written      = ::write(wake_fd_, &value, sizeof(value));
+        (void)written;
+    }
+}
+
+bool EpollExecutor::add_source(const Source& source)
+{
+    if (!valid() || source.fd < 0 || source_count_ >= sources_.size() ||
+        find(source.fd) != nullptr) {
+        return false;
+    }
+
+    epoll_event event{};
+    event.events  = EPOLLIN;
+    event.data.fd = source.fd;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, source.fd, &event) != 0) {
+        return false;
+    }
+    sources_[source_count_] = source;
+    source_count_++;
+    return true;
+}
+
+EpollExecutor::Source* EpollExecutor::find(int fd)
+{
+    for (std::size_t i = 0; i < source_count_; i++) {
+        if (sources_[i].fd == fd) {
+            return &sources_[i];
+        }
+    }
+    return nullptr;
+}
+
+void EpollExecutor::service(Source& source)
+{
+    const UpdateResult result = source.update(source.context, frames_per_update_);
+    source.backlog            = result.pending > 0;
+    source.round              = round_;
+}
+
+void EpollExecutor::watch_writable(Source& source)
+{
+    const bool pending = source.tx_pending(source.context);
+    if (pending == source.writing) {
+        return;
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    if (pending) {
+        event.events |= EPOLLOUT;
+    }
+    event.data.fd = source.fd;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, source.fd, &event) == 0) {
+        source.writing = pending;
+    }
+}
+
+}  // namespace drivers
+}  // namespace gn10_can
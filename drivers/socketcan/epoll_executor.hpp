@@ -0,0 +1,223 @@
+/**
+ * @file epoll_executor.hpp
+ * @author Gento Aiba (aiba-gento)
+ * @brief 複数のCANバスを epoll で待ち受けて処理するイベント駆動の実行器
+ * @version 0.1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "gn10_can/core/can_bus.hpp"
+
+namespace gn10_can {
+namespace drivers {
+
+/**
+ * @brief 複数のCANバスを1つのスレッドで処理する epoll ベースの実行器
+ * @details
+ * ドライバのファイルディスクリプタ (DriverSocketCAN::fd() など) とタイマーを epoll で待ち、
+ * フレームが届いたバスの update() だけを呼び出します。待機中はスレッドが眠るため、
+ * update() をループで呼び続ける場合と比べて CPU を消費せず、sleep による遅延も生じません。
+ *
+ * 1回の update() で配送するフレーム数は frames_per_update で制限し、受信が集中したバスが
+ * 他のバスやタイマーを待たせないようにします。配送しきれなかったフレームは次の run_once() で
+ * 待たずに処理します。送信キューにフレームが残っているバスは書き込み可能になるのを待ち、
+ * on_tx_complete() で送り出します。
+ *
+ * run() 以外のメンバ関数は run() と同じスレッドから呼び出してください (stop() を除く)。
+ */
+class EpollExecutor
+{
+public:
+    static constexpr std::size_t MAX_SOURCES               = 16;  // 登録できるバスとタイマーの合計数
+    static constexpr std::size_t DEFAULT_FRAMES_PER_UPDATE = 64;  // 1回の update() で配送する最大フレーム数
+
+    // タイマーの周期ごとに呼び出される関数
+    using TimerCallback = void (*)(void* context);
+
+    /**
+     * @brief EpollExecutorクラスのコンストラクタ
+     *
+     * @param frames_per_update 1回の update() で配送する最大フレーム数
+     */
+    explicit EpollExecutor(std::size_t frames_per_update = DEFAULT_FRAMES_PER_UPDATE);
+
+    ~EpollExecutor();
+
+    // epoll のファイルディスクリプタを所有するためコピーを禁止
+    EpollExecutor(const EpollExecutor&)            = delete;
+    EpollExecutor& operator=(const EpollExecutor&) = delete;
+
+    /**
+     * @brief epoll を使用できるか
+     *
+     * @return true 使用可能
+     * @return false 初期化失敗
+     */
+    bool valid() const
+    {
+        return epoll_fd_ >= 0 && wake_fd_ >= 0;
+    }
+
+    /**
+     * @brief バスを登録する
+     *
+     * fd が読み込み可能になるたびにバスの update() を呼び出します。
+     * バスとドライバは登録を解除するまで破棄しないでください。
+     *
+     * @param bus 処理するバス (CANBus / FDCANBus など)
+     * @param fd バスのドライバのファイルディスクリプタ
+     * @return true 登録成功
+     * @return false 登録失敗 (登録数の上限、無効な fd など)
+     */
+    template <std::size_t MaxDLC, typename Lock, typename Stats>
+    bool add_bus(detail::CANBus<MaxDLC, Lock, Stats>& bus, int fd)
+    {
+        using Bus = detail::CANBus<MaxDLC, Lock, Stats>;
+
+        Source source;
+        source.fd      = fd;
+        source.context = &bus;
+        source.update  = [](void* context, std::size_t max_frames) {
+            return static_cast<Bus*>(context)->update(max_frames);
+        };
+        source.tx_pending = [](void* context) {
+            return static_cast<Bus*>(context)->tx_queue_size() > 0;
+        };
+        source.on_writable = [](void* context) { static_cast<Bus*>(context)->on_tx_complete(); };
+        return add_source(source);
+    }
+
+    /**
+     * @brief 周期タイマーを登録する
+     *
+     * 制御ループなど、バスの受信と同じスレッドで周期的に行う処理に使用します。
+     * 処理が遅れて複数周期が経過していた場合も、呼び出しは1回にまとめられます。
+     *
+     * @param period 周期
+     * @param callback 周期ごとに呼び出す関数
+     * @param context callback に渡す値
+     * @return int タイマーの識別子 (remove() に渡す。失敗した場合は -1)
+     */
+    int add_timer(std::chrono::nanoseconds period, TimerCallback callback, void* context);
+
+    /**
+     * @brief イベント通知用のファイルディスクリプタ (eventfd) を登録する
+     *
+     * 他のスレッドから待機中の実行器を起こす場合に使用します。fd が読み込み可能になるたびに
+     * カウンタを読み出して callback を呼び出します。fd は登録を解除するまで閉じないでください。
+     *
+     * @param fd eventfd のファイルディスクリプタ
+     * @param callback 通知ごとに呼び出す関数 (nullptr の場合は待機を解除するだけ)
+     * @param context callback に渡す値
+     * @return true 登録成功
+     * @return false 登録失敗 (登録数の上限、無効な fd など)
+     */
+    bool add_event(int fd, TimerCallback callback, void* context);
+
+    /**
+     * @brief バス、タイマー、イベントの登録を解除する
+     *
+     * @param fd add_bus() / add_event() に渡したファイルディスクリプタ、または add_timer() の戻り値
+     * @return true 解除成功
+     * @return false 登録されていない
+     */
+    bool remove(int fd);
+
+    /**
+     * @brief イベントを1回待って処理する
+     *
+     * 配送しきれなかったフレームが残っている場合は待たずに処理します。
+     * 前回の run_once() から今回までにバスの送信キューに積まれたフレームも、書き込み可能になるのを
+     * 待って送り出します。
+     *
+     * @param timeout_ms 最大待ち時間 [ms] (-1: イベントが発生するまで待つ、0: 待たない)
+     * @return std::size_t 処理したバスとタイマーの数
+     */
+    std::size_t run_once(int timeout_ms);
+
+    /**
+     * @brief stop() が呼ばれるまでイベントを処理し続ける
+     */
+    void run();
+
+    /**
+     * @brief run() を終了させる
+     *
+     * 他のスレッドやシグナルハンドラから呼び出せます。
+     */
+    void stop();
+
+private:
+    using UpdateFunction  = UpdateResult (*)(void* context, std::size_t max_frames);
+    using PendingFunction = bool (*)(void* context);
+    using FlushFunction   = void (*)(void* context);
+
+    /**
+     * @brief 登録されたバス、タイマー、イベント
+     */
+    struct Source {
+        int fd                     = -1;       // 待ち受けるファイルディスクリプタ
+        void* context              = nullptr;  // バスまたは callback に渡す値
+        UpdateFunction update      = nullptr;  // バスの受信処理
+        PendingFunction tx_pending = nullptr;  // バスの送信キューにフレームがあるか
+        FlushFunction on_writable  = nullptr;  // バスの送信キューを送り出す
+        TimerCallback on_timer     = nullptr;  // タイマー・イベントの処理
+        bool counter               = false;    // タイマー・イベント (カウンタを読み出す)
+        bool owned                 = false;    // fd をこのクラスが閉じる (タイマー)
+        bool backlog               = false;    // 配送しきれなかったフレームがある
+        bool writing               = false;    // 書き込み可能になるのを待っている
+        uint64_t round             = 0;        // 最後に処理した run_once() の回
+    };
+
+    /**
+     * @brief 待ち受けるファイルディスクリプタを登録する
+     *
+     * @param source 登録内容
+     * @return true 登録成功
+     * @return false 登録失敗
+     */
+    bool add_source(const Source& source);
+
+    /**
+     * @brief ファイルディスクリプタから登録を探す
+     *
+     * @param fd ファイルディスクリプタ
+     * @return Source* 登録 (見つからなければ nullptr)
+     */
+    Source* find(int fd);
+
+    /**
+     * @brief バスの受信処理を行う
+     *
+     * @param source バスの登録
+     */
+    void service(Source& source);
+
+    /**
+     * @brief 送信待ちの有無に合わせて書き込み可能イベントの監視を切り替える
+     *
+     * @param source バスの登録
+     */
+    void watch_writable(Source& source);
+
+    int epoll_fd_ = -1;                        // epoll のファイルディスクリプタ
+    int wake_fd_  = -1;                        // stop() で待機を解除する eventfd
+    std::size_t frames_per_update_;            // 1回の update() で配送する最大フレーム数
+    std::array<Source, MAX_SOURCES> sources_;  // 登録されたバスとタイマー
+    std::size_t source_count_ = 0;             // 登録数
+    uint64_t round_           = 0;             // run_once() の呼び出し回数
+    std::atomic<bool> stop_requested_{false};  // stop() が呼ばれたか
+};
+
+}  // namespace drivers
+}  // namespace gn10_can
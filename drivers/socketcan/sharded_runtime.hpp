@@ -0,0 +1,585 @@
+/**
+ * @file sharded_runtime.hpp
+ * @author Gento Aiba (aiba-gento)
+ * @brief 複数のCANバスをCPUコアごとのワーカースレッドに分けて処理する実行環境のヘッダファイル
+ * @version 0.1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include "epoll_executor.hpp"
+#include "gn10_can/core/can_bus.hpp"
+#include "gn10_can/core/mpsc_ring.hpp"
+#include "gn10_can/core/seqlock.hpp"
+#include "gn10_can/core/spsc_ring.hpp"
+
+namespace gn10_can {
+namespace drivers {
+
+/**
+ * @brief シャード (ワーカースレッド) ごとの統計情報
+ * @details
+ * 送受信数などのバスの統計は、統計情報を記録するバス (InstrumentedCANBus など) の合計です。
+ */
+struct ShardStats {
+    uint32_t rx_frames        = 0;  // 受信フレーム数
+    uint32_t rx_bytes         = 0;  // 受信データバイト数
+    uint32_t tx_frames        = 0;  // 送信フレーム数
+    uint32_t tx_bytes         = 0;  // 送信データバイト数
+    uint32_t unrouted_frames  = 0;  // 配送先デバイスのない受信フレーム数
+    uint32_t send_failures    = 0;  // 送信失敗数 (送信キュー満杯、最大データ長超過)
+    uint32_t rx_overruns      = 0;  // 受信オーバーラン数
+    uint32_t forwarded_frames = 0;  // 他のスレッドから受け取ってバスへ渡した送信フレーム数
+    uint32_t forward_drops    = 0;  // 受け渡し用のバッファが満杯で破棄した送信フレーム数
+    uint32_t wakeups          = 0;  // イベント待ちから起きた回数
+
+    /**
+     * @brief 他のシャードの統計情報を加算する
+     *
+     * @param other 加算する統計情報
+     */
+    void add(const ShardStats& other)
+    {
+        rx_frames += other.rx_frames;
+        rx_bytes += other.rx_bytes;
+        tx_frames += other.tx_frames;
+        tx_bytes += other.tx_bytes;
+        unrouted_frames += other.unrouted_frames;
+        send_failures += other.send_failures;
+        rx_overruns += other.rx_overruns;
+        forwarded_frames += other.forwarded_frames;
+        forward_drops += other.forward_drops;
+        wakeups += other.wakeups;
+    }
+};
+
+/**
+ * @brief 複数のCANバスをシャード (ワーカースレッド) に分けて処理する実行環境
+ * @details
+ * add_shard() で作成したシャードごとに EpollExecutor を持つワーカースレッドを起動し、
+ * add_bus() で割り当てたバスの受信・配送・送信をそのスレッドだけで行います。
+ * シャードを CPU コアに固定 (CPU アフィニティ) できるため、バスの数に合わせてシャードを増やすと
+ * 処理できるフレーム数もコア数に比例して増えます。
+ *
+ * 他のバスへの送信 (ゲートウェイなど) は send() で行います。送信先のバスと同じシャードからは
+ * 直接送信し、他のシャードからは送信元シャード × 送信先バスごとの SPSCRing を経由するため、
+ * 送信側は待たされません (wait-free)。シャード以外のスレッドからはバスごとの MPSCRing を経由します。
+ * 受け渡された送信フレームは送信先のシャードが送信キューの空きの分だけ取り出すため、
+ * 送信が詰まってもバスの送信キューで破棄されず、受け渡し用のバッファが満杯になると send() が失敗します。
+ *
+ * 統計情報はシャードごとに stats_period の周期で SeqLock に書き込まれ、stats() で任意のスレッドから
+ * 全シャードの合計を読み出せます。
+ *
+ * シャードとバスの登録は start() の前に行ってください。バスに接続したデバイスの処理
+ * (受信時のコールバックなど) はバスのシャードのスレッドで行われます。
+ * シャードごとの受け渡し用のバッファを含むため、大きなオブジェクトです (静的に確保してください)。
+ *
+ * @tparam MaxDLC シャード間で受け渡すフレームの最大データ長 (CAN: 8, CAN FD: 64)
+ */
+template <std::size_t MaxDLC>
+class BasicShardedRuntime
+{
+public:
+    using Frame = gn10_can::detail::CANFrame<MaxDLC>;
+
+    static constexpr std::size_t MAX_SHARDS         = 8;   // 作成できるシャード数
+    static constexpr std::size_t MAX_BUSES          = 8;   // 登録できるバス数
+    static constexpr std::size_t LANE_SIZE          = 32;  // 送信元シャード × 送信先バスごとの受け渡しフレーム数
+    static constexpr std::size_t INBOX_SIZE         = 64;  // シャード以外のスレッドから受け渡すフレーム数 (バスごと)
+    static constexpr std::size_t FORWARD_BATCH_SIZE = 8;   // 受け渡されたフレームをまとめて送信する数
+    static constexpr int NO_AFFINITY                = -1;  // CPU コアに固定しない
+
+    static constexpr std::chrono::milliseconds DEFAULT_STATS_PERIOD{100};  // 統計情報の更新周期
+
+    /**
+     * @brief BasicShardedRuntimeクラスのコンストラクタ
+     *
+     * @param stats_period 統計情報を更新する周期
+     */
+    explicit BasicShardedRuntime(std::chrono::nanoseconds stats_period = DEFAULT_STATS_PERIOD)
+        : stats_period_(stats_period)
+    {
+    }
+
+    ~BasicShardedRuntime()
+    {
+        stop();
+        for (std::size_t i = 0; i < shard_count_; i++) {
+            ::close(shards_[i].wake_fd);
+        }
+    }
+
+    BasicShardedRuntime(const BasicShardedRuntime&)            = delete;
+    BasicShardedRuntime& operator=(const BasicShardedRuntime&) = delete;
+
+    /**
+     * @brief シャードを作成する
+     *
+     * @param cpu ワーカースレッドを固定する CPU 番号 (NO_AFFINITY の場合は固定しない)
+     * @return int シャードの番号 (add_bus() に渡す。失敗した場合は -1)
+     */
+    int add_shard(int cpu = NO_AFFINITY)
+    {
+        if (running() || shard_count_ >= shards_.size()) {
+            return -1;
+        }
+
+        Shard& shard  = shards_[shard_count_];
+        shard.wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (shard.wake_fd < 0) {
+            return -1;
+        }
+        const int timer =
+            shard.executor.add_timer(stats_period_, &BasicShardedRuntime::on_stats_timer, &shard);
+        if (timer < 0 || !shard.executor.add_event(shard.wake_fd, nullptr, nullptr)) {
+            shard.executor.remove(timer);
+            ::close(shard.wake_fd);
+            shard.wake_fd = -1;
+            return -1;
+        }
+
+        shard.owner = this;
+        shard.index = shard_count_;
+        shard.cpu   = cpu;
+        shard_count_++;
+        return static_cast<int>(shard.index);
+    }
+
+    /**
+     * @brief バスをシャードに割り当てる
+     *
+     * @param shard add_shard() で作成したシャードの番号
+     * @param bus 処理するバス (CANBus / FDCANBus / InstrumentedCANBus など)
+     * @param fd バスのドライバのファイルディスクリプタ
+     * @return int バスの番号 (send() に渡す。失敗した場合は -1)
+     */
+    template <std::size_t BusDLC, typename Lock, typename Stats>
+    int add_bus(std::size_t shard, gn10_can::detail::CANBus<BusDLC, Lock, Stats>& bus, int fd)
+    {
+        using Bus = gn10_can::detail::CANBus<BusDLC, Lock, Stats>;
+
+        if (running() || shard >= shard_count_ || bus_count_ >= buses_.size()) {
+            return -1;
+        }
+        if (!shards_[shard].executor.add_bus(bus, fd)) {
+            return -1;
+        }
+
+        BusEntry& entry = buses_[bus_count_];
+        entry.bus       = &bus;
+        entry.context   = &bus;
+        entry.shard     = shard;
+        entry.tx_space  = &BasicShardedRuntime::tx_space_of<Bus>;
+        entry.collect   = &BasicShardedRuntime::collect_stats_of<Bus, Stats>;
+        bus_count_++;
+        return static_cast<int>(bus_count_ - 1);
+    }
+
+    /**
+     * @brief ワーカースレッドを起動する
+     *
+     * @return true 起動成功
+     * @return false 起動済み、またはシャードがない
+     */
+    bool start()
+    {
+        if (running() || shard_count_ == 0) {
+            return false;
+        }
+        stop_requested_.store(false, std::memory_order_relaxed);
+        running_.store(true, std::memory_order_release);
+        for (std::size_t i = 0; i < shard_count_; i++) {
+            Shard& shard = shards_[i];
+            shard.thread = std::thread([this, &shard]() { work(shard); });
+        }
+        return true;
+    }
+
+    /**
+     * @brief ワーカースレッドを停止する
+     *
+     * 停止時点の統計情報を書き込んでから終了します。
+     */
+    void stop()
+    {
+        if (!running()) {
+            return;
+        }
+        stop_requested_.store(true, std::memory_order_release);
+        for (std::size_t i = 0; i < shard_count_; i++) {
+            wake(shards_[i]);
+        }
+        for (std::size_t i = 0; i < shard_count_; i++) {
+            shards_[i].thread.join();
+        }
+        running_.store(false, std::memory_order_release);
+    }
+
+    /**
+     * @brief ワーカースレッドが動作中か
+     *
+     * @return true 動作中
+     * @return false 停止中
+     */
+    bool running() const
+    {
+        return running_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief バスへCANフレームを送信する (任意のスレッド)
+     *
+     * 動作中は送信先のバスのシャードへフレームを渡して戻ります。
+     *
+     * @param bus add_bus() の戻り値
+     * @param frame 送信するCANフレーム
+     * @return true 送信成功、または送信先のシャードへ渡した
+     * @return false 送信失敗 (無効なバス、最大データ長超過、受け渡し用のバッファが満杯など)
+     */
+    bool send(std::size_t bus, const CANFrameView& frame)
+    {
+        if (bus >= bus_count_ || frame.dlc > MaxDLC) {
+            return false;
+        }
+        BusEntry& entry = buses_[bus];
+        if (!running()) {
+            return entry.bus->send_frame(frame);
+        }
+
+        Shard* current = current_shard();
+        if (current != nullptr && current->owner == this) {
+            // 同じシャードのバスは受け渡さずに送信する
+            if (current->index == entry.shard) {
+                return entry.bus->send_frame(frame);
+            }
+            if (!current->outbox[bus].push(Frame(frame))) {
+                return false;
+            }
+        } else if (!inboxes_[bus].push(Frame(frame))) {
+            return false;
+        }
+        notify(shards_[entry.shard]);
+        return true;
+    }
+
+    /**
+     * @brief 全シャードの統計情報の合計を取得する (任意のスレッド)
+     *
+     * @return ShardStats 統計情報 (最後に書き込まれた時点の値)
+     */
+    ShardStats stats() const
+    {
+        ShardStats total;
+        for (std::size_t i = 0; i < shard_count_; i++) {
+            total.add(shard_stats(i));
+        }
+        return total;
+    }
+
+    /**
+     * @brief シャードの統計情報を取得する (任意のスレッド)
+     *
+     * @param shard シャードの番号
+     * @return ShardStats 統計情報 (無効な番号の場合は空)
+     */
+    ShardStats shard_stats(std::size_t shard) const
+    {
+        if (shard >= shard_count_) {
+            return ShardStats{};
+        }
+        return shards_[shard].stats.read();
+    }
+
+    /**
+     * @brief シャードのワーカースレッドを CPU コアに固定できたか
+     *
+     * @param shard シャードの番号
+     * @return true 固定済み
+     * @return false 固定していない、または固定に失敗した
+     */
+    bool pinned(std::size_t shard) const
+    {
+        if (shard >= shard_count_) {
+            return false;
+        }
+        return shards_[shard].pinned.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief 作成したシャード数を取得する
+     *
+     * @return std::size_t シャード数
+     */
+    std::size_t shard_count() const
+    {
+        return shard_count_;
+    }
+
+    /**
+     * @brief 登録したバス数を取得する
+     *
+     * @return std::size_t バス数
+     */
+    std::size_t bus_count() const
+    {
+        return bus_count_;
+    }
+
+private:
+    using TxSpaceFunction = std::size_t (*)(void* context);
+    using CollectFunction = void (*)(void* context, ShardStats& out_stats);
+    using Lanes           = std::array<SPSCRing<Frame, LANE_SIZE>, MAX_BUSES>;
+    using Inboxes         = std::array<MPSCRing<Frame, INBOX_SIZE>, MAX_BUSES>;
+
+    /**
+     * @brief 登録されたバス
+     */
+    struct BusEntry {
+        CANBusBase* bus          = nullptr;  // バス
+        void* context            = nullptr;  // 型を戻したバスへのポインタ
+        std::size_t shard        = 0;        // 割り当てたシャードの番号
+        TxSpaceFunction tx_space = nullptr;  // 送信キューの空きを取得する関数
+        CollectFunction collect  = nullptr;  // 統計情報を加算する関数
+    };
+
+    /**
+     * @brief ワーカースレッドと、そのスレッドから他のバスへの受け渡し用のバッファ
+     */
+    struct Shard {
+        BasicShardedRuntime* owner = nullptr;      // 所属する実行環境
+        std::size_t index          = 0;            // シャードの番号
+        int cpu                    = NO_AFFINITY;  // 固定する CPU 番号
+        int wake_fd                = -1;           // ワーカースレッドを起こす eventfd
+        EpollExecutor executor;                    // バスとタイマーの待ち受け
+        std::thread thread;                        // ワーカースレッド
+        std::atomic<bool> notified{false};         // 起こす通知を送った後か
+        std::atomic<bool> pinned{false};           // CPU コアに固定できたか
+        Lanes outbox;                              // このシャードから各バスへの送信フレーム
+        ShardStats counters;                       // ワーカースレッドが数える統計情報
+        SeqLock<ShardStats> stats;                 // 他のスレッドへ受け渡す統計情報
+    };
+
+    /**
+     * @brief 実行中のワーカースレッドのシャードを取得する
+     *
+     * @return Shard*& シャード (ワーカースレッド以外では nullptr)
+     */
+    static Shard*& current_shard()
+    {
+        static thread_local Shard* shard = nullptr;
+        return shard;
+    }
+
+    /**
+     * @brief バスの送信キューの空きを取得する
+     *
+     * @tparam Bus バスの型
+     * @param context バスへのポインタ
+     * @return std::size_t 送信キューに追加できるフレーム数
+     */
+    template <typename Bus>
+    static std::size_t tx_space_of(void* context)
+    {
+        const Bus* bus = static_cast<const Bus*>(context);
+        return Bus::TX_QUEUE_SIZE - bus->tx_queue_size();
+    }
+
+    /**
+     * @brief バスの統計情報を加算する
+     *
+     * @tparam Bus バスの型
+     * @tparam Stats バスの統計情報の収集ポリシー
+     * @param context バスへのポインタ
+     * @param out_stats 加算先
+     */
+    template <typename Bus, typename Stats>
+    static void collect_stats_of(void* context, ShardStats& out_stats)
+    {
+        if constexpr (Stats::ENABLED) {
+            const auto snapshot = static_cast<const Bus*>(context)->stats();
+            out_stats.rx_frames += snapshot.rx_frames;
+            out_stats.rx_bytes += snapshot.rx_bytes;
+            out_stats.tx_frames += snapshot.tx_frames;
+            out_stats.tx_bytes += snapshot.tx_bytes;
+            out_stats.unrouted_frames += snapshot.unrouted_frames;
+            out_stats.send_failures += snapshot.send_failures;
+            out_stats.rx_overruns += snapshot.rx_overruns;
+        } else {
+            (void)context;
+            (void)out_stats;
+        }
+    }
+
+    /**
+     * @brief 統計情報の更新周期ごとに呼び出される (ワーカースレッド)
+     *
+     * @param context シャードへのポインタ
+     */
+    static void on_stats_timer(void* context)
+    {
+        Shard* shard = static_cast<Shard*>(context);
+        shard->owner->publish(*shard);
+    }
+
+    /**
+     * @brief ワーカースレッドを起こす
+     *
+     * @param shard 起こすシャード
+     */
+    static void wake(Shard& shard)
+    {
+        const uint64_t value = 1;
+        ssize_t written      = ::write(shard.wake_fd, &value, sizeof(value));
+        (void)written;
+    }
+
+    /**
+     * @brief 送信フレームを受け渡したことをシャードに知らせる
+     *
+     * ワーカースレッドが受け渡し用のバッファを確認するまでの間は、通知を1回にまとめます。
+     *
+     * @param shard 送信先のバスのシャード
+     */
+    static void notify(Shard& shard)
+    {
+        if (!shard.notified.exchange(true, std::memory_order_acq_rel)) {
+            wake(shard);
+        }
+    }
+
+    /**
+     * @brief ワーカースレッドの処理
+     *
+     * @param shard 処理するシャード
+     */
+    void work(Shard& shard)
+    {
+        current_shard() = &shard;
+        if (shard.cpu != NO_AFFINITY) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(shard.cpu, &cpus);
+            const bool pinned = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+            shard.pinned.store(pinned, std::memory_order_release);
+        }
+
+        while (!stop_requested_.load(std::memory_order_acquire)) {
+            shard.executor.run_once(-1);
+            shard.counters.wakeups++;
+            forward(shard);
+        }
+        forward(shard);
+        publish(shard);
+        current_shard() = nullptr;
+    }
+
+    /**
+     * @brief 受け渡された送信フレームをシャードのバスへ渡す (ワーカースレッド)
+     *
+     * 送信キューに積まれたフレームは、次の run_once() で書き込み可能になるのを待って送信されます。
+     *
+     * @param shard 処理するシャード
+     */
+    void forward(Shard& shard)
+    {
+        // 以降に受け渡されたフレームは、改めて通知を受けて処理する
+        shard.notified.exchange(false, std::memory_order_acq_rel);
+        for (std::size_t bus = 0; bus < bus_count_; bus++) {
+            BusEntry& entry = buses_[bus];
+            if (entry.shard != shard.index) {
+                continue;
+            }
+            for (std::size_t source = 0; source < shard_count_; source++) {
+                if (source != shard.index) {
+                    drain(shards_[source].outbox[bus], entry, shard.counters);
+                }
+            }
+            drain(inboxes_[bus], entry, shard.counters);
+        }
+    }
+
+    /**
+     * @brief 受け渡し用のバッファからバスの送信キューの空きの分だけ送信する (ワーカースレッド)
+     *
+     * @tparam Ring 受け渡し用のバッファの型 (SPSCRing / MPSCRing)
+     * @param ring 受け渡し用のバッファ
+     * @param entry 送信先のバス
+     * @param counters 送信したフレーム数の加算先
+     */
+    template <typename Ring>
+    static void drain(Ring& ring, BusEntry& entry, ShardStats& counters)
+    {
+        std::array<Frame, FORWARD_BATCH_SIZE> frames;
+        std::array<CANFrameView, FORWARD_BATCH_SIZE> views;
+        while (true) {
+            std::size_t max_count = entry.tx_space(entry.context);
+            if (max_count > frames.size()) {
+                max_count = frames.size();
+            }
+            const std::size_t count = ring.pop_many(frames.data(), max_count);
+            if (count == 0) {
+                return;
+            }
+            for (std::size_t i = 0; i < count; i++) {
+                views[i] = CANFrameView(frames[i]);
+            }
+            entry.bus->send_frames(views.data(), count);
+            counters.forwarded_frames += static_cast<uint32_t>(count);
+        }
+    }
+
+    /**
+     * @brief シャードの統計情報を書き込む (ワーカースレッド)
+     *
+     * @param shard 書き込むシャード
+     */
+    void publish(Shard& shard)
+    {
+        ShardStats stats = shard.counters;
+        for (std::size_t bus = 0; bus < bus_count_; bus++) {
+            const BusEntry& entry = buses_[bus];
+            if (entry.shard != shard.index) {
+                continue;
+            }
+            entry.collect(entry.context, stats);
+            for (std::size_t source = 0; source < shard_count_; source++) {
+                stats.forward_drops += shards_[source].outbox[bus].overflow_count();
+            }
+            stats.forward_drops += inboxes_[bus].overflow_count();
+        }
+        shard.stats.write(stats);
+    }
+
+    std::chrono::nanoseconds stats_period_;    // 統計情報の更新周期
+    std::array<Shard, MAX_SHARDS> shards_;     // シャード
+    std::size_t shard_count_ = 0;              // 作成したシャード数
+    std::array<BusEntry, MAX_BUSES> buses_{};  // 登録されたバス
+    std::size_t bus_count_ = 0;                // 登録したバス数
+    Inboxes inboxes_;                          // シャード以外のスレッドからの送信フレーム
+    std::atomic<bool> running_{false};         // ワーカースレッドが動作中か
+    std::atomic<bool> stop_requested_{false};  // stop() が呼ばれたか
+};
+
+// クラシックCANのフレームを受け渡す実行環境
+using ShardedCANRuntime = BasicShardedRuntime<8>;
+
+// CAN FD のフレームを受け渡す実行環境
+using ShardedFDCANRuntime = BasicShardedRuntime<64>;
+
+}  // namespace drivers
+}  // namespace gn10_can
@@ -0,0 +1,511 @@
+/**
+ * @file threaded_bus.hpp
+ * @author Gento Aiba (aiba-gento)
+ * @brief 専用の I/O スレッドで送受信を行うCANバスのヘッダファイル
+ * @version 0.1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include "gn10_can/core/can_bus.hpp"
+#include "gn10_can/core/mpsc_ring.hpp"
+#include "gn10_can/core/seqlock.hpp"
+
+namespace gn10_can {
+namespace drivers {
+
+/**
+ * @brief デバイスの状態を I/O スレッドから制御スレッドへ受け渡すスナップショット
+ * @details
+ * I/O スレッドがフレームを配送した後に extract でデバイスから状態を取り出して SeqLock に書き込み、
+ * 制御スレッドは read() で一貫した状態を読み出します。デバイスの getter を制御スレッドから
+ * 直接呼び出すと、受信処理と競合するため使用しないでください。
+ *
+ * @tparam Device デバイスの型
+ * @tparam State 状態の型 (トリビアルにコピー可能であること)
+ */
+template <typename Device, typename State>
+class DeviceSnapshot
+{
+public:
+    // デバイスから状態を取り出す関数 (I/O スレッドで呼び出される)
+    using Extract = State (*)(const Device& device);
+
+    /**
+     * @brief DeviceSnapshotクラスのコンストラクタ
+     *
+     * @param device 状態を取り出すデバイス
+     * @param extract デバイスから状態を取り出す関数
+     */
+    DeviceSnapshot(const Device& device, Extract extract)
+        : device_(device), extract_(extract), state_(extract(device))
+    {
+    }
+
+    /**
+     * @brief デバイスの状態を取り出して書き込む (I/O スレッド)
+     */
+    void publish()
+    {
+        state_.write(extract_(device_));
+    }
+
+    /**
+     * @brief 最新の状態を読み出す (任意のスレッド)
+     *
+     * @return State 状態
+     */
+    State read() const
+    {
+        return state_.read();
+    }
+
+    /**
+     * @brief 状態が書き込まれた回数を取得する
+     *
+     * @return uint32_t 書き込み回数
+     */
+    uint32_t version() const
+    {
+        return state_.version();
+    }
+
+private:
+    const Device& device_;  // 状態を取り出すデバイス
+    Extract extract_;       // デバイスから状態を取り出す関数
+    SeqLock<State> state_;  // 制御スレッドへ受け渡す状態
+};
+
+/**
+ * @brief 専用の I/O スレッドで受信・送信を行うCANバス
+ * @details
+ * start() で I/O スレッドを起動し、ドライバからの受信、デバイスへの配送、ドライバへの送信を
+ * 全て I/O スレッドで行います。制御スレッドからの送信 (デバイスの set_target() など) は
+ * ロックフリーの MPSCRing に積まれ、I/O スレッドが送信します。制御スレッドは送信でも
+ * 受信処理でも待たされないため、CAN の送受信のばらつきが制御周期に影響しません。
+ *
+ * 受信したデバイスの状態は add_snapshot() で登録した DeviceSnapshot を通して読み出します。
+ * fd にドライバのファイルディスクリプタ (DriverSocketCAN::fd() など) を指定すると、
+ * I/O スレッドは受信・送信可能になるまで poll で眠ります。指定しない場合は IDLE_POLL_MS ごとに
+ * ドライバを確認します。
+ *
+ * デバイスの接続・切断と add_snapshot() は start() の前に行ってください。
+ * 動作中の stats() などの取得は I/O スレッド (デバイスの受信処理) から行ってください。
+ *
+ * @tparam MaxDLC 扱うフレームの最大データ長 (CAN: 8, CAN FD: 64)
+ * @tparam Stats 統計情報の収集ポリシー (NoStats / BusStats)
+ */
+template <std::size_t MaxDLC, typename Stats = NoStats>
+class BasicThreadedCANBus : public gn10_can::detail::CANBus<MaxDLC, NullLock, Stats>
+{
+public:
+    using Base   = gn10_can::detail::CANBus<MaxDLC, NullLock, Stats>;
+    using Frame  = typename Base::Frame;
+    using Driver = typename Base::Driver;
+
+    static constexpr std::size_t HANDOFF_SIZE      = 64;  // 制御スレッドから I/O スレッドへ渡す送信フレーム数
+    static constexpr std::size_t MAX_SNAPSHOTS     = 16;  // 登録できるスナップショット数
+    static constexpr std::size_t FRAMES_PER_UPDATE = 64;  // 送信フレームの受け渡しを挟むまでに配送する最大フレーム数
+    static constexpr int IDLE_POLL_MS              = 1;   // fd を指定しない場合にドライバを確認する周期 [ms]
+
+    /**
+     * @brief BasicThreadedCANBusクラスのコンストラクタ
+     *
+     * @param driver CANドライバーインターフェースの参照
+     * @param fd ドライバのファイルディスクリプタ (ない場合は -1)
+     */
+    explicit BasicThreadedCANBus(Driver& driver, int fd = -1)
+        : Base(driver), fd_(fd), wake_fd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+    {
+    }
+
+    ~BasicThreadedCANBus() override
+    {
+        stop();
+        if (wake_fd_ >= 0) {
+            ::close(wake_fd_);
+        }
+    }
+
+    /**
+     * @brief I/O スレッドを起動する
+     *
+     * @return true 起動成功
+     * @return false 起動済み、または初期化失敗
+     */
+    bool start()
+    {
+        if (running_.load(std::memory_order_acquire) || wake_fd_ < 0) {
+            return false;
+        }
+        stop_requested_.store(false, std::memory_order_relaxed);
+        io_active_.store(true, std::memory_order_relaxed);
+        running_.store(true, std::memory_order_seq_cst);
+        thread_ = std::thread([this]() { run(); });
+        return true;
+    }
+
+    /**
+     * @brief I/O スレッドを停止する
+     *
+     * 先に running() を下ろして新しい送信フレームの受け渡しを止め、受け渡し中の送信フレームも
+     * 送信してから終了します。停止処理中の送信は I/O スレッドの終了を待ってから直接送信します。
+     */
+    void stop()
+    {
+        if (!thread_.joinable()) {
+            return;
+        }
+        running_.store(false, std::memory_order_seq_cst);
+        stop_requested_.store(true, std::memory_order_release);
+        wake();
+        thread_.join();
+    }
+
+    /**
+     * @brief I/O スレッドが動作中か
+     *
+     * @return true 動作中
+     * @return false 停止中
+     */
+    bool running() const
+    {
+        return running_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief スナップショットを登録する
+     *
+     * フレームを配送するたびに I/O スレッドでスナップショットを更新します。
+     *
+     * @param snapshot 登録するスナップショット (バスより長く存在すること)
+     * @return true 登録成功
+     * @return false 登録数の上限、または動作中
+     */
+    template <typename Device, typename State>
+    bool add_snapshot(DeviceSnapshot<Device, State>& snapshot)
+    {
+        if (running() || snapshot_count_ >= snapshots_.size()) {
+            return false;
+        }
+        Publisher& publisher = snapshots_[snapshot_count_];
+        publisher.context    = &snapshot;
+        publisher.publish    = [](void* context) {
+            static_cast<DeviceSnapshot<Device, State>*>(context)->publish();
+        };
+        snapshot_count_++;
+        return true;
+    }
+
+    /**
+     * @brief CANフレーム送信関数 (任意のスレッド)
+     *
+     * 動作中は送信フレームを I/O スレッドへ渡して戻ります。
+     *
+     * @param frame 送信するCANフレームの参照
+     * @return true 送信成功、または I/O スレッドへ渡した
+     * @return false 送信失敗 (最大データ長超過、受け渡し用のバッファが満杯など)
+     */
+    bool send_frame(const CANFrameView& frame) override
+    {
+        if (!enter_handoff()) {
+            return Base::send_frame(frame);
+        }
+        const bool handed = hand_off(frame, false);
+        leave_handoff();
+        return handed;
+    }
+
+    /**
+     * @brief 複数のCANフレームをまとめて送信する関数 (任意のスレッド)
+     *
+     * @param frames 送信するCANフレームの参照の配列
+     * @param count 送信するフレーム数
+     * @return std::size_t 送信または I/O スレッドへ渡せたフレーム数
+     */
+    std::size_t send_frames(const CANFrameView* frames, std::size_t count) override
+    {
+        if (!enter_handoff()) {
+            return Base::send_frames(frames, count);
+        }
+        std::size_t handed = 0;
+        while (handed < count && hand_off(frames[handed], false)) {
+            handed++;
+        }
+        leave_handoff();
+        return handed;
+    }
+
+    /**
+     * @brief 最新値だけを送信するCANフレーム送信関数 (任意のスレッド)
+     *
+     * 同じCAN IDの置き換えは I/O スレッドが送信キューで行います。
+     *
+     * @param frame 送信するCANフレームの参照
+     * @return true 送信成功、または I/O スレッドへ渡した
+     * @return false 送信失敗 (最大データ長超過、受け渡し用のバッファが満杯など)
+     */
+    bool send_frame_latest(const CANFrameView& frame) override
+    {
+        if (!enter_handoff()) {
+            return Base::send_frame_latest(frame);
+        }
+        const bool handed = hand_off(frame, true);
+        leave_handoff();
+        return handed;
+    }
+
+    /**
+     * @brief 受け渡し用のバッファが満杯で破棄した送信フレーム数を取得する
+     *
+     * HANDOFF_SIZE の見積もりに使用します。
+     *
+     * @return uint32_t 破棄したフレーム数
+     */
+    uint32_t handoff_dropped_count() const
+    {
+        return handoff_.overflow_count();
+    }
+
+private:
+    /**
+     * @brief 制御スレッドから I/O スレッドへ渡す送信要求
+     */
+    struct TxRequest {
+        Frame frame;          // 送信フレーム
+        bool latest = false;  // send_frame_latest() で送信するか
+    };
+
+    /**
+     * @brief 登録されたスナップショット
+     */
+    struct Publisher {
+        using Publish = void (*)(void* context);
+
+        void* context   = nullptr;  // DeviceSnapshot へのポインタ
+        Publish publish = nullptr;  // スナップショットを更新する関数
+    };
+
+    /**
+     * @brief 送信フレームの受け渡しを始める
+     *
+     * 受け渡し中の送信数を数えるため、I/O スレッドは停止時に受け渡しが終わるのを待ってから
+     * 最後の送信を行えます。停止処理中は I/O スレッドの終了を待ち、直接送信させます。
+     *
+     * @return true I/O スレッドへ渡す (leave_handoff() を呼ぶこと)
+     * @return false 停止中のため直接送信する
+     */
+    bool enter_handoff()
+    {
+        senders_.fetch_add(1, std::memory_order_seq_cst);
+        if (running_.load(std::memory_order_seq_cst)) {
+            return true;
+        }
+        senders_.fetch_sub(1, std::memory_order_release);
+        while (io_active_.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        return false;
+    }
+
+    /**
+     * @brief 送信フレームの受け渡しを終える
+     */
+    void leave_handoff()
+    {
+        senders_.fetch_sub(1, std::memory_order_release);
+    }
+
+    /**
+     * @brief 送信フレームを I/O スレッドへ渡す
+     *
+     * @param frame 送信フレーム
+     * @param latest send_frame_latest() で送信するか
+     * @return true 受け渡し成功
+     * @return false 最大データ長超過、またはバッファが満杯
+     */
+    bool hand_off(const CANFrameView& frame, bool latest)
+    {
+        if (frame.dlc > MaxDLC) {
+            return false;
+        }
+        TxRequest request;
+        request.frame  = Frame(frame);
+        request.latest = latest;
+        if (!handoff_.push(request)) {
+            return false;
+        }
+
+        // I/O スレッドが眠っている場合だけ起こす
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping_.exchange(false, std::memory_order_seq_cst)) {
+            wake();
+        }
+        return true;
+    }
+
+    /**
+     * @brief I/O スレッドを起こす
+     */
+    void wake()
+    {
+        const uint64_t value = 1;
+        ssize_t written      = ::write(wake_fd_, &value, sizeof(value));
+        (void)written;
+    }
+
+    /**
+     * @brief 積まれている送信フレームを送信する (I/O スレッド)
+     *
+     * 連続する通常の送信フレームは send_frames() でまとめてドライバへ渡します。
+     * 送信キューの空きを超えては取り出さないため、送信が詰まっている間は受け渡し用のバッファに
+     * 残り、満杯になると制御スレッドの送信が失敗します (送信キューで破棄されることはありません)。
+     *
+     * @return std::size_t 取り出した送信フレーム数
+     */
+    std::size_t flush_handoff()
+    {
+        std::array<TxRequest, Base::TX_BATCH_SIZE> requests;
+        std::array<Frame, Base::TX_BATCH_SIZE> frames;
+        std::size_t total = 0;
+        while (true) {
+            std::size_t max_count = tx_queue_space();
+            if (max_count > requests.size()) {
+                max_count = requests.size();
+            }
+            const std::size_t count = handoff_.pop_many(requests.data(), max_count);
+            if (count == 0) {
+                return total;
+            }
+            total += count;
+
+            std::size_t pending = 0;
+            for (std::size_t i = 0; i < count; i++) {
+                if (!requests[i].latest) {
+                    frames[pending] = requests[i].frame;
+                    pending++;
+                    continue;
+                }
+                Base::send_frames(frames.data(), pending);
+                pending = 0;
+                Base::send_frame_latest(requests[i].frame);
+            }
+            Base::send_frames(frames.data(), pending);
+        }
+    }
+
+    /**
+     * @brief 送信キューの空きを取得する (I/O スレッド)
+     *
+     * @return std::size_t 送信キューに追加できるフレーム数
+     */
+    std::size_t tx_queue_space() const
+    {
+        return Base::TX_QUEUE_SIZE - Base::tx_queue_size();
+    }
+
+    /**
+     * @brief スナップショットを更新する (I/O スレッド)
+     */
+    void publish_snapshots()
+    {
+        for (std::size_t i = 0; i < snapshot_count_; i++) {
+            snapshots_[i].publish(snapshots_[i].context);
+        }
+    }
+
+    /**
+     * @brief 受信・送信可能になるか、制御スレッドから送信フレームが渡されるまで眠る (I/O スレッド)
+     */
+    void wait()
+    {
+        sleeping_.store(true, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        // 眠る直前に渡された送信フレームを取りこぼさない (送信キューが満杯なら送信可能になるまで眠る)
+        const bool sendable = !handoff_.empty() && tx_queue_space() > 0;
+        if (sendable || stop_requested_.load(std::memory_order_acquire)) {
+            sleeping_.store(false, std::memory_order_relaxed);
+            return;
+        }
+
+        std::array<pollfd, 2> fds{};
+        fds[0].fd     = wake_fd_;
+        fds[0].events = POLLIN;
+        nfds_t count  = 1;
+        int timeout   = IDLE_POLL_MS;
+        if (fd_ >= 0) {
+            fds[1].fd     = fd_;
+            fds[1].events = POLLIN;
+            if (Base::tx_queue_size() > 0) {
+                fds[1].events |= POLLOUT;
+            }
+            count   = 2;
+            timeout = -1;
+        }
+        poll(fds.data(), count, timeout);
+        sleeping_.store(false, std::memory_order_relaxed);
+
+        uint64_t value;
+        while (::read(wake_fd_, &value, sizeof(value)) == sizeof(value)) {
+        }
+    }
+
+    /**
+     * @brief I/O スレッドの処理
+     */
+    void run()
+    {
+        while (!stop_requested_.load(std::memory_order_acquire)) {
+            const std::size_t handed  = flush_handoff();
+            const UpdateResult result = Base::update(FRAMES_PER_UPDATE);
+            if (result.processed > 0) {
+                publish_snapshots();
+            }
+            if (handed == 0 && result.processed == 0) {
+                wait();
+            }
+        }
+
+        // stop() が running_ を下ろす前に受け渡しを始めた送信フレームを待ってから送信する
+        while (senders_.load(std::memory_order_seq_cst) != 0) {
+            std::this_thread::yield();
+        }
+        flush_handoff();
+        Base::on_tx_complete();
+        io_active_.store(false, std::memory_order_release);
+    }
+
+    int fd_;                                            // ドライバのファイルディスクリプタ (ない場合は -1)
+    int wake_fd_;                                       // I/O スレッドを起こす eventfd
+    std::thread thread_;                                // I/O スレッド
+    std::atomic<bool> running_{false};                  // I/O スレッドが動作中か
+    std::atomic<bool> stop_requested_{false};           // stop() が呼ばれたか
+    std::atomic<bool> sleeping_{false};                 // I/O スレッドが眠っているか
+    std::atomic<bool> io_active_{false};                // I/O スレッドがバスを操作しているか
+    std::atomic<uint32_t> senders_{0};                  // 受け渡し中の送信数
+    MPSCRing<TxRequest, HANDOFF_SIZE> handoff_;         // 制御スレッドからの送信フレーム
+    std::array<Publisher, MAX_SNAPSHOTS> snapshots_{};  // 登録されたスナップショット
+    std::size_t snapshot_count_ = 0;                    // 登録数
+};
+
+// クラシックCANのフレームを扱う I/O スレッド付きバス
+using ThreadedCANBus = BasicThreadedCANBus<8>;
+
+// CAN FD のフレームを扱う I/O スレッド付きバス
+using ThreadedFDCANBus = BasicThreadedCANBus<64>;
+
+}  // namespace drivers
+}  // namespace gn10_can
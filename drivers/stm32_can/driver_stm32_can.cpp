@@ -5,21 +5,10 @@ namespace drivers {
 
 bool DriverSTM32CAN::init()
 {
-    CAN_FilterTypeDef filter;
-    filter.FilterIdHigh         = 0;
-    filter.FilterIdLow          = 0;
-    filter.FilterMaskIdHigh     = 0;
-    filter.FilterMaskIdLow      = 0;
-    filter.FilterFIFOAssignment = CAN_RX_FIFO0;
-    filter.FilterBank           = 0;
-    filter.FilterMode           = CAN_FILTERMODE_IDMASK;
-    filter.FilterScale          = CAN_FILTERSCALE_32BIT;
-    filter.FilterActivation     = ENABLE;
-    filter.SlaveStartFilterBank = 14;
-
-    if (HAL_CAN_ConfigFilter(hcan_, &filter) != HAL_OK) {
+    if (!apply_filters()) {
         return false;
     }
+    initialized_ = true;
 
     if (HAL_CAN_Start(hcan_) != HAL_OK) {
         return false;
@@ -29,6 +18,88 @@ bool DriverSTM32CAN::init()
         return false;
     }
 
+    // メールボックスが空いたら送信キューを補充できるよう送信完了割り込みを有効にする
+    if (HAL_CAN_ActivateNotification(hcan_, CAN_IT_TX_MAILBOX_EMPTY) != HAL_OK) {
+        return false;
+    }
+
+    return true;
+}
+
+bool DriverSTM32CAN::set_filters(const AcceptanceFilter* filters, std::size_t count)
+{
+    if (count > filter_capacity() || count > filters_.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        filters_[i] = filters[i];
+    }
+    filter_count_ = count;
+    filtering_    = true;
+
+    // 初期化前は init() で設定する
+    if (!initialized_) {
+        return true;
+    }
+    return apply_filters();
+}
+
+bool DriverSTM32CAN::clear_filters()
+{
+    filter_count_ = 0;
+    filtering_    = false;
+
+    if (!initialized_) {
+        return true;
+    }
+    return apply_filters();
+}
+
+bool DriverSTM32CAN::apply_filters()
+{
+    // 16bitスケールのレジスタ配置: STID[10:0] | RTR | IDE | EXID[17:15]
+    constexpr uint32_t STD_ID_SHIFT = 5;
+    constexpr uint32_t RTR_IDE_BITS = 0x18;  // データフレームかつ標準IDのみ受け付ける
+
+    CAN_FilterTypeDef filter;
+    filter.FilterFIFOAssignment = CAN_RX_FIFO0;
+    filter.FilterMode           = CAN_FILTERMODE_IDMASK;
+    filter.SlaveStartFilterBank = 14;
+
+    for (uint32_t bank = 0; bank < filter_bank_count_; bank++) {
+        filter.FilterBank       = filter_bank_start_ + bank;
+        filter.FilterIdHigh     = 0;
+        filter.FilterIdLow      = 0;
+        filter.FilterMaskIdHigh = 0;
+        filter.FilterMaskIdLow  = 0;
+        filter.FilterScale      = CAN_FILTERSCALE_32BIT;
+        filter.FilterActivation = DISABLE;
+
+        const std::size_t first = bank * FILTERS_PER_BANK;
+        if (!filtering_) {
+            // 先頭のバンクだけを全て受け付けるマスクにする
+            if (bank == 0) {
+                filter.FilterActivation = ENABLE;
+            }
+        } else if (first < filter_count_) {
+            // 1バンクに2つのID/マスクを入れる (奇数個の場合は同じフィルタを2つ入れる)
+            const AcceptanceFilter& low = filters_[first];
+            AcceptanceFilter high       = low;
+            if (first + 1 < filter_count_) {
+                high = filters_[first + 1];
+            }
+            filter.FilterScale      = CAN_FILTERSCALE_16BIT;
+            filter.FilterIdLow      = (low.id << STD_ID_SHIFT) & 0xFFE0;
+            filter.FilterMaskIdLow  = ((low.mask << STD_ID_SHIFT) & 0xFFE0) | RTR_IDE_BITS;
+            filter.FilterIdHigh     = (high.id << STD_ID_SHIFT) & 0xFFE0;
+            filter.FilterMaskIdHigh = ((high.mask << STD_ID_SHIFT) & 0xFFE0) | RTR_IDE_BITS;
+            filter.FilterActivation = ENABLE;
+        }
+
+        if (HAL_CAN_ConfigFilter(hcan_, &filter) != HAL_OK) {
+            return false;
+        }
+    }
     return true;
 }
 
@@ -44,11 +115,7 @@ bool DriverSTM32CAN::send(const CANFrame& frame)
     } else {
         tx_header.IDE = CAN_ID_STD;
     }
-    if (frame.is_rtr) {
-        tx_header.RTR = CAN_RTR_REMOTE;
-    } else {
-        tx_header.RTR = CAN_RTR_DATA;
-    }
+    tx_header.RTR                = CAN_RTR_DATA;
     tx_header.DLC                = frame.dlc;
     tx_header.TransmitGlobalTime = DISABLE;
 
@@ -57,10 +124,18 @@ bool DriverSTM32CAN::send(const CANFrame& frame)
         ) != HAL_OK) {
         return false;
     }
+
+    // 送信完了イベントで通知するため、メールボックスごとに送信したIDを覚えておく
+    for (std::size_t i = 0; i < TX_MAILBOX_COUNT; i++) {
+        if (tx_mailbox == (CAN_TX_MAILBOX0 << i)) {
+            tx_mailbox_frames_[i].id          = frame.id;
+            tx_mailbox_frames_[i].is_extended = frame.is_extended;
+        }
+    }
     return true;
 }
 
-bool DriverSTM32CAN::receive(CANFrame& out_frame)
+bool DriverSTM32CAN::read_fifo(CANFrame& out_frame)
 {
     CAN_RxHeaderTypeDef rx_header;
     uint8_t rx_data[8];
@@ -76,6 +151,12 @@ bool DriverSTM32CAN::receive(CANFrame& out_frame)
     }
     out_frame.dlc         = rx_header.DLC;
     out_frame.is_extended = (rx_header.IDE == CAN_ID_EXT);
+    // タイムスタンプは時間トリガ通信モード (TTCM) が有効な場合のみ記録される
+    if (hcan_->Init.TimeTriggeredMode == ENABLE) {
+        out_frame.timestamp = timestamps_.extend(static_cast<uint16_t>(rx_header.Timestamp));
+    } else {
+        out_frame.timestamp = 0;
+    }
 
     for (uint8_t i = 0; i < out_frame.dlc; ++i) {
         out_frame.data[i] = rx_data[i];
@@ -84,5 +165,53 @@ bool DriverSTM32CAN::receive(CANFrame& out_frame)
     return true;
 }
 
+bool DriverSTM32CAN::receive(CANFrame& out_frame)
+{
+    return rx_ring_.pop(out_frame);
+}
+
+std::size_t DriverSTM32CAN::receive_many(CANFrame* out_frames, std::size_t max_count)
+{
+    return rx_ring_.pop_many(out_frames, max_count);
+}
+
+void DriverSTM32CAN::handle_rx_interrupt()
+{
+    // ハードウェアFIFOのオーバーランを検出したら記録してクリアする
+    if (__HAL_CAN_GET_FLAG(hcan_, CAN_FLAG_FOV0)) {
+        __HAL_CAN_CLEAR_FLAG(hcan_, CAN_FLAG_FOV0);
+        rx_hw_overrun_count_.store(
+            rx_hw_overrun_count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed
+        );
+    }
+
+    // FIFOを空にして割り込み要因を解除する (リングバッファが満杯のフレームは破棄され記録される)
+    CANFrame frame;
+    while (read_fifo(frame)) {
+        rx_ring_.push(frame);
+    }
+}
+
+bool DriverSTM32CAN::receive_tx_event(TxEvent& out_event)
+{
+    return tx_events_.pop(out_event);
+}
+
+void DriverSTM32CAN::handle_tx_interrupt(uint32_t tx_mailbox)
+{
+    for (std::size_t i = 0; i < TX_MAILBOX_COUNT; i++) {
+        if (tx_mailbox != (CAN_TX_MAILBOX0 << i)) {
+            continue;
+        }
+
+        TxEvent tx_event = tx_mailbox_frames_[i];
+        if (hcan_->Init.TimeTriggeredMode == ENABLE) {
+            uint32_t raw       = HAL_CAN_GetTxTimestamp(hcan_, tx_mailbox);
+            tx_event.timestamp = timestamps_.extend(static_cast<uint16_t>(raw));
+        }
+        tx_events_.push(tx_event);
+    }
+}
+
 }  // namespace drivers
 }  // namespace gn10_can
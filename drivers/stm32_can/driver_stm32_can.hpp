@@ -10,25 +10,172 @@
  */
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 
+#include "gn10_can/core/spsc_ring.hpp"
 #include "gn10_can/drivers/can_driver_interface.hpp"
+#include "gn10_can/utils/timestamp_extender.hpp"
 #include "main.h"
 
 namespace gn10_can {
 namespace drivers {
 
+/**
+ * @brief STM32 CAN ドライバ
+ * @details
+ * 受信は割り込み駆動です。HAL_CAN_RxFifo0MsgPendingCallback() から handle_rx_interrupt() を呼び出すと、
+ * ハードウェアFIFOの内容をリングバッファへ移します。CANBus::update() はリングバッファから受信します。
+ * 送信完了割り込み (HAL_CAN_TxMailboxNCompleteCallback()) では CANBus::on_tx_complete() を呼び出し、
+ * 送信キューのフレームを空いたメールボックスへ補充してください。
+ *
+ * 時間トリガ通信モード (TTCM) を有効にすると、受信フレームと送信完了イベントに
+ * 16bitタイムスタンプを64bitに拡張した時刻 (ビット時間単位) が入ります。
+ * 送信完了コールバックから handle_tx_interrupt() を呼び出すと送信完了イベントを取得できます。
+ * 送信完了イベントのIDを正しく対応付けるため、LockedCANBus<InterruptLock> と組み合わせ、
+ * 受信・送信の割り込みは同じ優先度に設定してください。
+ *
+ * 受信フィルタは16bitスケールのID/マスクモードで、1つのフィルタバンクに2つ設定します。
+ * CANBus が接続デバイスに合わせて set_filters() で設定し、init() の前に設定された場合は init() で書き込みます。
+ */
 class DriverSTM32CAN : public ICANDriver
 {
 public:
-    DriverSTM32CAN(CAN_HandleTypeDef* hcan) : hcan_(hcan) {}
+    static constexpr std::size_t RX_RING_SIZE       = GN10_CAN_RX_RING_SIZE;  // 受信リングバッファの容量
+    static constexpr std::size_t TX_EVENT_RING_SIZE = 16;                     // 送信完了イベントのリングバッファの容量
+    static constexpr std::size_t TX_MAILBOX_COUNT   = 3;                      // 送信メールボックス数
+
+    static constexpr uint32_t FILTERS_PER_BANK = 2;  // 16bitスケールの1フィルタバンクに入るID/マスクの数
+
+    /**
+     * @brief DriverSTM32CANクラスのコンストラクタ
+     *
+     * CAN1 / CAN2 でフィルタバンクを共有するマイコンでは、使用するバンクが重ならないよう指定してください
+     * (CAN2 のバンクは 14 から)。
+     *
+     * @param hcan HALハンドル
+     * @param filter_bank_start 使用する最初のフィルタバンク
+     * @param filter_bank_count 使用するフィルタバンク数
+     */
+    DriverSTM32CAN(
+        CAN_HandleTypeDef* hcan, uint32_t filter_bank_start = 0, uint32_t filter_bank_count = 14
+    )
+        : hcan_(hcan), filter_bank_start_(filter_bank_start), filter_bank_count_(filter_bank_count)
+    {
+    }
 
     bool init();
     bool send(const CANFrame& frame) override;
     bool receive(CANFrame& out_frame) override;
+    std::size_t receive_many(CANFrame* out_frames, std::size_t max_count) override;
+
+    std::size_t receive_pending() const override
+    {
+        return rx_ring_.size();
+    }
+
+    bool receive_tx_event(TxEvent& out_event) override;
+
+    std::size_t filter_capacity() const override
+    {
+        return filter_bank_count_ * FILTERS_PER_BANK;
+    }
+
+    bool set_filters(const AcceptanceFilter* filters, std::size_t count) override;
+    bool clear_filters() override;
+
+    /**
+     * @brief 受信割り込み処理
+     *
+     * ハードウェアFIFOのフレームをすべてリングバッファへ移します。
+     * HAL_CAN_RxFifo0MsgPendingCallback() から呼び出してください。
+     */
+    void handle_rx_interrupt();
+
+    /**
+     * @brief 送信完了割り込み処理
+     *
+     * 送信完了したメールボックスのフレームIDと送出時刻を送信完了イベントのリングバッファへ積みます。
+     * HAL_CAN_TxMailboxNCompleteCallback() から呼び出してください。
+     *
+     * @param tx_mailbox 送信完了したメールボックス (CAN_TX_MAILBOX0 ~ CAN_TX_MAILBOX2)
+     */
+    void handle_tx_interrupt(uint32_t tx_mailbox);
+
+    /**
+     * @brief リングバッファが満杯で破棄した受信フレーム数を取得する
+     *
+     * @return uint32_t 破棄したフレーム数
+     */
+    uint32_t rx_overflow_count() const
+    {
+        return rx_ring_.overflow_count();
+    }
+
+    /**
+     * @brief ハードウェアFIFOのオーバーランで失われた受信フレームの検出回数を取得する
+     *
+     * @return uint32_t オーバーラン検出回数
+     */
+    uint32_t rx_hw_overrun_count() const
+    {
+        return rx_hw_overrun_count_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 受信オーバーランで失われたフレーム数を取得する
+     *
+     * リングバッファの満杯による破棄とハードウェアFIFOのオーバーラン検出回数の合計です。
+     *
+     * @return uint32_t 受信オーバーランの回数
+     */
+    uint32_t rx_overrun_count() const override
+    {
+        return rx_overflow_count() + rx_hw_overrun_count();
+    }
+
+    /**
+     * @brief リングバッファに同時に格納された受信フレーム数の最大値を取得する
+     *
+     * @return uint32_t 最大格納数の記録
+     */
+    uint32_t rx_high_water_mark() const
+    {
+        return rx_ring_.high_water_mark();
+    }
 
 private:
-    CAN_HandleTypeDef* hcan_;
+    /**
+     * @brief ハードウェアFIFOからフレームを1つ読み出す
+     *
+     * @param out_frame 受信フレームの格納先
+     * @return true 読み出し成功
+     * @return false FIFOが空
+     */
+    bool read_fifo(CANFrame& out_frame);
+
+    /**
+     * @brief 保持している受信フィルタをフィルタバンクへ書き込む
+     *
+     * @return true 設定成功
+     * @return false 設定失敗
+     */
+    bool apply_filters();
+
+    CAN_HandleTypeDef* hcan_;                                         // HALハンドル
+    uint32_t filter_bank_start_;                                      // 使用する最初のフィルタバンク
+    uint32_t filter_bank_count_;                                      // 使用するフィルタバンク数
+    std::array<AcceptanceFilter, MAX_ACCEPTANCE_FILTERS> filters_{};  // 設定する受信フィルタ
+    std::size_t filter_count_ = 0;                                    // 設定する受信フィルタ数
+    bool filtering_           = false;                                // 受信フィルタで絞るか (false: 全て受信)
+    bool initialized_         = false;                                // init() 済みか
+    SPSCRing<CANFrame, RX_RING_SIZE> rx_ring_;                        // 割り込みからメインループへの受信フレーム
+    SPSCRing<TxEvent, TX_EVENT_RING_SIZE> tx_events_;                 // 割り込みからメインループへの送信完了イベント
+    std::array<TxEvent, TX_MAILBOX_COUNT> tx_mailbox_frames_{};       // メールボックスごとの送信中フレーム
+    TimestampExtender timestamps_;                                    // タイムスタンプの拡張 (割り込みのみ更新)
+    std::atomic<uint32_t> rx_hw_overrun_count_{0};                    // ハードウェアFIFOオーバーランの検出回数 (割り込みのみ更新)
 };
 }  // namespace drivers
 }  // namespace gn10_can
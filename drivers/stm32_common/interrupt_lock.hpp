@@ -0,0 +1,47 @@
+/**
+ * @file interrupt_lock.hpp
+ * @author Gento Aiba (aiba-gento)
+ * @brief 割り込み禁止による排他制御クラスのヘッダファイル
+ * @version 0.1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+
+#include "main.h"
+
+namespace gn10_can {
+namespace drivers {
+
+/**
+ * @brief 割り込み禁止による排他制御
+ * @details
+ * LockedCANBus / LockedFDCANBus の Lock に指定すると、メインループと送信完了割り込みの両方から
+ * 送信キューを安全に操作できます。ロック前の割り込み許可状態を保存・復元するため、
+ * 割り込みハンドラ内から呼び出しても割り込みを誤って許可しません。
+ */
+class InterruptLock
+{
+public:
+    void lock()
+    {
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        primask_ = primask;
+    }
+
+    void unlock()
+    {
+        __set_PRIMASK(primask_);
+    }
+
+private:
+    uint32_t primask_ = 0;  // ロック前の PRIMASK
+};
+
+}  // namespace drivers
+}  // namespace gn10_can
@@ -1,32 +1,173 @@
 #include "driver_stm32_fdcan.hpp"
 
+#include <array>
+
+#include "gn10_can/core/fdcan_frame.hpp"
+
 namespace gn10_can {
 namespace drivers {
 
-bool DriverSTM32FDCAN::init()
+namespace {
+
+// DLCコード (0~15) に対応する HAL の DataLength
+constexpr uint32_t DLC_CODES[16] = {
+    FDCAN_DLC_BYTES_0,  FDCAN_DLC_BYTES_1,  FDCAN_DLC_BYTES_2,  FDCAN_DLC_BYTES_3,
+    FDCAN_DLC_BYTES_4,  FDCAN_DLC_BYTES_5,  FDCAN_DLC_BYTES_6,  FDCAN_DLC_BYTES_7,
+    FDCAN_DLC_BYTES_8,  FDCAN_DLC_BYTES_12, FDCAN_DLC_BYTES_16, FDCAN_DLC_BYTES_20,
+    FDCAN_DLC_BYTES_24, FDCAN_DLC_BYTES_32, FDCAN_DLC_BYTES_48, FDCAN_DLC_BYTES_64,
+};
+
+// HAL の DataLength をデータ長に変換する (HAL のバージョンによって DataLength の形式が異なるため表で引く)
+uint8_t length_of(uint32_t data_length)
 {
-    FDCAN_FilterTypeDef filter;
-    filter.IdType       = FDCAN_STANDARD_ID;
-    filter.FilterIndex  = 0;
-    filter.FilterType   = FDCAN_FILTER_MASK;
-    filter.FilterConfig = FDCAN_FILTER_TO_RXFIFO0;
-    filter.FilterID1    = 0x000;
-    filter.FilterID2    = 0x000;
-
-    if (HAL_FDCAN_ConfigFilter(hfdcan_, &filter) != HAL_OK) {
+    for (uint8_t code = 0; code < 16; code++) {
+        if (DLC_CODES[code] == data_length) {
+            return fd::code_to_dlc(code);
+        }
+    }
+    return 0;
+}
+
+}  // namespace
+
+template <std::size_t MaxDLC>
+bool BasicDriverSTM32FDCAN<MaxDLC>::init(uint32_t timestamp_prescaler)
+{
+    // フィルタ要素に一致しないフレームは破棄する (リモートフレームは扱わないため常に破棄する)
+    if (filter_capacity() == 0) {
+        return false;
+    }
+    if (HAL_FDCAN_ConfigGlobalFilter(
+            hfdcan_, FDCAN_REJECT, FDCAN_REJECT, FDCAN_REJECT_REMOTE, FDCAN_REJECT_REMOTE
+        ) != HAL_OK) {
+        return false;
+    }
+    if (!apply_filters()) {
+        return false;
+    }
+    // 受信時刻・送出時刻を記録するタイムスタンプカウンタ (ビット時間 × プリスケーラ単位)
+    if (HAL_FDCAN_ConfigTimestampCounter(hfdcan_, timestamp_prescaler) != HAL_OK) {
+        return false;
+    }
+    if (HAL_FDCAN_EnableTimestampCounter(hfdcan_, FDCAN_TIMESTAMP_INTERNAL) != HAL_OK) {
         return false;
     }
+    // データフェーズを高速に送る場合は、トランシーバの遅延をサンプル点で補償する
+    if (hfdcan_->Init.FrameFormat == FDCAN_FRAME_FD_BRS) {
+        const uint32_t offset = hfdcan_->Init.DataPrescaler * hfdcan_->Init.DataTimeSeg1;
+        if (HAL_FDCAN_ConfigTxDelayCompensation(hfdcan_, offset, 0) != HAL_OK) {
+            return false;
+        }
+        if (HAL_FDCAN_EnableTxDelayCompensation(hfdcan_) != HAL_OK) {
+            return false;
+        }
+    }
     if (HAL_FDCAN_Start(hfdcan_) != HAL_OK) {
         return false;
     }
+    initialized_ = true;
+
     if (HAL_FDCAN_ActivateNotification(hfdcan_, FDCAN_IT_RX_FIFO0_NEW_MESSAGE, 0) != HAL_OK) {
         return false;
     }
+    // 送信バッファが空いたら送信キューを補充できるよう送信完了割り込みを有効にする
+    if (HAL_FDCAN_ActivateNotification(
+            hfdcan_,
+            FDCAN_IT_TX_COMPLETE,
+            FDCAN_TX_BUFFER0 | FDCAN_TX_BUFFER1 | FDCAN_TX_BUFFER2
+        ) != HAL_OK) {
+        return false;
+    }
+    // 送出時刻を取得するため送信イベントFIFOの割り込みを有効にする
+    if (HAL_FDCAN_ActivateNotification(hfdcan_, FDCAN_IT_TX_EVT_FIFO_NEW_DATA, 0) != HAL_OK) {
+        return false;
+    }
     return true;
 }
 
-bool DriverSTM32FDCAN::send(const CANFrame& frame)
+template <std::size_t MaxDLC>
+bool BasicDriverSTM32FDCAN<MaxDLC>::set_filters(const AcceptanceFilter* filters, std::size_t count)
 {
+    if (count > filter_capacity() || count > filters_.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        filters_[i] = filters[i];
+    }
+    filter_count_ = count;
+    filtering_    = true;
+
+    // 初期化前は init() で設定する
+    if (!initialized_) {
+        return true;
+    }
+    return apply_filters();
+}
+
+template <std::size_t MaxDLC>
+bool BasicDriverSTM32FDCAN<MaxDLC>::clear_filters()
+{
+    filter_count_ = 0;
+    filtering_    = false;
+
+    if (!initialized_) {
+        return true;
+    }
+    return apply_filters();
+}
+
+template <std::size_t MaxDLC>
+bool BasicDriverSTM32FDCAN<MaxDLC>::apply_filters()
+{
+    // フィルタ要素は動作中でも書き換えられる。グローバルフィルタは init() で固定し、
+    // 全て受信する場合もマスク0のフィルタ要素で表すため、動作中にFDCANを停止しない
+    // (停止すると送信バッファと受信FIFOのフレームが失われる)
+    FDCAN_FilterTypeDef filter;
+    filter.IdType     = FDCAN_STANDARD_ID;
+    filter.FilterType = FDCAN_FILTER_MASK;
+    for (uint32_t index = 0; index < filter_capacity(); index++) {
+        filter.FilterIndex  = index;
+        filter.FilterConfig = FDCAN_FILTER_DISABLE;
+        filter.FilterID1    = 0x000;
+        filter.FilterID2    = 0x000;
+        if (filtering_ && index < filter_count_) {
+            filter.FilterConfig = FDCAN_FILTER_TO_RXFIFO0;
+            filter.FilterID1    = filters_[index].id;
+            filter.FilterID2    = filters_[index].mask;
+        }
+        if (!filtering_ && index == 0) {
+            filter.FilterConfig = FDCAN_FILTER_TO_RXFIFO0;
+        }
+        if (HAL_FDCAN_ConfigFilter(hfdcan_, &filter) != HAL_OK) {
+            return false;
+        }
+    }
+
+    // 拡張IDのフレームは全て受信する場合のみ受信する
+    if (hfdcan_->Init.ExtFiltersNbr > 0) {
+        filter.IdType       = FDCAN_EXTENDED_ID;
+        filter.FilterIndex  = 0;
+        filter.FilterConfig = FDCAN_FILTER_TO_RXFIFO0;
+        filter.FilterID1    = 0x000;
+        filter.FilterID2    = 0x000;
+        if (filtering_) {
+            filter.FilterConfig = FDCAN_FILTER_DISABLE;
+        }
+        if (HAL_FDCAN_ConfigFilter(hfdcan_, &filter) != HAL_OK) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <std::size_t MaxDLC>
+bool BasicDriverSTM32FDCAN<MaxDLC>::send(const Frame& frame)
+{
+    const bool fd_format = hfdcan_->Init.FrameFormat != FDCAN_FRAME_CLASSIC;
+    if (frame.dlc > 8 && !fd_format) {
+        return false;
+    }
+
     FDCAN_TxHeaderTypeDef tx_header;
     if (frame.is_extended) {
         tx_header.IdType = FDCAN_EXTENDED_ID;
@@ -35,33 +176,66 @@ bool DriverSTM32FDCAN::send(const CANFrame& frame)
     }
     tx_header.Identifier          = frame.id;
     tx_header.TxFrameType         = FDCAN_DATA_FRAME;
-    tx_header.DataLength          = frame.dlc;
+    tx_header.DataLength          = DLC_CODES[fd::dlc_to_code(frame.dlc)];
     tx_header.ErrorStateIndicator = FDCAN_ESI_ACTIVE;
     tx_header.BitRateSwitch       = FDCAN_BRS_OFF;
     tx_header.FDFormat            = FDCAN_CLASSIC_CAN;
-    tx_header.TxEventFifoControl  = FDCAN_NO_TX_EVENTS;
+    tx_header.TxEventFifoControl  = FDCAN_STORE_TX_EVENTS;
     tx_header.MessageMarker       = 0;
+    // 8バイト以下はクラシックCANのノードも受信できるようにクラシックCANのフレームで送る
+    if (fd::requires_fd_format(frame.dlc)) {
+        tx_header.FDFormat = FDCAN_FD_CAN;
+        if (hfdcan_->Init.FrameFormat == FDCAN_FRAME_FD_BRS) {
+            tx_header.BitRateSwitch = FDCAN_BRS_ON;
+        }
+    }
 
-    if (HAL_FDCAN_AddMessageToTxFifoQ(
-            hfdcan_, &tx_header, const_cast<uint8_t*>(frame.data.data())
-        ) != HAL_OK) {
+    // CAN FD で表現できないデータ長は、送信する長さまでパディングする
+    const uint8_t* data = frame.data.data();
+    std::array<uint8_t, 64> padded;
+    const uint8_t length = fd::padded_length(frame.dlc);
+    if (length != frame.dlc) {
+        for (uint8_t i = 0; i < length; i++) {
+            padded[i] = fd::PADDING_BYTE;
+            if (i < frame.dlc) {
+                padded[i] = frame.data[i];
+            }
+        }
+        data = padded.data();
+    }
+
+    if (HAL_FDCAN_AddMessageToTxFifoQ(hfdcan_, &tx_header, const_cast<uint8_t*>(data)) != HAL_OK) {
         return false;
     }
     return true;
 }
 
-bool DriverSTM32FDCAN::receive(CANFrame& out_frame)
+template <std::size_t MaxDLC>
+bool BasicDriverSTM32FDCAN<MaxDLC>::read_fifo(Frame& out_frame)
 {
     FDCAN_RxHeaderTypeDef rx_header;
-    uint8_t rx_data[8];
+    uint8_t rx_data[64];  // ペリフェラルの設定によらず最大長のフレームを格納できる大きさ
 
-    if (HAL_FDCAN_GetRxMessage(hfdcan_, FDCAN_RX_FIFO0, &rx_header, rx_data) != HAL_OK) {
-        return false;
+    uint8_t length;
+    while (true) {
+        if (HAL_FDCAN_GetRxMessage(hfdcan_, FDCAN_RX_FIFO0, &rx_header, rx_data) != HAL_OK) {
+            return false;
+        }
+        length = length_of(rx_header.DataLength);
+        if (length <= MaxDLC) {
+            break;
+        }
+        // 扱えるデータ長を超えるフレーム (クラシックCAN用ドライバでの CAN FD フレーム) は
+        // 切り詰めずに破棄して記録し、次のフレームを読み出す
+        rx_oversize_count_.store(
+            rx_oversize_count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed
+        );
     }
 
     out_frame.id          = rx_header.Identifier;
-    out_frame.dlc         = rx_header.DataLength;
+    out_frame.dlc         = length;
     out_frame.is_extended = (rx_header.IdType == FDCAN_EXTENDED_ID);
+    out_frame.timestamp   = timestamps_.extend(static_cast<uint16_t>(rx_header.RxTimestamp));
 
     for (uint8_t i = 0; i < out_frame.dlc; ++i) {
         out_frame.data[i] = rx_data[i];
@@ -70,5 +244,57 @@ bool DriverSTM32FDCAN::receive(CANFrame& out_frame)
     return true;
 }
 
+template <std::size_t MaxDLC>
+bool BasicDriverSTM32FDCAN<MaxDLC>::receive(Frame& out_frame)
+{
+    return rx_ring_.pop(out_frame);
+}
+
+template <std::size_t MaxDLC>
+std::size_t BasicDriverSTM32FDCAN<MaxDLC>::receive_many(Frame* out_frames, std::size_t max_count)
+{
+    return rx_ring_.pop_many(out_frames, max_count);
+}
+
+template <std::size_t MaxDLC>
+void BasicDriverSTM32FDCAN<MaxDLC>::handle_rx_interrupt()
+{
+    // ハードウェアFIFOのオーバーランを検出したら記録してクリアする
+    if (__HAL_FDCAN_GET_FLAG(hfdcan_, FDCAN_FLAG_RX_FIFO0_MESSAGE_LOST)) {
+        __HAL_FDCAN_CLEAR_FLAG(hfdcan_, FDCAN_FLAG_RX_FIFO0_MESSAGE_LOST);
+        rx_hw_overrun_count_.store(
+            rx_hw_overrun_count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed
+        );
+    }
+
+    // FIFOを空にして割り込み要因を解除する (リングバッファが満杯のフレームは破棄され記録される)
+    Frame frame;
+    while (read_fifo(frame)) {
+        rx_ring_.push(frame);
+    }
+}
+
+template <std::size_t MaxDLC>
+bool BasicDriverSTM32FDCAN<MaxDLC>::receive_tx_event(TxEvent& out_event)
+{
+    return tx_events_.pop(out_event);
+}
+
+template <std::size_t MaxDLC>
+void BasicDriverSTM32FDCAN<MaxDLC>::handle_tx_event_interrupt()
+{
+    FDCAN_TxEventFifoTypeDef event;
+    while (HAL_FDCAN_GetTxEvent(hfdcan_, &event) == HAL_OK) {
+        TxEvent tx_event;
+        tx_event.id          = event.Identifier;
+        tx_event.is_extended = (event.IdType == FDCAN_EXTENDED_ID);
+        tx_event.timestamp   = timestamps_.extend(static_cast<uint16_t>(event.TxTimestamp));
+        tx_events_.push(tx_event);
+    }
+}
+
+template class BasicDriverSTM32FDCAN<8>;
+template class BasicDriverSTM32FDCAN<64>;
+
 }  // namespace drivers
 }  // namespace gn10_can
@@ -10,23 +10,195 @@
  */
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "gn10_can/core/spsc_ring.hpp"
 #include "gn10_can/drivers/can_driver_interface.hpp"
+#include "gn10_can/drivers/fdcan_driver_interface.hpp"
+#include "gn10_can/utils/timestamp_extender.hpp"
 #include "main.h"
 
 namespace gn10_can {
 namespace drivers {
 
-class DriverSTM32FDCAN : public ICANDriver
+/**
+ * @brief STM32 FDCAN ドライバ
+ * @details
+ * 受信は割り込み駆動です。HAL_FDCAN_RxFifo0Callback() から handle_rx_interrupt() を呼び出すと、
+ * ハードウェアFIFOの内容をリングバッファへ移します。CANBus::update() はリングバッファから受信します。
+ * 送信完了割り込み (HAL_FDCAN_TxBufferCompleteCallback()) では CANBus::on_tx_complete() を呼び出し、
+ * 送信キューのフレームを空いた送信バッファへ補充してください。
+ * MaxDLC を超えるデータ長のフレーム (DriverSTM32FDCAN での CAN FD フレーム) は切り詰めずに破棄し、
+ * 受信オーバーランとして数えます。
+ *
+ * 受信フレームと送信完了イベントには、タイムスタンプカウンタを64bitに拡張した時刻が入ります
+ * (単位はビット時間 × プリスケーラ)。送信完了イベントは HAL_FDCAN_TxEventFifoCallback() から
+ * handle_tx_event_interrupt() を呼び出すと取得できます。受信割り込みと同じ優先度で呼び出してください。
+ *
+ * 受信フィルタは標準IDフィルタ要素 (Init.StdFiltersNbr 個、1個以上) にID/マスクで設定し、一致しない
+ * フレームは init() で設定するグローバルフィルタで破棄します。CANBus が接続デバイスに合わせて
+ * set_filters() で設定します。全て受信する状態 (init() 直後・clear_filters()) はマスク0のフィルタ要素
+ * (Init.ExtFiltersNbr が1以上なら拡張IDのフィルタ要素も) で表すため、動作中の切り替えはフィルタ要素の
+ * 書き換えだけで済み、FDCAN を停止しません。送信バッファ・受信FIFO のフレームは失われません。
+ *
+ * 送信フレームの形式はデータ長で決まります。8バイト以下のフレームは常にクラシックCANのフレームで送信し、
+ * 同じバス上のクラシックCANのみのノードも受信できます。8バイトを超えるフレームは HAL の Init.FrameFormat が
+ * FDCAN_FRAME_FD_BRS / FDCAN_FRAME_FD_NO_BRS の場合に CAN FD フレームで送信し (FDCAN_FRAME_FD_BRS では
+ * データフェーズをデータビットレートで送信)、CAN FD で表現できないデータ長は次の長さ
+ * (12/16/20/24/32/48/64) まで fd::PADDING_BYTE で埋めます。FDCAN_FRAME_FD_BRS では送信遅延補償も有効にします。
+ *
+ * @tparam MaxDLC 扱うフレームの最大データ長 (CAN: 8, CAN FD: 64)
+ */
+template <std::size_t MaxDLC>
+class BasicDriverSTM32FDCAN : public detail::ICANDriver<MaxDLC>
 {
 public:
-    DriverSTM32FDCAN(FDCAN_HandleTypeDef* hfdcan) : hfdcan_(hfdcan) {}
+    using Frame = detail::CANFrame<MaxDLC>;
+
+    static constexpr std::size_t RX_RING_SIZE       = GN10_CAN_RX_RING_SIZE;  // 受信リングバッファの容量
+    static constexpr std::size_t TX_EVENT_RING_SIZE = 16;                     // 送信完了イベントのリングバッファの容量
+
+    BasicDriverSTM32FDCAN(FDCAN_HandleTypeDef* hfdcan) : hfdcan_(hfdcan) {}
+
+    /**
+     * @brief フィルタ・タイムスタンプカウンタ・送信遅延補償・割り込みを設定してFDCANを開始する
+     *
+     * @param timestamp_prescaler タイムスタンプカウンタのプリスケーラ (FDCAN_TIMESTAMP_PRESC_x)
+     * @return true 開始成功
+     * @return false 開始失敗
+     */
+    bool init(uint32_t timestamp_prescaler = FDCAN_TIMESTAMP_PRESC_1);
+    bool send(const Frame& frame) override;
+    bool receive(Frame& out_frame) override;
+    std::size_t receive_many(Frame* out_frames, std::size_t max_count) override;
+
+    std::size_t receive_pending() const override
+    {
+        return rx_ring_.size();
+    }
+
+    bool receive_tx_event(TxEvent& out_event) override;
+
+    std::size_t filter_capacity() const override
+    {
+        return hfdcan_->Init.StdFiltersNbr;
+    }
 
-    bool init();
-    bool send(const CANFrame& frame) override;
-    bool receive(CANFrame& out_frame) override;
+    bool set_filters(const AcceptanceFilter* filters, std::size_t count) override;
+    bool clear_filters() override;
+
+    /**
+     * @brief 受信割り込み処理
+     *
+     * ハードウェアFIFOのフレームをすべてリングバッファへ移します。
+     * HAL_FDCAN_RxFifo0Callback() から呼び出してください。
+     */
+    void handle_rx_interrupt();
+
+    /**
+     * @brief 送信イベント割り込み処理
+     *
+     * 送信イベントFIFOの送出時刻をすべて送信完了イベントのリングバッファへ移します。
+     * HAL_FDCAN_TxEventFifoCallback() から呼び出してください。
+     */
+    void handle_tx_event_interrupt();
+
+    /**
+     * @brief リングバッファが満杯で破棄した受信フレーム数を取得する
+     *
+     * @return uint32_t 破棄したフレーム数
+     */
+    uint32_t rx_overflow_count() const
+    {
+        return rx_ring_.overflow_count();
+    }
+
+    /**
+     * @brief ハードウェアFIFOのオーバーランで失われた受信フレームの検出回数を取得する
+     *
+     * @return uint32_t オーバーラン検出回数
+     */
+    uint32_t rx_hw_overrun_count() const
+    {
+        return rx_hw_overrun_count_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 扱えるデータ長 (MaxDLC) を超えるため破棄した受信フレーム数を取得する
+     *
+     * @return uint32_t 破棄したフレーム数
+     */
+    uint32_t rx_oversize_count() const
+    {
+        return rx_oversize_count_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 受信オーバーランで失われたフレーム数を取得する
+     *
+     * リングバッファの満杯による破棄、ハードウェアFIFOのオーバーラン検出回数、
+     * MaxDLC を超えるデータ長による破棄の合計です。
+     *
+     * @return uint32_t 受信オーバーランの回数
+     */
+    uint32_t rx_overrun_count() const override
+    {
+        return rx_overflow_count() + rx_hw_overrun_count() + rx_oversize_count();
+    }
+
+    /**
+     * @brief リングバッファに同時に格納された受信フレーム数の最大値を取得する
+     *
+     * @return uint32_t 最大格納数の記録
+     */
+    uint32_t rx_high_water_mark() const
+    {
+        return rx_ring_.high_water_mark();
+    }
 
 private:
-    FDCAN_HandleTypeDef* hfdcan_;
+    /**
+     * @brief ハードウェアFIFOからフレームを1つ読み出す
+     *
+     * MaxDLC を超えるデータ長のフレームは破棄して読み飛ばします。
+     *
+     * @param out_frame 受信フレームの格納先
+     * @return true 読み出し成功
+     * @return false FIFOが空
+     */
+    bool read_fifo(Frame& out_frame);
+
+    /**
+     * @brief 保持している受信フィルタをフィルタ要素へ書き込む (動作中も呼び出せる)
+     *
+     * @return true 設定成功
+     * @return false 設定失敗
+     */
+    bool apply_filters();
+
+    FDCAN_HandleTypeDef* hfdcan_;                                     // HALハンドル
+    std::array<AcceptanceFilter, MAX_ACCEPTANCE_FILTERS> filters_{};  // 設定する受信フィルタ
+    std::size_t filter_count_ = 0;                                    // 設定する受信フィルタ数
+    bool filtering_           = false;                                // 受信フィルタで絞るか (false: 全て受信)
+    bool initialized_         = false;                                // init() 済みか
+    SPSCRing<Frame, RX_RING_SIZE> rx_ring_;                           // 割り込みからメインループへの受信フレーム
+    SPSCRing<TxEvent, TX_EVENT_RING_SIZE> tx_events_;                 // 割り込みからメインループへの送信完了イベント
+    TimestampExtender timestamps_;                                    // タイムスタンプカウンタの拡張 (割り込みのみ更新)
+    std::atomic<uint32_t> rx_hw_overrun_count_{0};                    // ハードウェアFIFOオーバーランの検出回数 (割り込みのみ更新)
+    std::atomic<uint32_t> rx_oversize_count_{0};                      // データ長が MaxDLC を超えるため破棄したフレーム数 (割り込みのみ更新)
 };
+
+extern template class BasicDriverSTM32FDCAN<8>;
+extern template class BasicDriverSTM32FDCAN<64>;
+
+// クラシックCANのフレーム (最大8バイト) を扱う FDCAN ドライバ (CANBus 用)
+using DriverSTM32FDCAN = BasicDriverSTM32FDCAN<8>;
+
+// CAN FD のフレーム (最大64バイト) を扱う FDCAN ドライバ (FDCANBus 用)
+using DriverSTM32FDCANFD = BasicDriverSTM32FDCAN<64>;
+
 }  // namespace drivers
 }  // namespace gn10_can
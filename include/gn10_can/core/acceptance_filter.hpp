@@ -0,0 +1,64 @@
+/**
+ * @file acceptance_filter.hpp
+ * @author Gento Aiba (aiba-gento)
+ * @brief 接続デバイスからハードウェア受信フィルタを求める関数のヘッダーファイル
+ * @version 0.1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026 Gento Aiba
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "gn10_can/core/can_id.hpp"
+
+namespace gn10_can {
+
+/**
+ * @brief 標準IDの受信フィルタ (ID / マスク)
+ *
+ * マスクのビットが1の位置だけを比較し、(受信ID & mask) == (id & mask) のフレームを受け付けます。
+ */
+struct AcceptanceFilter {
+    uint32_t id   = 0;  // 比較するID (11bit)
+    uint32_t mask = 0;  // 比較するビット (11bit)
+
+    /**
+     * @brief 標準IDが一致するか判定する
+     *
+     * @param std_id 受信フレームの標準ID
+     * @return true 受け付ける
+     * @return false 受け付けない
+     */
+    bool matches(uint32_t std_id) const
+    {
+        return (std_id & mask) == (id & mask);
+    }
+};
+
+static constexpr std::size_t MAX_ACCEPTANCE_FILTERS = 32;  // バスが一度に設定する受信フィルタの最大数
+
+/**
+ * @brief 受け付けるIDの集合を覆う最小限の受信フィルタを求める
+ * @details
+ * ルーティングIDごとに受け付けるコマンドのビットマスクから、まずIDを過不足なく覆うフィルタを作り、
+ * 1bitだけ異なるフィルタを統合して数を減らします。それでも capacity を超える場合は、
+ * 統合後に受け付けるIDの数が最も少ない組から順に統合します (余分に受け付けたフレームはソフトウェアの
+ * ルーティングで破棄されます)。動的メモリは使用しません。
+ *
+ * @param command_masks ルーティングIDごとに受け付けるコマンドのビットマスク (0 は受け付けない)
+ * @param out_filters 求めたフィルタの格納先
+ * @param capacity 格納先の要素数 (ハードウェアのフィルタ数)
+ * @return std::size_t フィルタ数 (受け付けるIDがない場合、capacity が 0 の場合は 0)
+ */
+std::size_t plan_acceptance_filters(
+    const std::array<uint8_t, id::ROUTING_ID_COUNT>& command_masks,
+    AcceptanceFilter* out_filters,
+    std::size_t capacity
+);
+
+}  // namespace gn10_can
@@ -0,0 +1,325 @@
+/**
+ * @file bus_load.hpp
+ * @author Gento Aiba (aiba-gento)
+ * @brief フレームのビット長からバス負荷率を求めるクラスのヘッダーファイル
+ * @version 0.1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026 Gento Aiba
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "gn10_can/core/can_frame.hpp"
+
+namespace gn10_can {
+
+/**
+ * @brief スタッフビットの数え方
+ */
+enum class StuffMode : uint8_t {
+    WorstCase,  // 最悪値 (データによらない上限)
+    Actual,     // 実際のID・データから求めた値
+};
+
+/**
+ * @brief バスのビットレート
+ */
+struct BitRate {
+    uint32_t nominal = 1000000;  // アービトレーションフェーズのビットレート [bps]
+    uint32_t data    = 0;        // データフェーズのビットレート [bps] (0: ビットレートスイッチなし)
+    bool is_fd       = false;    // CAN FD のバスか (8バイトを超えるフレームを CAN FD フレームで数える)
+
+    /**
+     * @brief クラシックCANのビットレートを作成する
+     *
+     * @param bitrate ビットレート [bps]
+     * @return BitRate ビットレート
+     */
+    static constexpr BitRate classic(uint32_t bitrate)
+    {
+        return BitRate{bitrate, 0, false};
+    }
+
+    /**
+     * @brief CAN FDのビットレートを作成する
+     *
+     * @param nominal アービトレーションフェーズのビットレート [bps]
+     * @param data データフェーズのビットレート [bps] (0 または nominal と同じ場合はスイッチなし)
+     * @return BitRate ビットレート
+     */
+    static constexpr BitRate fd(uint32_t nominal, uint32_t data)
+    {
+        return BitRate{nominal, data, true};
+    }
+};
+
+/**
+ * @brief フレーム1つのバス上のビット数
+ */
+struct FrameBits {
+    uint32_t nominal = 0;  // アービトレーションフェーズのビットレートで送るビット数 (IFS込み)
+    uint32_t data    = 0;  // データフェーズのビットレートで送るビット数
+    uint32_t stuff   = 0;  // うちスタッフビット数
+
+    /**
+     * @brief 合計ビット数を取得する
+     *
+     * @return uint32_t 合計ビット数
+     */
+    uint32_t total() const
+    {
+        return nominal + data;
+    }
+};
+
+/**
+ * @brief クラシックCANフレームのビット数を求める
+ *
+ * SOF からフレーム間スペース (IFS) までを数えます。StuffMode::Actual の場合は CRC を計算し、
+ * SOF から CRC までの実際のビット列に挿入されるスタッフビットを数えます。
+ *
+ * @param frame フレーム (データ長は 8 以下)
+ * @param mode スタッフビットの数え方
+ * @return FrameBits ビット数 (全てアービトレーションフェーズ)
+ */
+FrameBits classic_frame_bits(const CANFrameView& frame, StuffMode mode);
+
+/**
+ * @brief CAN FDフレームのビット数を求める
+ *
+ * データ長は送信できる長さに切り上げ、不足分は fd::PADDING_BYTE で埋めたものとして数えます。
+ * CRC フィールドの固定スタッフビットとスタッフカウントも含みます。
+ *
+ * @param frame フレーム (データ長は 64 以下)
+ * @param bit_rate_switch データフェーズでビットレートを切り替えるか
+ * @param mode スタッフビットの数え方
+ * @return FrameBits ビット数
+ */
+FrameBits fd_frame_bits(const CANFrameView& frame, bool bit_rate_switch, StuffMode mode);
+
+/**
+ * @brief ビットレートとデータ長に応じたフレーム形式でビット数を求める
+ *
+ * ドライバの送信と同じく、CAN FD のバスでも8バイト以下のフレームはクラシックCANのフレームとして
+ * 数えます (fd::requires_fd_format())。
+ *
+ * @param frame フレーム
+ * @param rate バスのビットレート
+ * @param mode スタッフビットの数え方
+ * @return FrameBits ビット数
+ */
+FrameBits frame_bits(const CANFrameView& frame, const BitRate& rate, StuffMode mode);
+
+/**
+ * @brief フレームがバスを占有する時間を求める
+ *
+ * @param frame フレーム
+ * @param rate バスのビットレート
+ * @param mode スタッフビットの数え方
+ * @return uint32_t 占有時間 [ns] (切り上げ)
+ */
+uint32_t frame_time_ns(const CANFrameView& frame, const BitRate& rate, StuffMode mode);
+
+/**
+ * @brief バス負荷率の計測クラス
+ * @details
+ * 送受信したフレームの占有時間を一定幅の区間 (バケット) ごとに積算し、直近の区間の合計から負荷率を求めます。
+ * 区間は BucketCount 個のリングバッファで保持し、動的メモリは使用しません。
+ *
+ * 統計ポリシーとして CANBus のテンプレート引数に指定すると、バスが送受信したフレームを自動で記録します
+ * (InstrumentedCANBus<BusLoadMeter<>>)。受信フィルタで捨てられたフレームは数えられないため、
+ * 他ノードを含むバス全体の負荷を測る場合はフィルタを開けて使用してください。
+ *
+ * @tparam Clock 単調増加の時計 (std::chrono の Clock 要件)
+ * @tparam BucketCount 保持する区間の数 (最長の計測窓)
+ */
+template <typename Clock = std::chrono::steady_clock, std::size_t BucketCount = 10>
+class BusLoadMeter
+{
+public:
+    static_assert(BucketCount > 0, "BucketCount must be greater than 0");
+
+    static constexpr bool ENABLED = true;
+
+    using TimePoint = typename Clock::time_point;
+    using Duration  = typename Clock::duration;
+
+    static constexpr std::chrono::milliseconds DEFAULT_BUCKET_WIDTH{100};  // 既定の区間の幅
+
+    /**
+     * @brief ある時点のバス負荷率
+     */
+    struct Snapshot {
+        float last_load   = 0.0f;  // 直前の1区間の負荷率 (0.0 ~ 1.0)
+        float window_load = 0.0f;  // 直前の BucketCount 区間の負荷率
+        float peak_load   = 0.0f;  // 1区間の負荷率の最大値
+        uint32_t frames   = 0;     // 記録したフレーム数
+    };
+
+    /**
+     * @brief BusLoadMeterクラスのコンストラクタ
+     *
+     * @param rate バスのビットレート
+     * @param bucket_width 1区間の幅
+     * @param mode スタッフビットの数え方
+     */
+    explicit BusLoadMeter(
+        const BitRate& rate   = BitRate::classic(1000000),
+        Duration bucket_width = std::chrono::duration_cast<Duration>(DEFAULT_BUCKET_WIDTH),
+        StuffMode mode        = StuffMode::Actual
+    )
+        : rate_(rate), bucket_width_(bucket_width), mode_(mode)
+    {
+    }
+
+    /**
+     * @brief 現在時刻を取得する
+     *
+     * @return TimePoint 現在時刻
+     */
+    static TimePoint now()
+    {
+        return Clock::now();
+    }
+
+    /**
+     * @brief フレームを記録する
+     *
+     * @param frame バス上に送出された (または受信した) フレーム
+     * @param time 送受信時刻
+     */
+    void record(const CANFrameView& frame, TimePoint time)
+    {
+        advance(bucket_of(time));
+        buckets_[epoch_ % RING_SIZE] += frame_time_ns(frame, rate_, mode_);
+        frames_++;
+    }
+
+    /**
+     * @brief 直前の区間の負荷率を取得する
+     *
+     * 記録中の区間は含めず、完了した区間だけから求めます。
+     *
+     * @param time 現在時刻
+     * @param buckets 計測窓の区間数 (1 ~ BucketCount)
+     * @return float 負荷率 (0.0 ~ 1.0、過負荷時は 1.0 を超えることがあります)
+     */
+    float load(TimePoint time, std::size_t buckets = BucketCount) const
+    {
+        if (buckets == 0) {
+            return 0.0f;
+        }
+        if (buckets > BucketCount) {
+            buckets = BucketCount;
+        }
+
+        const uint64_t current = bucket_of(time);
+        uint64_t busy_ns       = 0;
+        for (std::size_t i = 1; i <= buckets && i <= current; i++) {
+            busy_ns += bucket_ns(current - i);
+        }
+        return static_cast<float>(busy_ns) / static_cast<float>(width_ns() * buckets);
+    }
+
+    /**
+     * @brief 1区間の負荷率の最大値を取得する
+     *
+     * @return float 負荷率の最大値
+     */
+    float peak_load() const
+    {
+        return static_cast<float>(peak_ns_) / static_cast<float>(width_ns());
+    }
+
+    // ---- 統計ポリシー (CANBus の Stats) としてのインターフェース ----
+
+    void record_rx(const CANFrameView& frame, bool, Duration)
+    {
+        record(frame, Clock::now());
+    }
+
+    void record_tx(const CANFrameView& frame)
+    {
+        record(frame, Clock::now());
+    }
+
+    void record_send_failure() {}
+
+    Snapshot snapshot(uint32_t) const
+    {
+        const TimePoint time = Clock::now();
+
+        Snapshot result;
+        result.last_load   = load(time, 1);
+        result.window_load = load(time);
+        result.peak_load   = peak_load();
+        result.frames      = frames_;
+        return result;
+    }
+
+private:
+    // 記録中の区間を含めて BucketCount 区間を参照できるよう1つ多く持つ
+    static constexpr std::size_t RING_SIZE = BucketCount + 1;
+
+    uint64_t width_ns() const
+    {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(bucket_width_).count()
+        );
+    }
+
+    uint64_t bucket_of(TimePoint time) const
+    {
+        return static_cast<uint64_t>(time.time_since_epoch() / bucket_width_);
+    }
+
+    uint64_t bucket_ns(uint64_t bucket) const
+    {
+        if (!started_ || bucket > epoch_ || epoch_ - bucket >= RING_SIZE) {
+            return 0;
+        }
+        return buckets_[bucket % RING_SIZE];
+    }
+
+    void advance(uint64_t bucket)
+    {
+        if (!started_) {
+            started_ = true;
+            epoch_   = bucket;
+            return;
+        }
+        if (bucket <= epoch_) {
+            return;
+        }
+
+        // 完了した区間の最大値を記録し、経過した区間を空にする
+        if (buckets_[epoch_ % RING_SIZE] > peak_ns_) {
+            peak_ns_ = buckets_[epoch_ % RING_SIZE];
+        }
+        uint64_t skipped = bucket - epoch_;
+        if (skipped > RING_SIZE) {
+            skipped = RING_SIZE;
+        }
+        for (uint64_t i = 1; i <= skipped; i++) {
+            buckets_[(bucket - skipped + i) % RING_SIZE] = 0;
+        }
+        epoch_ = bucket;
+    }
+
+    BitRate rate_;                               // バスのビットレート
+    Duration bucket_width_;                      // 1区間の幅
+    StuffMode mode_;                             // スタッフビットの数え方
+    std::array<uint64_t, RING_SIZE> buckets_{};  // 区間ごとのバス占有時間 [ns]
+    uint64_t epoch_   = 0;                       // 記録中の区間の番号
+    uint64_t peak_ns_ = 0;                       // 1区間のバス占有時間の最大値 [ns]
+    uint32_t frames_  = 0;                       // 記録したフレーム数
+    bool started_     = false;                   // 1つ以上記録したか
+};
+
+}  // namespace gn10_can
@@ -0,0 +1,243 @@
+/**
+ * @file bus_stats.hpp
+ * @author Gento Aiba (aiba-gento)
+ * @brief CANバスの統計情報を収集するポリシークラスのヘッダーファイル
+ * @version 0.1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026 Gento Aiba
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "gn10_can/core/can_frame.hpp"
+#include "gn10_can/core/can_id.hpp"
+#include "gn10_can/core/routing_table.hpp"
+
+// 統計情報を個別に記録するルーティングIDの最大数 (ビルド時に -DGN10_CAN_STATS_MAX_ROUTES=N で変更可能)
+#ifndef GN10_CAN_STATS_MAX_ROUTES
+#define GN10_CAN_STATS_MAX_ROUTES GN10_CAN_MAX_DEVICES
+#endif
+
+namespace gn10_can {
+
+/**
+ * @brief 統計情報を収集しないポリシー (既定値)
+ *
+ * 全ての記録関数が空のインライン関数のため、コンパイル後に処理は残りません。
+ */
+struct NoStats {
+    static constexpr bool ENABLED = false;
+
+    struct Snapshot {};
+
+    template <typename Frame>
+    void record_tx(const Frame&)
+    {
+    }
+
+    void record_send_failure() {}
+
+    Snapshot snapshot(uint32_t) const
+    {
+        return Snapshot{};
+    }
+};
+
+/**
+ * @brief ある時点の統計情報
+ *
+ * @tparam Duration 処理時間の型 (std::chrono::duration)
+ * @tparam MaxRoutes 個別に記録するルーティングIDの最大数
+ */
+template <typename Duration, std::size_t MaxRoutes>
+struct BusStatsSnapshot {
+    // コマンドごとの送受信数
+    struct CommandCounters {
+        uint32_t rx_frames = 0;  // 受信フレーム数
+        uint32_t rx_bytes  = 0;  // 受信データバイト数
+        uint32_t tx_frames = 0;  // 送信フレーム数
+        uint32_t tx_bytes  = 0;  // 送信データバイト数
+    };
+
+    // ルーティングID (デバイス) ごとの統計
+    struct RouteStats {
+        uint8_t routing_id = 0;                                   // ルーティングID
+        std::array<CommandCounters, id::COMMAND_COUNT> commands;  // コマンドごとの送受信数
+        Duration handler_max{0};                                  // 受信処理時間の最大値
+        Duration handler_total{0};                                // 受信処理時間の合計
+        uint32_t handler_calls = 0;                               // 受信処理の回数
+
+        /**
+         * @brief 受信処理時間の平均値を取得する
+         *
+         * @return Duration 平均値 (未受信の場合は 0)
+         */
+        Duration handler_mean() const
+        {
+            if (handler_calls == 0) {
+                return Duration{0};
+            }
+            return handler_total / handler_calls;
+        }
+    };
+
+    uint32_t rx_frames       = 0;  // 受信フレーム数
+    uint32_t rx_bytes        = 0;  // 受信データバイト数
+    uint32_t tx_frames       = 0;  // 送信フレーム数
+    uint32_t tx_bytes        = 0;  // 送信データバイト数
+    uint32_t unrouted_frames = 0;  // 配送先デバイスのない受信フレーム数
+    uint32_t send_failures   = 0;  // 送信失敗数 (送信キュー満杯、最大データ長超過)
+    uint32_t rx_overruns     = 0;  // 受信オーバーラン数 (ドライバが把握できる範囲)
+    uint32_t untracked       = 0;  // 記録枠が足りず個別に記録できなかったフレーム数
+
+    std::array<RouteStats, MaxRoutes> routes{};  // ルーティングIDごとの統計 (先頭から route_count 個)
+    std::size_t route_count = 0;                 // 記録しているルーティングIDの数
+};
+
+/**
+ * @brief 統計情報を収集するポリシー
+ * @details
+ * CANBus のテンプレート引数に指定すると、送受信数・バイト数 (ルーティングID × コマンドごと)、
+ * 配送先のない受信フレーム数、送信失敗数、受信オーバーラン数、受信処理時間の最大値・平均値を
+ * 記録します。
+ * ルーティングIDごとの記録枠は初めて送受信したときに割り当て、動的メモリは使用しません。
+ *
+ * @tparam Clock 受信処理時間の計測に使用する単調増加の時計 (std::chrono の Clock 要件)
+ * @tparam MaxRoutes 個別に記録するルーティングIDの最大数
+ */
+template <typename Clock = std::chrono::steady_clock,
+          std::size_t MaxRoutes = GN10_CAN_STATS_MAX_ROUTES>
+class BusStats
+{
+public:
+    static_assert(MaxRoutes > 0 && MaxRoutes < 0xFF, "MaxRoutes must be between 1 and 254");
+
+    static constexpr bool ENABLED = true;
+
+    using TimePoint = typename Clock::time_point;
+    using Duration  = typename Clock::duration;
+    using Snapshot  = BusStatsSnapshot<Duration, MaxRoutes>;
+
+    BusStats()
+    {
+        slots_.fill(NO_SLOT);
+    }
+
+    /**
+     * @brief 現在時刻を取得する
+     *
+     * @return TimePoint 現在時刻
+     */
+    static TimePoint now()
+    {
+        return Clock::now();
+    }
+
+    /**
+     * @brief 受信フレームを記録する
+     *
+     * @param frame 受信フレーム
+     * @param routed 配送先のデバイスがあったか
+     * @param elapsed 配送 (受信処理) にかかった時間
+     */
+    void record_rx(const CANFrameView& frame, bool routed, Duration elapsed)
+    {
+        data_.rx_frames++;
+        data_.rx_bytes += frame.dlc;
+        if (!routed) {
+            data_.unrouted_frames++;
+            return;
+        }
+
+        auto* route = find_or_add(frame.get_routing_id());
+        if (route == nullptr) {
+            data_.untracked++;
+            return;
+        }
+        auto& counters = route->commands[frame.get_command()];
+        counters.rx_frames++;
+        counters.rx_bytes += frame.dlc;
+
+        route->handler_total += elapsed;
+        route->handler_calls++;
+        if (elapsed > route->handler_max) {
+            route->handler_max = elapsed;
+        }
+    }
+
+    /**
+     * @brief 送信フレーム (ドライバが受け付けたフレーム) を記録する
+     *
+     * @param frame 送信フレーム
+     */
+    void record_tx(const CANFrameView& frame)
+    {
+        data_.tx_frames++;
+        data_.tx_bytes += frame.dlc;
+
+        auto* route = find_or_add(frame.get_routing_id());
+        if (route == nullptr) {
+            data_.untracked++;
+            return;
+        }
+        auto& counters = route->commands[frame.get_command()];
+        counters.tx_frames++;
+        counters.tx_bytes += frame.dlc;
+    }
+
+    /**
+     * @brief 送信失敗を記録する
+     */
+    void record_send_failure()
+    {
+        data_.send_failures++;
+    }
+
+    /**
+     * @brief 統計情報のスナップショットを取得する
+     *
+     * @param rx_overruns ドライバから取得した受信オーバーラン数
+     * @return Snapshot 統計情報のコピー
+     */
+    Snapshot snapshot(uint32_t rx_overruns) const
+    {
+        Snapshot copy    = data_;
+        copy.rx_overruns = rx_overruns;
+        return copy;
+    }
+
+private:
+    static constexpr uint8_t NO_SLOT = 0xFF;
+    static constexpr std::size_t ROUTING_ID_COUNT =
+        std::size_t{1} << (id::BIT_WIDTH_DEV_TYPE + id::BIT_WIDTH_DEV_ID);
+
+    typename Snapshot::RouteStats* find_or_add(uint32_t routing_id)
+    {
+        if (routing_id >= slots_.size()) {
+            return nullptr;
+        }
+
+        uint8_t slot = slots_[routing_id];
+        if (slot == NO_SLOT) {
+            if (data_.route_count >= MaxRoutes) {
+                return nullptr;
+            }
+            slot                          = static_cast<uint8_t>(data_.route_count);
+            slots_[routing_id]            = slot;
+            data_.routes[slot].routing_id = static_cast<uint8_t>(routing_id);
+            data_.route_count++;
+        }
+        return &data_.routes[slot];
+    }
+
+    std::array<uint8_t, ROUTING_ID_COUNT> slots_;  // ルーティングIDごとの記録枠の番号
+    Snapshot data_;                                // 記録中の統計情報
+};
+
+}  // namespace gn10_can
@@ -12,8 +12,18 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
 
+#include "gn10_can/core/acceptance_filter.hpp"
+#include "gn10_can/core/bus_stats.hpp"
+#include "gn10_can/core/can_frame.hpp"
+#include "gn10_can/core/routing_table.hpp"
+#include "gn10_can/core/tx_queue.hpp"
 #include "gn10_can/drivers/can_driver_interface.hpp"
 
 namespace gn10_can {
@@ -21,41 +31,92 @@ namespace gn10_can {
 class CANDevice;
 
 /**
- * @brief
- * 物理的なCANバスをソフトウェア上で表現したクラス。デバイスの接続(Attach)と、メッセージのルーティング(Dispatch)を担当します。
- *
+ * @brief 受信処理 (CANBus::update) の結果
+ */
+struct UpdateResult {
+    std::size_t processed = 0;  // 配送したフレーム数
+    std::size_t pending   = 0;  // 次回に持ち越した受信待ちフレーム数 (ドライバが把握できる範囲)
+};
+
+/**
+ * @brief データ長に依存しないCANバスの共通部分
+ * @details
+ * デバイスの接続(Attach)とルーティング(Dispatch)を担当します。
+ * デバイスはこのクラスを通してバスを参照するため、CAN / CAN FD どちらのバスにも接続できます。
  */
-class CANBus
+class CANBusBase
 {
 public:
-    static constexpr std::size_t MAX_DEVICES = 16;  // 最大登録デバイス数
+    static constexpr std::size_t MAX_DEVICES = GN10_CAN_MAX_DEVICES;  // 最大登録デバイス数
+
+    virtual ~CANBusBase() = default;
 
     /**
-     * @brief CANBusクラスのコンストラクタ
+     * @brief CANフレーム送信関数
      *
-     * @param driver CANドライバーインターフェースの参照
+     * バスの最大データ長を超えるフレームは送信しません。
+     *
+     * @param frame 送信するCANフレームの参照
+     * @return true 送信成功
+     * @return false 送信失敗
      */
-    explicit CANBus(drivers::ICANDriver& driver);
+    virtual bool send_frame(const CANFrameView& frame) = 0;
 
     /**
-     * @brief CANパケットの受信とデバイスへのルーティング処理
+     * @brief 複数のCANフレームをまとめて送信する関数
      *
-     * 受信データを読み込み、適切なデバイスに渡します。
+     * ドライバが一括送信に対応していれば、1回の呼び出しで送信します。
+     *
+     * @param frames 送信するCANフレームの参照の配列
+     * @param count 送信するフレーム数
+     * @return std::size_t 送信できたフレーム数
      */
-    void update();
+    virtual std::size_t send_frames(const CANFrameView* frames, std::size_t count) = 0;
 
     /**
-     * @brief CANフレーム送信関数
+     * @brief 最新値だけを送信するCANフレーム送信関数
      *
-     * @param frame 送信するCANフレーム
-     * @return true 送信成功
+     * 同じCAN IDのフレームが送信待ちであれば、追加せずに新しいフレームで置き換えます。
+     * 目標値など、古い値を送る意味のない指令に使用します。
+     *
+     * @param frame 送信するCANフレームの参照
+     * @return true 送信成功、または送信キューに保持
      * @return false 送信失敗
      */
-    bool send_frame(const CANFrame& frame);
+    virtual bool send_frame_latest(const CANFrameView& frame) = 0;
+
+protected:
+    /**
+     * @brief 受信したフレームを適切なデバイスに配送する
+     *
+     * @param frame 受信フレーム
+     * @return true 1つ以上のデバイスに配送した
+     * @return false 配送先のデバイスがない
+     */
+    bool dispatch(const CANFrameView& frame);
+
+    /**
+     * @brief 接続デバイスが受け付けるフレームだけを通す受信フィルタを求める
+     *
+     * ルーティングIDと受け付けるコマンドから、plan_acceptance_filters() でフィルタを求めます。
+     *
+     * @param out_filters 求めたフィルタの格納先
+     * @param capacity 格納先の要素数
+     * @return std::size_t フィルタ数 (受け付けるフレームがない場合は 0)
+     */
+    std::size_t plan_filters(AcceptanceFilter* out_filters, std::size_t capacity) const;
 
 private:
     friend class CANDevice;
 
+    /**
+     * @brief 接続デバイスまたは受け付けるコマンドが変わったときの処理
+     *
+     * 派生クラスはハードウェア受信フィルタの再設定に使用します。
+     * subscribe() のたびに呼び出されるため、重い処理は次の update() まで遅らせてください。
+     */
+    virtual void on_routes_changed() {}
+
     /**
      * @brief デバイスをバスに接続する (RAII内部利用)
      *
@@ -76,15 +137,530 @@ private:
      */
     void detach(CANDevice* device);
 
+    detail::RoutingTable<CANDevice, MAX_DEVICES> routes_;  // ルーティングIDをキーとしたデバイス索引
+};
+
+namespace detail {
+
+/**
+ * @brief
+ * 物理的なCANバスをソフトウェア上で表現したクラス。デバイスの接続(Attach)と、メッセージのルーティング(Dispatch)を担当します。
+ * @details
+ * ドライバの送信メールボックスが埋まっている場合、フレームは送信キューに保持され、
+ * CAN IDの優先順位 (バス調停と同じ順序) で送信されます。
+ * 送信キューの操作は Lock で排他制御するため、割り込みから送信・送信完了処理を呼び出す場合は
+ * 割り込み禁止を行う Lock を指定してください。
+ * Stats に BusStats を指定すると送受信の統計情報を記録します。既定の NoStats では記録処理は
+ * コンパイル時に取り除かれます。
+ *
+ * @tparam MaxDLC 扱うフレームの最大データ長 (CAN: 8, CAN FD: 64)
+ * @tparam Lock 送信キューの排他制御に使用するロック (lock() / unlock() を持つ型)
+ * @tparam Stats 統計情報の収集ポリシー (NoStats / BusStats)
+ */
+template <std::size_t MaxDLC, typename Lock = NullLock, typename Stats = NoStats>
+class CANBus : public CANBusBase
+{
+public:
+    using Frame  = CANFrame<MaxDLC>;
+    using Driver = ICANDriver<MaxDLC>;
+
+    static constexpr std::size_t RX_BATCH_SIZE = 8;  // 1回のドライバ呼び出しで受信する最大フレーム数
+    static constexpr std::size_t TX_BATCH_SIZE = 8;  // 1回のドライバ呼び出しで送信する最大フレーム数
+    static constexpr std::size_t TX_QUEUE_SIZE = GN10_CAN_TX_QUEUE_SIZE;  // 送信キューの容量
+
     /**
-     * @brief 受信したフレームを適切なデバイスに配送する
+     * @brief CANBusクラスのコンストラクタ
+     *
+     * @param driver CANドライバーインターフェースの参照
+     */
+    explicit CANBus(Driver& driver) : driver_(driver) {}
+
+    /**
+     * @brief 統計ポリシーの初期値を指定するコンストラクタ
+     *
+     * BusLoadMeter のビットレートなど、設定を持つ統計ポリシーに使用します。
+     *
+     * @param driver CANドライバーインターフェースの参照
+     * @param stats 統計ポリシーの初期値
+     */
+    CANBus(Driver& driver, const Stats& stats) : driver_(driver), stats_(stats) {}
+
+    /**
+     * @brief CANパケットの受信とデバイスへのルーティング処理
+     *
+     * 受信データを読み込み、適切なデバイスに渡します。
+     * 送信キューに残っているフレームの送信も試みます。
+     */
+    void update()
+    {
+        process([]() { return false; }, std::numeric_limits<std::size_t>::max());
+    }
+
+    /**
+     * @brief 処理するフレーム数に上限を設けた受信処理
+     *
+     * 上限に達した時点で処理を打ち切り、残りは次回の update() に持ち越します。
+     * 受信が集中しても制御ループの処理時間を一定に保てます。
+     *
+     * @param max_frames 配送する最大フレーム数
+     * @return UpdateResult 配送したフレーム数と持ち越したフレーム数
+     */
+    UpdateResult update(std::size_t max_frames)
+    {
+        return process([]() { return false; }, max_frames);
+    }
+
+    /**
+     * @brief 期限を設けた受信処理
+     *
+     * 1フレーム配送するごとに Clock::now() を確認し、期限を過ぎたら打ち切って残りを次回に持ち越します。
+     * Clock は std::chrono の Clock 要件 (time_point と now()) を満たす単調増加の時計です。
+     * マイコンではシステムティックやサイクルカウンタを返す Clock を定義して使用します。
+     *
+     * @tparam Clock 単調増加の時計
+     * @tparam Duration 時刻の分解能
+     * @param deadline 処理を打ち切る時刻
+     * @param max_frames 配送する最大フレーム数
+     * @return UpdateResult 配送したフレーム数と持ち越したフレーム数
+     */
+    template <typename Clock, typename Duration>
+    UpdateResult update(
+        std::chrono::time_point<Clock, Duration> deadline,
+        std::size_t max_frames = std::numeric_limits<std::size_t>::max()
+    )
+    {
+        return process([deadline]() { return Clock::now() >= deadline; }, max_frames);
+    }
+
+    /**
+     * @brief 送信完了時の処理
+     *
+     * 送信キューのフレームを優先度順に、ドライバが受け付ける限り送信します。
+     * 送信完了割り込み (メールボックスの空き) から呼び出してください。
+     */
+    void on_tx_complete()
+    {
+        std::lock_guard<Lock> guard(lock_);
+        flush_tx_queue();
+    }
+
+    /**
+     * @brief 送信完了イベントを1つ取り出す
+     *
+     * フレームが実際にバスへ送出された時刻を取得し、バス遅延やジッタの測定に使用します。
+     *
+     * @param out_event 送信完了イベントの格納先
+     * @return true 取り出し成功
+     * @return false イベントなし（ドライバが未対応の場合を含む）
+     */
+    bool receive_tx_event(TxEvent& out_event)
+    {
+        return driver_.receive_tx_event(out_event);
+    }
+
+    /**
+     * @brief CANフレーム送信関数
+     *
+     * ドライバが送信できない場合 (メールボックスが満杯など) は送信キューに保持します。
+     *
+     * @param frame 送信するCANフレーム
+     * @return true 送信成功、または送信キューに保持
+     * @return false 送信失敗（送信キューが満杯）
+     */
+    bool send_frame(const Frame& frame)
+    {
+        std::lock_guard<Lock> guard(lock_);
+        return send_batch(&frame, 1) == 1;
+    }
+
+    /**
+     * @brief CANフレーム送信関数（参照版）
+     *
+     * @param frame 送信するCANフレームの参照
+     * @return true 送信成功、または送信キューに保持
+     * @return false 送信失敗（最大データ長超過、送信キューが満杯など）
+     */
+    bool send_frame(const CANFrameView& frame) override
+    {
+        if (frame.dlc > MaxDLC) {
+            record_oversized();
+            return false;
+        }
+        return send_frame(Frame(frame));
+    }
+
+    /**
+     * @brief 複数のCANフレームをまとめて送信する関数
+     *
+     * @param frames 送信するCANフレームの配列
+     * @param count 送信するフレーム数
+     * @return std::size_t 送信または送信キューに保持できたフレーム数
+     */
+    std::size_t send_frames(const Frame* frames, std::size_t count)
+    {
+        std::lock_guard<Lock> guard(lock_);
+        return send_batch(frames, count);
+    }
+
+    /**
+     * @brief 複数のCANフレームをまとめて送信する関数（参照版）
+     *
+     * TX_BATCH_SIZE ずつバスのフレーム型にコピーしてドライバに渡します。
+     *
+     * @param frames 送信するCANフレームの参照の配列
+     * @param count 送信するフレーム数
+     * @return std::size_t 送信または送信キューに保持できたフレーム数（最大データ長を超えるフレームの手前まで）
+     */
+    std::size_t send_frames(const CANFrameView* frames, std::size_t count) override
+    {
+        std::lock_guard<Lock> guard(lock_);
+
+        std::array<Frame, TX_BATCH_SIZE> batch;
+        std::size_t sent = 0;
+        while (sent < count) {
+            // バッチに詰める (最大データ長を超えるフレームで打ち切る)
+            std::size_t batch_count = 0;
+            while (batch_count < batch.size() && sent + batch_count < count &&
+                   frames[sent + batch_count].dlc <= MaxDLC) {
+                batch[batch_count] = Frame(frames[sent + batch_count]);
+                batch_count++;
+            }
+            if (batch_count == 0) {
+                stats_.record_send_failure();
+                return sent;
+            }
+
+            std::size_t batch_sent = send_batch(batch.data(), batch_count);
+            sent += batch_sent;
+            if (batch_sent < batch_count) {
+                return sent;
+            }
+        }
+        return sent;
+    }
+
+    /**
+     * @brief 最新値だけを送信するCANフレーム送信関数（参照版）
+     *
+     * 同じCAN IDのフレームが送信キューにあれば、その位置のまま新しいフレームで置き換えます。
+     * 過負荷時でも古い目標値が新しい目標値の後に送信されることはなく、
+     * 送信キューの保持数は呼び出し回数ではなくCAN IDの数で頭打ちになります。
+     *
+     * @param frame 送信するCANフレームの参照
+     * @return true 送信成功、または送信キューに保持
+     * @return false 送信失敗（最大データ長超過、送信キューが満杯など）
+     */
+    bool send_frame_latest(const CANFrameView& frame) override
+    {
+        if (frame.dlc > MaxDLC) {
+            record_oversized();
+            return false;
+        }
+        const Frame latest(frame);
+
+        std::lock_guard<Lock> guard(lock_);
+        bool queued = !tx_queue_.empty();
+        if (!queued && driver_.send(latest)) {
+            stats_.record_tx(latest);
+            return true;
+        }
+
+        if (tx_queue_.replace(latest)) {
+            tx_coalesced_count_++;
+        } else if (!tx_queue_.push(latest)) {
+            tx_dropped_count_++;
+            stats_.record_send_failure();
+            return false;
+        }
+
+        if (queued) {
+            flush_tx_queue();
+        }
+        return true;
+    }
+
+    /**
+     * @brief 送信キューに保持されているフレーム数を取得する
+     *
+     * @return std::size_t フレーム数
+     */
+    std::size_t tx_queue_size() const
+    {
+        std::lock_guard<Lock> guard(lock_);
+        return tx_queue_.size();
+    }
+
+    /**
+     * @brief 送信キューに同時に保持されたフレーム数の最大値を取得する
+     *
+     * TX_QUEUE_SIZE の見積もりに使用します。
+     *
+     * @return std::size_t 最大保持数の記録
+     */
+    std::size_t tx_queue_high_water_mark() const
+    {
+        std::lock_guard<Lock> guard(lock_);
+        return tx_queue_.high_water_mark();
+    }
+
+    /**
+     * @brief 送信キューが満杯で破棄したフレーム数を取得する
+     *
+     * @return uint32_t 破棄したフレーム数
+     */
+    uint32_t tx_dropped_count() const
+    {
+        std::lock_guard<Lock> guard(lock_);
+        return tx_dropped_count_;
+    }
+
+    /**
+     * @brief 送信待ちのフレームを新しいフレームで置き換えた回数を取得する
+     *
+     * @return uint32_t 置き換えた回数
+     */
+    uint32_t tx_coalesced_count() const
+    {
+        std::lock_guard<Lock> guard(lock_);
+        return tx_coalesced_count_;
+    }
+
+    /**
+     * @brief 統計情報のスナップショットを取得する
+     *
+     * Stats が NoStats の場合は空の構造体を返します。
+     * 受信オーバーラン数はドライバ (ICANDriver::rx_overrun_count) から取得します。
+     *
+     * @return Stats::Snapshot 統計情報のコピー
+     */
+    typename Stats::Snapshot stats() const
+    {
+        const uint32_t rx_overruns = driver_.rx_overrun_count();
+
+        std::lock_guard<Lock> guard(lock_);
+        return stats_.snapshot(rx_overruns);
+    }
+
+    /**
+     * @brief ハードウェア受信フィルタを使用するか設定する
+     *
+     * 有効な場合 (既定)、ドライバが受信フィルタに対応していれば、接続デバイスが受け付けるフレームだけを
+     * 受信するようデバイスの接続・切断の後の最初の update() で設定し直します。
+     * 他ノード宛てのフレームも受信したい場合 (バス負荷の計測など) は無効にしてください。
+     *
+     * @param enabled true: 接続デバイスに合わせて絞る、false: 全てのフレームを受信する
+     */
+    void set_hardware_filter_enabled(bool enabled)
+    {
+        filter_enabled_ = enabled;
+        filters_dirty_.store(false, std::memory_order_relaxed);
+        apply_filters();
+    }
+
+    /**
+     * @brief ドライバに設定したハードウェア受信フィルタの数を取得する
+     *
+     * @return std::size_t フィルタ数 (フィルタを使用していない場合は 0)
+     */
+    std::size_t hardware_filter_count() const
+    {
+        return filter_count_;
+    }
+
+private:
+    void on_routes_changed() override
+    {
+        // デバイスのコンストラクタでは subscribe() が続くため、設定し直すのは次の update() で1回だけ
+        filters_dirty_.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief 接続デバイスが変わっていればハードウェア受信フィルタを設定し直す
+     */
+    void apply_pending_filters()
+    {
+        if (!filters_dirty_.load(std::memory_order_acquire)) {
+            return;
+        }
+        // 設定中の変更は次回に持ち越す (先に下ろしてから最新の接続デバイスで設定する)
+        filters_dirty_.store(false, std::memory_order_relaxed);
+        apply_filters();
+    }
+
+    /**
+     * @brief 接続デバイスに合わせてハードウェア受信フィルタを設定する
+     *
+     * ドライバのフィルタ数が足りない場合は、余分なIDも受け付けるフィルタに統合されます
+     * (余分なフレームはルーティングで破棄されます)。
+     */
+    void apply_filters()
+    {
+        std::size_t capacity = driver_.filter_capacity();
+        if (capacity == 0) {
+            return;
+        }
+        if (capacity > MAX_ACCEPTANCE_FILTERS) {
+            capacity = MAX_ACCEPTANCE_FILTERS;
+        }
+
+        if (!filter_enabled_) {
+            driver_.clear_filters();
+            filter_count_ = 0;
+            return;
+        }
+
+        std::array<AcceptanceFilter, MAX_ACCEPTANCE_FILTERS> filters;
+        const std::size_t count = plan_filters(filters.data(), capacity);
+        if (driver_.set_filters(filters.data(), count)) {
+            filter_count_ = count;
+        }
+    }
+
+    /**
+     * @brief 受信フレームを上限・期限の範囲で配送する
+     *
+     * ドライバからまとめて受信したフレームは rx_batch_ に保持し、
+     * 打ち切られた場合は次回の呼び出しで続きから配送します。
+     *
+     * @tparam Expired bool() の形で呼び出せる期限判定関数
+     * @param expired 期限を過ぎたら true を返す関数
+     * @param max_frames 配送する最大フレーム数
+     * @return UpdateResult 配送したフレーム数と持ち越したフレーム数
+     */
+    template <typename Expired>
+    UpdateResult process(Expired&& expired, std::size_t max_frames)
+    {
+        apply_pending_filters();
+        on_tx_complete();
+
+        UpdateResult result;
+        bool drained = false;
+        while (result.processed < max_frames && !expired()) {
+            if (rx_batch_pos_ == rx_batch_count_) {
+                // 前回の受信が要求数に満たなければ受信データは尽きている
+                if (drained) {
+                    break;
+                }
+                rx_batch_pos_   = 0;
+                rx_batch_count_ = driver_.receive_many(rx_batch_.data(), rx_batch_.size());
+                drained         = rx_batch_count_ < rx_batch_.size();
+                if (rx_batch_count_ == 0) {
+                    break;
+                }
+            }
+            deliver(rx_batch_[rx_batch_pos_]);
+            rx_batch_pos_++;
+            result.processed++;
+        }
+
+        result.pending = (rx_batch_count_ - rx_batch_pos_) + driver_.receive_pending();
+        return result;
+    }
+
+    /**
+     * @brief 受信フレームをデバイスへ配送する
+     *
+     * 統計情報を記録する場合は配送 (デバイスの受信処理) にかかった時間も計測します。
+     * デバイスの受信処理中はロックを保持しません。
      *
      * @param frame 受信フレーム
      */
-    void dispatch(const CANFrame& frame);
+    void deliver(const Frame& frame)
+    {
+        if constexpr (Stats::ENABLED) {
+            const CANFrameView view(frame);
+            const auto started = Stats::now();
+            const bool routed  = dispatch(view);
+            const auto elapsed = Stats::now() - started;
+
+            std::lock_guard<Lock> guard(lock_);
+            stats_.record_rx(view, routed, elapsed);
+        } else {
+            dispatch(frame);
+        }
+    }
+
+    /**
+     * @brief 最大データ長を超えて送信できなかったフレームを記録する
+     */
+    void record_oversized()
+    {
+        if constexpr (Stats::ENABLED) {
+            std::lock_guard<Lock> guard(lock_);
+            stats_.record_send_failure();
+        }
+    }
 
-    drivers::ICANDriver& driver_;                    // CANドライバーインターフェースの参照を保持
-    std::array<CANDevice*, MAX_DEVICES> devices_{};  // 登録されているデバイスの配列
-    std::size_t device_count_ = 0;                   // 登録されているデバイス数
+    /**
+     * @brief フレームを送信し、送信できなかった分を送信キューに保持する (ロック取得済みで呼び出す)
+     *
+     * 送信キューが空であればドライバへ直接渡し、そうでなければ優先度順を守るため送信キューを経由します。
+     *
+     * @param frames 送信するフレームの配列
+     * @param count 送信するフレーム数
+     * @return std::size_t 送信または送信キューに保持できたフレーム数
+     */
+    std::size_t send_batch(const Frame* frames, std::size_t count)
+    {
+        std::size_t done = 0;
+        bool queued      = !tx_queue_.empty();
+        if (!queued) {
+            done = driver_.send_many(frames, count);
+            for (std::size_t i = 0; i < done; i++) {
+                stats_.record_tx(frames[i]);
+            }
+        }
+
+        while (done < count) {
+            if (!tx_queue_.push(frames[done])) {
+                tx_dropped_count_++;
+                stats_.record_send_failure();
+                break;
+            }
+            done++;
+        }
+
+        // 先に保持されていたフレームがあれば、空いたメールボックスへ優先度順に送り出す
+        if (queued) {
+            flush_tx_queue();
+        }
+        return done;
+    }
+
+    /**
+     * @brief 送信キューのフレームを優先度順に送信する (ロック取得済みで呼び出す)
+     */
+    void flush_tx_queue()
+    {
+        while (!tx_queue_.empty() && driver_.send(tx_queue_.top())) {
+            stats_.record_tx(tx_queue_.top());
+            tx_queue_.pop();
+        }
+    }
+
+    Driver& driver_;                             // CANドライバーインターフェースの参照を保持
+    std::array<Frame, RX_BATCH_SIZE> rx_batch_;  // ドライバからまとめて受信したフレーム
+    std::size_t rx_batch_pos_   = 0;             // rx_batch_ の次に配送する位置
+    std::size_t rx_batch_count_ = 0;             // rx_batch_ に受信したフレーム数
+    TxQueue<Frame, TX_QUEUE_SIZE> tx_queue_;     // 送信待ちフレーム (CAN IDの優先順位順)
+    uint32_t tx_dropped_count_   = 0;            // 送信キューが満杯で破棄したフレーム数
+    uint32_t tx_coalesced_count_ = 0;            // 送信待ちのフレームを置き換えた回数
+    Stats stats_;                                // 統計情報 (送信キューと同じロックで保護)
+    mutable Lock lock_;                          // 送信キューと統計情報の排他制御
+    std::size_t filter_count_ = 0;               // ドライバに設定した受信フィルタ数
+    bool filter_enabled_      = true;            // ハードウェア受信フィルタを使用するか
+    std::atomic<bool> filters_dirty_{false};     // 受信フィルタの再設定が必要か
 };
+}  // namespace detail
+
+using CANBus = detail::CANBus<8>;
+
+// 割り込み・スレッドから送信する場合に排他制御を指定するCANバス
+template <typename Lock>
+using LockedCANBus = detail::CANBus<8, Lock>;
+
+// 統計情報を記録するCANバス
+template <typename Stats, typename Lock = NullLock>
+using InstrumentedCANBus = detail::CANBus<8, Lock, Stats>;
+
 }  // namespace gn10_can
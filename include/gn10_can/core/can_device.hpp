@@ -12,10 +12,12 @@
 
 #include <array>
 #include <cstdint>
+#include <type_traits>
 
 #include "gn10_can/core/can_bus.hpp"
 #include "gn10_can/core/can_frame.hpp"
 #include "gn10_can/core/can_id.hpp"
+#include "gn10_can/core/seqlock.hpp"
 
 namespace gn10_can {
 
@@ -31,12 +33,12 @@ public:
      * @brief デバイス抽象化クラスのコンストラクタ
      *
      * @param bus
-     * CANパケットを送信する為にCANBusクラスのインスタンスポインタを渡す
+     * CANパケットを送信する為にCANBus / FDCANBusクラスのインスタンスを渡す
      * @param device_type デバイスの種類
      * @param device_id
      * デバイスのID（同じデバイスの種類のデバイスが複数あることを配慮して、0,1,2,..）
      */
-    CANDevice(CANBus& bus, id::DeviceType device_type, uint8_t device_id)
+    CANDevice(CANBusBase& bus, id::DeviceType device_type, uint8_t device_id)
         : bus_(bus), device_type_(device_type), device_id_(device_id)
     {
         bus_.attach(this);
@@ -53,12 +55,66 @@ public:
     CANDevice(CANDevice&&)                 = delete;
     CANDevice& operator=(CANDevice&&)      = delete;
 
+    static constexpr uint8_t ALL_COMMANDS = 0xFF;  // 全コマンドを受け付けるコマンドマスク
+
     /**
      * @brief CANパケット受信時の呼び出し関数
      *
+     * subscribe() でハンドラを登録していないデバイスは、全てのコマンドをこの関数で受け取ります。
+     *
+     * @param frame 受信したCANパケット
+     */
+    virtual void on_receive(const CANFrameView&) {}
+
+    /**
+     * @brief コマンドを受け付けるか判定する (CANBus内部利用)
+     *
+     * @param command コマンド (0 ~ id::COMMAND_COUNT - 1)
+     * @return true 受け付ける
+     * @return false 受け付けない（CANBusは呼び出しを行わない）
+     */
+    bool accepts(uint8_t command) const
+    {
+        return (command_mask_ >> command) & 0x01;
+    }
+
+    /**
+     * @brief コマンドに対応するハンドラへ受信フレームを配送する (CANBus内部利用)
+     *
+     * ハンドラが登録されていないコマンドは on_receive() に渡します。
+     *
+     * @param command コマンド (0 ~ id::COMMAND_COUNT - 1)
      * @param frame 受信したCANパケット
      */
-    virtual void on_receive(const CANFrame& frame) = 0;
+    void handle(uint8_t command, const CANFrameView& frame)
+    {
+        rx_timestamps_[command].write(frame.timestamp);
+
+        Handler handler = handlers_[command];
+        if (handler != nullptr) {
+            (this->*handler)(frame);
+        } else {
+            on_receive(frame);
+        }
+    }
+
+    /**
+     * @brief コマンドのフレームを最後に受信した時刻を取得する
+     *
+     * デコードした値がいつ受信されたものかを知るために使用します。
+     * 単位はドライバ定義です (ドライバが時刻に対応していない場合や未受信の場合は 0)。
+     * 受信処理と別のスレッド (ThreadedCANBus の制御スレッドなど) からも呼び出せます。
+     *
+     * @tparam CmdEnum コマンドのEnum Class
+     * @param command コマンド
+     * @return uint64_t 受信時刻
+     */
+    template <typename CmdEnum>
+    uint64_t rx_timestamp(CmdEnum command) const
+    {
+        static_assert(std::is_enum<CmdEnum>::value, "Command must be an Enum class");
+        return rx_timestamps_[static_cast<uint8_t>(command) & (id::COMMAND_COUNT - 1)].read();
+    }
 
     /**
      * @brief ルーティングIDを取得
@@ -82,14 +138,19 @@ protected:
      * @param command
      * コマンド（データの種類を示す、CAN通信時のデータは指令として見れるためコマンドとして見なす）
      * @param data 送信データ
-     * @param len 送信データ長（MAX:8）
+     * @param len 送信データ長（MAX: CANは8、CAN FDは64）
      * @return true 送信成功（CANDriverの継承後クラスによって定義）
-     * @return false 送信失敗（CANDriverの継承後クラスによって定義）
+     * @return false 送信失敗（CANDriverの継承後クラスによって定義、バスの最大データ長超過）
      */
     template <typename CmdEnum>
     bool send(CmdEnum command, const uint8_t* data = nullptr, std::size_t len = 0)
     {
-        auto frame = CANFrame::make(device_type_, device_id_, command, data, len);
+        if (len > CANFrameView::MAX_DLC) {
+            return false;
+        }
+        CANFrameView frame(
+            id::pack(device_type_, device_id_, command), data, static_cast<uint8_t>(len)
+        );
         return bus_.send_frame(frame);
     }
 
@@ -97,10 +158,10 @@ protected:
      * @brief コマンド・データ(array)からCANフレームを作成しCANManagerを使用して送信
      *
      * @tparam CmdEnum コマンドのEnum Class
-     * @tparam N 送信データ長：1~8
+     * @tparam N 送信データ長：1~8 (CAN FDは1~64)
      * @param command
      * コマンド（データの種類を示す、CAN通信時のデータは指令として見れるためコマンドとして見なす）
-     * @param data 送信データ（要素数1~8のarray配列）
+     * @param data 送信データ（要素数1~8、CAN FDは1~64のarray配列）
      * @return true 送信成功（CANDriverの継承後クラスによって定義）
      * @return false 送信失敗（CANDriverの継承後クラスによって定義）
      */
@@ -110,8 +171,100 @@ protected:
         return send(command, data.data(), static_cast<uint8_t>(data.size()));
     }
 
-    CANBus& bus_;                 // CAN通信を統括するクラスの参照
+    /**
+     * @brief 最新値だけを送信する (目標値など)
+     *
+     * 同じコマンドのフレームが送信待ちであれば、追加せずに新しいデータで置き換えます。
+     * 過負荷時でも古い値が新しい値の後に送信されることはありません。
+     *
+     * @tparam CmdEnum コマンドのEnum Class
+     * @param command コマンド
+     * @param data 送信データ
+     * @param len 送信データ長（MAX: CANは8、CAN FDは64）
+     * @return true 送信成功、または送信キューに保持
+     * @return false 送信失敗（バスの最大データ長超過、送信キューが満杯など）
+     */
+    template <typename CmdEnum>
+    bool send_latest(CmdEnum command, const uint8_t* data, std::size_t len)
+    {
+        if (len > CANFrameView::MAX_DLC) {
+            return false;
+        }
+        CANFrameView frame(
+            id::pack(device_type_, device_id_, command), data, static_cast<uint8_t>(len)
+        );
+        return bus_.send_frame_latest(frame);
+    }
+
+    /**
+     * @brief 最新値だけを送信する (array版)
+     *
+     * @tparam CmdEnum コマンドのEnum Class
+     * @tparam N 送信データ長
+     * @param command コマンド
+     * @param data 送信データ
+     * @return true 送信成功、または送信キューに保持
+     * @return false 送信失敗
+     */
+    template <typename CmdEnum, std::size_t N>
+    bool send_latest(CmdEnum command, const std::array<uint8_t, N>& data)
+    {
+        return send_latest(command, data.data(), data.size());
+    }
+
+    /**
+     * @brief コマンドの受信ハンドラを登録する
+     *
+     * 初回の登録で受け付けるコマンドは登録済みのものだけに絞られ、
+     * それ以外のコマンドのフレームはCANBusが仮想関数を呼ぶ前に破棄します。
+     *
+     * @tparam Device ハンドラを持つ派生クラス
+     * @tparam CmdEnum コマンドのEnum Class
+     * @param command 受信するコマンド
+     * @param handler 受信時に呼び出すメンバ関数
+     */
+    template <typename Device, typename CmdEnum>
+    void subscribe(CmdEnum command, void (Device::*handler)(const CANFrameView&))
+    {
+        static_assert(
+            std::is_base_of<CANDevice, Device>::value, "Device must derive from CANDevice"
+        );
+        static_assert(std::is_enum<CmdEnum>::value, "Command must be an Enum class");
+
+        uint8_t index = static_cast<uint8_t>(command) & (id::COMMAND_COUNT - 1);
+        if (!command_mask_declared_) {
+            set_command_mask(0);
+        }
+        handlers_[index] = static_cast<Handler>(handler);
+        command_mask_ |= static_cast<uint8_t>(1 << index);
+        bus_.on_routes_changed();
+    }
+
+    /**
+     * @brief 受け付けるコマンドのビットマスクを宣言する
+     *
+     * 受信するコマンドを持たないデバイスは 0 を宣言することで、自身宛てのフレームの配送を止められます。
+     * バスがハードウェア受信フィルタを使用している場合は、フィルタも設定し直されます。
+     *
+     * @param mask コマンドのビットマスク (bit n がコマンド n に対応)
+     */
+    void set_command_mask(uint8_t mask)
+    {
+        command_mask_          = mask;
+        command_mask_declared_ = true;
+        bus_.on_routes_changed();
+    }
+
+    CANBusBase& bus_;             // CAN通信を統括するクラスの参照
     id::DeviceType device_type_;  // デバイスの種類
     uint8_t device_id_;           // デバイスID
+
+private:
+    using Handler = void (CANDevice::*)(const CANFrameView&);
+
+    std::array<Handler, id::COMMAND_COUNT> handlers_{};               // コマンドごとの受信ハンドラ
+    std::array<SeqLock<uint64_t>, id::COMMAND_COUNT> rx_timestamps_;  // コマンドごとの最終受信時刻
+    uint8_t command_mask_       = ALL_COMMANDS;                       // 受け付けるコマンドのビットマスク
+    bool command_mask_declared_ = false;                              // コマンドマスクを宣言済みか
 };
 }  // namespace gn10_can
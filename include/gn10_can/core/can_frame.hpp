@@ -19,6 +19,90 @@
 
 namespace gn10_can {
 
+namespace detail {
+template <std::size_t MaxDLC>
+struct CANFrame;
+}  // namespace detail
+
+/**
+ * @brief データ長に依存しないCANフレームの参照
+ * @details
+ * CAN / CAN FD どちらのバスのフレームも同じ形で参照できるため、デバイスはバスの種類を意識せずに
+ * 受信・送信を行えます。参照先のフレームより長く保持しないでください。
+ */
+struct CANFrameView {
+    static constexpr std::size_t MAX_DLC = 64;  // 参照できる最大データ長 (CAN FD)
+
+    uint32_t id         = 0;        // CAN ID
+    const uint8_t* data = nullptr;  // データ配列の先頭
+    uint8_t dlc         = 0;        // データ長 (DLC)
+    bool is_extended    = false;
+    uint64_t timestamp  = 0;        // 受信時刻 (ドライバ定義の単調増加カウンタ、0は時刻なし)
+
+    CANFrameView() = default;
+
+    /**
+     * @brief CANフレーム参照のコンストラクタ
+     *
+     * @param id CAN ID
+     * @param data データ配列の先頭
+     * @param dlc データ長
+     * @param is_extended 拡張IDかどうか
+     */
+    CANFrameView(uint32_t id, const uint8_t* data, uint8_t dlc, bool is_extended = false)
+        : id(id), data(data), dlc(dlc), is_extended(is_extended)
+    {
+    }
+
+    /**
+     * @brief CANフレームから参照を作成する
+     *
+     * @tparam MaxDLC 参照元フレームの最大データ長
+     * @param frame 参照元のCANフレーム
+     */
+    template <std::size_t MaxDLC>
+    CANFrameView(const detail::CANFrame<MaxDLC>& frame)
+        : id(frame.id),
+          data(frame.data.data()),
+          dlc(frame.dlc),
+          is_extended(frame.is_extended),
+          timestamp(frame.timestamp)
+    {
+    }
+
+    /**
+     * @brief ルーティング用のID（Command部を除外）を取得
+     *
+     * @return uint32_t ルーティングID (DeviceType + DeviceID)
+     */
+    uint32_t get_routing_id() const
+    {
+        return id >> id::BIT_WIDTH_COMMAND;
+    }
+
+    /**
+     * @brief コマンド部（下位ビット）を取得
+     *
+     * @return uint8_t コマンド (0 ~ id::COMMAND_COUNT - 1)
+     */
+    uint8_t get_command() const
+    {
+        return static_cast<uint8_t>(id & (id::COMMAND_COUNT - 1));
+    }
+};
+
+/**
+ * @brief 送信完了イベント
+ * @details
+ * フレームが実際にコントローラから送出された時刻を、送信したフレームのIDとともに通知します。
+ * 時刻の単位は受信時刻と同じくドライバ定義です。
+ */
+struct TxEvent {
+    uint32_t id        = 0;      // 送信したフレームのCAN ID
+    bool is_extended   = false;  // 拡張IDかどうか
+    uint64_t timestamp = 0;      // 送出時刻 (ドライバ定義の単調増加カウンタ)
+};
+
 namespace detail {
 
 /**
@@ -31,11 +115,25 @@ struct CANFrame {
 
     uint32_t id = 0;                     // CAN ID
     std::array<uint8_t, MaxDLC> data{};  // データ配列
-    uint8_t dlc      = 0;                // データ長 (DLC)
-    bool is_extended = false;
+    uint8_t dlc        = 0;              // データ長 (DLC)
+    bool is_extended   = false;
+    uint64_t timestamp = 0;  // 受信時刻 (ドライバ定義の単調増加カウンタ、0は時刻なし)
 
     CANFrame() = default;
 
+    /**
+     * @brief CANフレーム参照の内容をコピーしてCANフレームを作成する
+     *
+     * MAX_DLC を超えるデータは切り捨てます。
+     *
+     * @param view コピー元のCANフレーム参照
+     */
+    explicit CANFrame(const CANFrameView& view)
+        : id(view.id), is_extended(view.is_extended), timestamp(view.timestamp)
+    {
+        set_data(view.data, view.dlc);
+    }
+
     /**
      * @brief CANフレーム作成ヘルパー関数
      *
@@ -121,9 +219,21 @@ struct CANFrame {
         return id >> id::BIT_WIDTH_COMMAND;
     }
 
+    /**
+     * @brief コマンド部（下位ビット）を取得
+     *
+     * @return uint8_t コマンド (0 ~ id::COMMAND_COUNT - 1)
+     */
+    uint8_t get_command() const
+    {
+        return static_cast<uint8_t>(id & (id::COMMAND_COUNT - 1));
+    }
+
     /**
      * @brief CANフレーム比較演算子
      *
+     * 受信時刻は比較しません。
+     *
      * @param other 比較対象のCANフレーム
      * @return true 等しい
      * @return false 等しくない
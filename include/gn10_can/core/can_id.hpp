@@ -20,6 +20,10 @@ static constexpr uint8_t BIT_WIDTH_DEV_TYPE = 4;
 static constexpr uint8_t BIT_WIDTH_DEV_ID   = 4;
 static constexpr uint8_t BIT_WIDTH_COMMAND  = 3;
 
+static constexpr uint8_t COMMAND_COUNT = 1 << BIT_WIDTH_COMMAND;  // コマンドの種類数
+// ルーティングID (DeviceType + DeviceID) の種類数
+static constexpr uint16_t ROUTING_ID_COUNT = 1 << (BIT_WIDTH_DEV_TYPE + BIT_WIDTH_DEV_ID);
+
 /**
  * @brief デバイスの種類
  *
@@ -57,6 +61,8 @@ enum class MsgTypeMotorDriver : uint8_t {
     Gain           = 2,
     Feedback       = 3,
     HardwareStatus = 4,
+    State          = 5,  ///< @brief Feedback と HardwareStatus をまとめた状態 (MotorStateSchema)
+    GroupTarget    = 6,  ///< @brief 複数モーターの目標値 (デバイスIDはグループID)
 };
 
 /**
@@ -78,6 +84,7 @@ enum class MsgTypeESCHub : uint8_t {
     Gain                       = 1,
     AngularVelocities          = 2,
     AngularVelocitiesFeedbacks = 3,
+    FullStateFeedbacks         = 4,
 };
 
 /**
@@ -11,80 +11,21 @@
  */
 #pragma once
 
-#include <array>
-#include <cstddef>
-
+#include "gn10_can/core/can_bus.hpp"
+#include "gn10_can/core/fdcan_frame.hpp"
 #include "gn10_can/drivers/fdcan_driver_interface.hpp"
 
 namespace gn10_can {
 
-class FDCANDevice;
-
-/**
- * @brief
- * 物理的なFDCANバスをソフトウェア上で表現したクラス。デバイスの接続(Attach)と、メッセージのルーティング(Dispatch)を担当します。
- *
- */
-class FDCANBus
-{
-public:
-    static constexpr std::size_t MAX_DEVICES = 16;  // 最大登録デバイス数
-
-    /**
-     * @brief FDCANBusクラスのコンストラクタ
-     *
-     * @param driver FDCANドライバーインターフェースの参照
-     */
-    explicit FDCANBus(drivers::IFDCANDriver& driver);
-
-    /**
-     * @brief FDCANパケットの受信とデバイスへのルーティング処理
-     *
-     * 受信データを読み込み、適切なデバイスに渡します。
-     */
-    void update();
-
-    /**
-     * @brief FDCANフレーム送信関数
-     *
-     * @param frame 送信するCANフレーム
-     * @return true 送信成功
-     * @return false 送信失敗
-     */
-    bool send_frame(const FDCANFrame& frame);
-
-private:
-    friend class FDCANDevice;
-
-    /**
-     * @brief デバイスをバスに接続する (RAII内部利用)
-     *
-     * FDCANDeviceのコンストラクタから自動的に呼び出されます。
-     *
-     * @param device 登録するデバイスへのポインタ
-     * @return true 登録成功
-     * @return false 登録失敗（デバイス数上限）
-     */
-    bool attach(FDCANDevice* device);
+// CAN FDバス。クラシックCANのデバイスも同じバスに接続できます。
+using FDCANBus = detail::CANBus<64>;
 
-    /**
-     * @brief デバイスをバスから切断する (RAII内部利用)
-     *
-     * FDCANDeviceのデストラクタから自動的に呼び出されます。
-     *
-     * @param device 登録解除するデバイスへのポインタ
-     */
-    void detach(FDCANDevice* device);
+// 割り込み・スレッドから送信する場合に排他制御を指定するCAN FDバス
+template <typename Lock>
+using LockedFDCANBus = detail::CANBus<64, Lock>;
 
-    /**
-     * @brief 受信したフレームを適切なデバイスに配送する
-     *
-     * @param frame 受信フレーム
-     */
-    void dispatch(const FDCANFrame& frame);
+// 統計情報を記録するCAN FDバス
+template <typename Stats, typename Lock = NullLock>
+using InstrumentedFDCANBus = detail::CANBus<64, Lock, Stats>;
 
-    drivers::IFDCANDriver& driver_;                    // CANドライバーインターフェースの参照を保持
-    std::array<FDCANDevice*, MAX_DEVICES> devices_{};  // 登録されているデバイスの配列
-    std::size_t device_count_ = 0;                     // 登録されているデバイス数
-};
 }  // namespace gn10_can
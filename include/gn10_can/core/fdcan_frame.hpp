@@ -9,10 +9,90 @@
  *
  */
 #pragma once
+#include <cstdint>
+
 #include "gn10_can/core/can_frame.hpp"
 
 namespace gn10_can {
 
 using FDCANFrame = detail::CANFrame<64>;
 
+namespace fd {
+
+// CAN FD のデータ長に満たない部分を埋める値
+static constexpr uint8_t PADDING_BYTE = 0xCC;
+
+/**
+ * @brief データ長が CAN FD フレームでなければ送れないか判定する
+ *
+ * 8バイト以下のフレームはクラシックCANのフレームで送信し、同じバス上のクラシックCANのみの
+ * ノードでも受信できるようにします。
+ *
+ * @param length データ長 (0~64)
+ * @return true CAN FD フレームで送信する
+ * @return false クラシックCANのフレームで送信する
+ */
+constexpr bool requires_fd_format(uint8_t length)
+{
+    return length > 8;
+}
+
+/**
+ * @brief データ長をCAN FDのDLCコードに変換する
+ *
+ * CAN FD で表現できないデータ長 (9~11 など) は、送信できる長さに切り上げたコードを返します。
+ *
+ * @param length データ長 (0~64)
+ * @return uint8_t DLCコード (0~15)
+ */
+constexpr uint8_t dlc_to_code(uint8_t length)
+{
+    if (length <= 8) {
+        return length;
+    }
+    if (length <= 12) {
+        return 9;
+    }
+    if (length <= 16) {
+        return 10;
+    }
+    if (length <= 20) {
+        return 11;
+    }
+    if (length <= 24) {
+        return 12;
+    }
+    if (length <= 32) {
+        return 13;
+    }
+    if (length <= 48) {
+        return 14;
+    }
+    return 15;
+}
+
+/**
+ * @brief CAN FDのDLCコードをデータ長に変換する
+ *
+ * @param code DLCコード (0~15)
+ * @return uint8_t データ長 (0~64)
+ */
+constexpr uint8_t code_to_dlc(uint8_t code)
+{
+    constexpr uint8_t LENGTHS[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64};
+    return LENGTHS[code & 0x0F];
+}
+
+/**
+ * @brief バス上で送信されるデータ長 (パディング込み) を求める
+ *
+ * @param length データ長 (0~64)
+ * @return uint8_t パディング込みのデータ長
+ */
+constexpr uint8_t padded_length(uint8_t length)
+{
+    return code_to_dlc(dlc_to_code(length));
+}
+
+}  // namespace fd
 }  // namespace gn10_can
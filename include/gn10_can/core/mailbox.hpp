@@ -0,0 +1,181 @@
+/**
+ * @file mailbox.hpp
+ * @author Gento Aiba (aiba-gento)
+ * @brief 受信した最新値をデバイスから制御ループへ受け渡すメールボックスのヘッダーファイル
+ * @version 0.1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026 Gento Aiba
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+#include "gn10_can/core/seqlock.hpp"
+
+namespace gn10_can {
+
+/**
+ * @brief 受信した最新値を保持し、未読の値だけを取り出せるメールボックス
+ * @details
+ * デバイスの受信処理が post() で値を書き込み、制御ループが take() で未読の値を取り出します。
+ * 値は SeqLock で受け渡すため、受信処理と制御ループが別のスレッドや割り込みでも書き込み途中の値を
+ * 読むことはなく、ロックも使用しません。
+ *
+ * 取り出す前に次の値が届いた場合は古い値を上書きし、上書き回数 (overwritten_count()) を加算します。
+ * 受信周期に対して制御ループが遅すぎないかの確認や、制御周期の見積もりに使用します。
+ * 値の受信時刻 (CANFrame::timestamp) も保持し、age() で現在の値の古さを求められます。
+ *
+ * 書き込み側 (post) と取り出し側 (take) はそれぞれ1つにしてください。peek() などの参照は
+ * 任意のスレッドから呼び出せます。読み出し側が書き込み側に割り込む場合 (受信処理より優先度の高い
+ * 割り込みから取り出すなど) は、SeqLock と同様に読み出しが終わらないため使用しないでください。
+ *
+ * @tparam T 受け渡す値の型 (トリビアルにコピー可能であること)
+ */
+template <typename T>
+class Mailbox
+{
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+
+    Mailbox() = default;
+
+    Mailbox(const Mailbox&)            = delete;
+    Mailbox& operator=(const Mailbox&) = delete;
+
+    /**
+     * @brief 値を書き込む (書き込み側)
+     *
+     * 未読の値があれば上書きします。
+     *
+     * @param value 書き込む値
+     * @param timestamp 値の受信時刻 (CANFrame::timestamp、0は時刻なし)
+     */
+    void post(const T& value, uint64_t timestamp = 0)
+    {
+        const uint32_t sequence = posted_.load(std::memory_order_relaxed);
+        if (sequence != taken_.load(std::memory_order_acquire)) {
+            overwritten_.store(
+                overwritten_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed
+            );
+        }
+
+        Entry entry;
+        entry.value     = value;
+        entry.timestamp = timestamp;
+        entry.sequence  = sequence + 1;
+        entry_.write(entry);
+        posted_.store(sequence + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief 未読の値を取り出す (取り出し側)
+     *
+     * @param out_value 取り出した値の格納先 (未読の値がない場合は変更しない)
+     * @return true 未読の値があり、取り出した
+     * @return false 未読の値はない
+     */
+    bool take(T& out_value)
+    {
+        const Entry entry = entry_.read();
+        if (entry.sequence == taken_.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        out_value = entry.value;
+        taken_.store(entry.sequence, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 最新の値を未読・既読にかかわらず読み出す
+     *
+     * @param out_value 読み出した値の格納先 (一度も書き込まれていない場合は変更しない)
+     * @return true 読み出し成功
+     * @return false 一度も書き込まれていない
+     */
+    bool peek(T& out_value) const
+    {
+        const Entry entry = entry_.read();
+        if (entry.sequence == 0) {
+            return false;
+        }
+        out_value = entry.value;
+        return true;
+    }
+
+    /**
+     * @brief 未読の値があるか
+     *
+     * @return true 未読の値がある
+     * @return false 未読の値はない
+     */
+    bool has_new() const
+    {
+        return posted_.load(std::memory_order_acquire) != taken_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief これまでに書き込まれた回数を取得する
+     *
+     * @return uint32_t 書き込み回数
+     */
+    uint32_t update_count() const
+    {
+        return posted_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief 取り出される前に上書きされた回数を取得する
+     *
+     * @return uint32_t 上書き回数
+     */
+    uint32_t overwritten_count() const
+    {
+        return overwritten_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 最新の値の受信時刻を取得する
+     *
+     * @return uint64_t 受信時刻 (CANFrame::timestamp、0は時刻なしまたは未受信)
+     */
+    uint64_t timestamp() const
+    {
+        return entry_.read().timestamp;
+    }
+
+    /**
+     * @brief 最新の値の古さを取得する
+     *
+     * @param now 現在時刻 (受信時刻と同じドライバ定義の単位)
+     * @return uint64_t 受信からの経過時間 (受信時刻がない場合は0)
+     */
+    uint64_t age(uint64_t now) const
+    {
+        const uint64_t received = timestamp();
+        if (received == 0 || now < received) {
+            return 0;
+        }
+        return now - received;
+    }
+
+private:
+    /**
+     * @brief 値と、その値の受信時刻・書き込み番号
+     */
+    struct Entry {
+        T value{};               // 値
+        uint64_t timestamp = 0;  // 受信時刻
+        uint32_t sequence  = 0;  // 書き込み番号 (0は未書き込み)
+    };
+
+    SeqLock<Entry> entry_;                  // 最新の値
+    std::atomic<uint32_t> posted_{0};       // 最新の値の書き込み番号 (書き込み側のみ更新)
+    std::atomic<uint32_t> taken_{0};        // 最後に取り出した書き込み番号 (取り出し側のみ更新)
+    std::atomic<uint32_t> overwritten_{0};  // 取り出される前に上書きされた回数
+};
+
+}  // namespace gn10_can
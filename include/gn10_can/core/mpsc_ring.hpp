@@ -0,0 +1,198 @@
+/**
+ * @file mpsc_ring.hpp
+ * @author Gento Aiba (aiba-gento)
+ * @brief 複数のスレッドから1つのスレッドへ要素を受け渡すロックフリーリングバッファのヘッダーファイル
+ * @version 0.1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026 Gento Aiba
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace gn10_can {
+
+/**
+ * @brief 複数生産者・単一消費者 (MPSC) のロックフリーリングバッファ
+ * @details
+ * 複数の制御スレッドが push し、I/O スレッドが pop します。ロックは使用せず、
+ * 生産者同士は書き込み位置を compare-and-swap で確保します。動的メモリは使用しません。
+ *
+ * 各要素に書き込み済みかを示すシーケンス番号を持たせ、位置を確保した生産者が書き込みを終えるまで
+ * 消費者はその要素を取り出しません。位置を確保した生産者が中断されている間は、それ以降の要素も
+ * 取り出されません。
+ * compare-and-swap を使用するため、LDREX/STREX を持たないコア (Cortex-M0 など) では
+ * SPSCRing を使用してください。
+ *
+ * @tparam T 格納する要素の型 (コピー可能であること)
+ * @tparam Capacity 最大格納数 (2の累乗)
+ */
+template <typename T, std::size_t Capacity>
+class MPSCRing
+{
+public:
+    static_assert(Capacity > 1, "Capacity must be greater than 1");
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    using Index = uint32_t;
+
+    static_assert(Capacity <= (Index{1} << 30), "Capacity is too large");
+    static_assert(std::atomic<Index>::is_always_lock_free, "Index must be lock-free");
+
+    MPSCRing()
+    {
+        for (std::size_t i = 0; i < Capacity; i++) {
+            cells_[i].sequence.store(static_cast<Index>(i), std::memory_order_relaxed);
+        }
+    }
+
+    MPSCRing(const MPSCRing&)            = delete;
+    MPSCRing& operator=(const MPSCRing&) = delete;
+
+    /**
+     * @brief 要素を追加する (生産者側、複数スレッドから呼び出し可能)
+     *
+     * 満杯の場合は要素を破棄し、オーバーフロー回数を加算します。
+     *
+     * @param item 追加する要素
+     * @return true 追加成功
+     * @return false 満杯のため破棄
+     */
+    bool push(const T& item)
+    {
+        Index head = head_.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+        while (true) {
+            cell                 = &cells_[head & MASK];
+            const Index sequence = cell->sequence.load(std::memory_order_acquire);
+            const int32_t diff   = static_cast<int32_t>(sequence - head);
+            if (diff == 0) {
+                // 空いている位置を確保する (失敗した場合は head が最新値に更新される)
+                if (head_.compare_exchange_weak(head, head + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                overflow_count_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                head = head_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->item = item;
+        cell->sequence.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 要素を1つ取り出す (消費者側)
+     *
+     * @param out_item 取り出した要素の格納先
+     * @return true 取り出し成功
+     * @return false 空 (または次の要素を書き込み中)
+     */
+    bool pop(T& out_item)
+    {
+        return pop_many(&out_item, 1) == 1;
+    }
+
+    /**
+     * @brief 要素をまとめて取り出す (消費者側)
+     *
+     * @param out_items 取り出した要素の格納先配列
+     * @param max_count 取り出す最大数
+     * @return std::size_t 取り出した要素数
+     */
+    std::size_t pop_many(T* out_items, std::size_t max_count)
+    {
+        Index tail        = tail_.load(std::memory_order_relaxed);
+        std::size_t count = 0;
+        while (count < max_count) {
+            Cell& cell = cells_[tail & MASK];
+            if (cell.sequence.load(std::memory_order_acquire) != tail + 1) {
+                break;
+            }
+            out_items[count] = cell.item;
+            // 1周後の生産者に位置を明け渡す
+            cell.sequence.store(tail + static_cast<Index>(Capacity), std::memory_order_release);
+            tail++;
+            count++;
+        }
+        tail_.store(tail, std::memory_order_relaxed);
+        return count;
+    }
+
+    /**
+     * @brief 格納されている要素数を取得する
+     *
+     * 生産者・消費者が動作中の場合は呼び出し時点の近似値です (書き込み中の要素を含みます)。
+     *
+     * @return std::size_t 要素数
+     */
+    std::size_t size() const
+    {
+        const Index tail = tail_.load(std::memory_order_relaxed);
+        const Index head = head_.load(std::memory_order_relaxed);
+        const Index used = head - tail;
+        if (used > Capacity) {
+            return Capacity;
+        }
+        return used;
+    }
+
+    /**
+     * @brief 空か判定する
+     *
+     * @return true 空
+     * @return false 1つ以上格納されている
+     */
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /**
+     * @brief 最大格納数を取得する
+     *
+     * @return constexpr std::size_t 最大格納数
+     */
+    static constexpr std::size_t capacity()
+    {
+        return Capacity;
+    }
+
+    /**
+     * @brief 満杯のため破棄された要素数を取得する
+     *
+     * @return uint32_t オーバーフロー回数
+     */
+    uint32_t overflow_count() const
+    {
+        return overflow_count_.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr Index MASK = static_cast<Index>(Capacity - 1);
+
+    /**
+     * @brief 要素と、その要素の状態を表すシーケンス番号
+     * @details
+     * sequence が位置と等しければ空き、位置 + 1 であれば書き込み済みです。
+     */
+    struct Cell {
+        std::atomic<Index> sequence{0};  // 要素の状態
+        T item{};                        // 要素
+    };
+
+    std::array<Cell, Capacity> cells_;         // 要素の格納領域
+    std::atomic<Index> head_{0};               // 次に確保する書き込み位置 (生産者が更新)
+    std::atomic<Index> tail_{0};               // 次に読み出す位置 (消費者のみ更新)
+    std::atomic<uint32_t> overflow_count_{0};  // 満杯で破棄した要素数
+};
+
+}  // namespace gn10_can
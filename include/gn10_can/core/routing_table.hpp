@@ -0,0 +1,178 @@
+/**
+ * @file routing_table.hpp
+ * @author Gento Aiba (aiba-gento)
+ * @brief ルーティングIDをキーとしたデバイス索引テーブルのヘッダーファイル
+ * @version 0.1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026 Gento Aiba
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "gn10_can/core/can_id.hpp"
+
+// 1バスあたりの最大登録デバイス数 (ビルド時に -DGN10_CAN_MAX_DEVICES=N で変更可能)
+#ifndef GN10_CAN_MAX_DEVICES
+#define GN10_CAN_MAX_DEVICES 16
+#endif
+
+namespace gn10_can {
+namespace detail {
+
+/**
+ * @brief ルーティングIDをキーとしたデバイス索引テーブル
+ * @details
+ * ルーティングID (DeviceType + DeviceID の8bit) ごとに先頭スロットを保持し、
+ * 同じルーティングIDを持つデバイス (Client と Server など) はスロット間の連結リストで辿ります。
+ * 未登録IDの判定は配列参照1回で完了し、登録デバイス数に依存しません。動的メモリは使用しません。
+ *
+ * @tparam Device 登録するデバイスの型
+ * @tparam Capacity 最大登録デバイス数
+ */
+template <typename Device, std::size_t Capacity>
+class RoutingTable
+{
+public:
+    static_assert(Capacity > 0, "Capacity must be greater than 0");
+    static_assert(Capacity < std::numeric_limits<uint16_t>::max(), "Capacity is too large");
+
+    static constexpr std::size_t ROUTING_ID_COUNT = std::size_t{1}
+                                                    << (id::BIT_WIDTH_DEV_TYPE + id::BIT_WIDTH_DEV_ID);
+
+    // スロット番号の型 (容量に応じて最小の型を選び、索引のメモリ使用量を抑える)
+    using Index = std::conditional_t<(Capacity < 0xFF), uint8_t, uint16_t>;
+
+    static constexpr Index NO_SLOT = std::numeric_limits<Index>::max();
+
+    RoutingTable()
+    {
+        heads_.fill(NO_SLOT);
+        next_.fill(NO_SLOT);
+    }
+
+    /**
+     * @brief デバイスを登録する
+     *
+     * 同じルーティングIDのデバイスは登録順に配送されるよう末尾に連結します。
+     *
+     * @param routing_id デバイスのルーティングID
+     * @param device 登録するデバイスへのポインタ
+     * @return true 登録成功
+     * @return false 登録失敗（容量上限、範囲外のID、nullptr）
+     */
+    bool insert(uint32_t routing_id, Device* device)
+    {
+        if (device == nullptr || routing_id >= ROUTING_ID_COUNT || size_ >= Capacity) {
+            return false;
+        }
+
+        // 空きスロットを探す
+        Index slot = 0;
+        while (devices_[slot] != nullptr) {
+            slot++;
+        }
+        devices_[slot] = device;
+        next_[slot]    = NO_SLOT;
+
+        // 同じルーティングIDの連結リスト末尾に繋ぐ
+        Index* link = &heads_[routing_id];
+        while (*link != NO_SLOT) {
+            link = &next_[*link];
+        }
+        *link = slot;
+
+        size_++;
+        return true;
+    }
+
+    /**
+     * @brief デバイスの登録を解除する
+     *
+     * @param routing_id デバイスのルーティングID
+     * @param device 登録解除するデバイスへのポインタ
+     * @return true 登録解除成功
+     * @return false 該当デバイスが未登録
+     */
+    bool remove(uint32_t routing_id, const Device* device)
+    {
+        if (routing_id >= ROUTING_ID_COUNT) {
+            return false;
+        }
+
+        Index* link = &heads_[routing_id];
+        while (*link != NO_SLOT) {
+            Index slot = *link;
+            if (devices_[slot] == device) {
+                *link          = next_[slot];
+                devices_[slot] = nullptr;
+                next_[slot]    = NO_SLOT;
+                size_--;
+                return true;
+            }
+            link = &next_[slot];
+        }
+        return false;
+    }
+
+    /**
+     * @brief ルーティングIDに一致するデバイスが登録されているか判定する
+     *
+     * @param routing_id ルーティングID
+     * @return true 1つ以上登録されている
+     * @return false 登録されていない
+     */
+    bool contains(uint32_t routing_id) const
+    {
+        return routing_id < ROUTING_ID_COUNT && heads_[routing_id] != NO_SLOT;
+    }
+
+    /**
+     * @brief ルーティングIDに一致する全デバイスに対して関数を呼び出す
+     *
+     * 呼び出し先でデバイスが登録解除されても安全なよう、次のスロットを先に読み出します。
+     *
+     * @tparam Func void(Device&) の形で呼び出せる関数オブジェクト
+     * @param routing_id ルーティングID
+     * @param func 呼び出す関数
+     */
+    template <typename Func>
+    void for_each(uint32_t routing_id, Func&& func) const
+    {
+        if (routing_id >= ROUTING_ID_COUNT) {
+            return;
+        }
+
+        Index slot = heads_[routing_id];
+        while (slot != NO_SLOT) {
+            Index next_slot = next_[slot];
+            func(*devices_[slot]);
+            slot = next_slot;
+        }
+    }
+
+    /**
+     * @brief 登録されているデバイス数を取得する
+     *
+     * @return std::size_t 登録デバイス数
+     */
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+private:
+    std::array<Index, ROUTING_ID_COUNT> heads_;  // ルーティングIDごとの先頭スロット
+    std::array<Index, Capacity> next_;           // 同じルーティングIDを持つ次のスロット
+    std::array<Device*, Capacity> devices_{};    // スロットごとのデバイス
+    std::size_t size_ = 0;                       // 登録されているデバイス数
+};
+
+}  // namespace detail
+}  // namespace gn10_can
@@ -0,0 +1,152 @@
+/**
+ * @file seqlock.hpp
+ * @author Gento Aiba (aiba-gento)
+ * @brief 1つの書き込み側から複数の読み出し側へ値を受け渡すシーケンスロックのヘッダーファイル
+ * @version 0.1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026 Gento Aiba
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace gn10_can {
+
+/**
+ * @brief 書き込み側を待たせずに、読み出し側が一貫した値を得るシーケンスロック
+ * @details
+ * 書き込み側は書き込みの前後でシーケンス番号を進め、読み出し側は読み出しの前後で番号が
+ * 変わっていないこと (書き込み中でないこと) を確認します。書き込み側はロックを取らずに
+ * 上書きでき、読み出し側は書き込みと重なった場合だけ読み直します。
+ *
+ * 値はアトミックな32bitワードに分けて保持するため、書き込み途中の値を読んだ場合も未定義動作になりません。
+ * 書き込み側は1つだけにしてください。
+ * 読み出し側が書き込み側に割り込む場合 (書き込み側より優先度の高い割り込みなど) は、
+ * 読み直しても書き込みが終わらないため read() ではなく try_read() を使用してください。
+ *
+ * @tparam T 受け渡す値の型 (トリビアルにコピー可能であること)
+ */
+template <typename T>
+class SeqLock
+{
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+
+    /**
+     * @brief SeqLockクラスのコンストラクタ
+     *
+     * @param initial 初期値
+     */
+    explicit SeqLock(const T& initial = T{})
+    {
+        store_words(initial);
+    }
+
+    SeqLock(const SeqLock&)            = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    /**
+     * @brief 値を書き込む (書き込み側)
+     *
+     * @param value 書き込む値
+     */
+    void write(const T& value)
+    {
+        const uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+        // 奇数の間は書き込み中
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        store_words(value);
+
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief 値を読み出す (読み出し側)
+     *
+     * 書き込みと重なった場合は書き込みが終わるまで読み直します。
+     *
+     * @return T 読み出した値
+     */
+    T read() const
+    {
+        T value;
+        while (!try_read(value)) {
+        }
+        return value;
+    }
+
+    /**
+     * @brief 値を1回だけ読み出す (読み出し側)
+     *
+     * @param out_value 読み出した値の格納先 (失敗した場合は変更しない)
+     * @return true 読み出し成功
+     * @return false 書き込みと重なった
+     */
+    bool try_read(T& out_value) const
+    {
+        const uint32_t begin = sequence_.load(std::memory_order_acquire);
+        if ((begin & 1) != 0) {
+            return false;
+        }
+
+        Words words;
+        for (std::size_t i = 0; i < WORD_COUNT; i++) {
+            words[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) != begin) {
+            return false;
+        }
+
+        // メンバの初期値を持つ型 (トリビアルにコピー可能) も受け付ける
+        std::memcpy(static_cast<void*>(&out_value), words.data(), sizeof(T));
+        return true;
+    }
+
+    /**
+     * @brief これまでに書き込まれた回数を取得する
+     *
+     * 前回の読み出しから値が更新されたかの判定に使用します。
+     *
+     * @return uint32_t 書き込み回数 (書き込み中の分を含まない)
+     */
+    uint32_t version() const
+    {
+        return sequence_.load(std::memory_order_acquire) / 2;
+    }
+
+private:
+    using Word = uint32_t;
+
+    static constexpr std::size_t WORD_COUNT = (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+
+    using Words = std::array<Word, WORD_COUNT>;
+
+    /**
+     * @brief 値をワードに分けて格納する
+     *
+     * @param value 格納する値
+     */
+    void store_words(const T& value)
+    {
+        Words words{};
+        std::memcpy(words.data(), &value, sizeof(T));
+        for (std::size_t i = 0; i < WORD_COUNT; i++) {
+            words_[i].store(words[i], std::memory_order_relaxed);
+        }
+    }
+
+    std::atomic<uint32_t> sequence_{0};                // シーケンス番号 (奇数: 書き込み中)
+    std::array<std::atomic<Word>, WORD_COUNT> words_;  // 値を分割したワード
+};
+
+}  // namespace gn10_can
@@ -0,0 +1,180 @@
+/**
+ * @file spsc_ring.hpp
+ * @author Gento Aiba (aiba-gento)
+ * @brief 割り込みとメインループ間で要素を受け渡すロックフリーリングバッファのヘッダーファイル
+ * @version 0.1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026 Gento Aiba
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace gn10_can {
+
+/**
+ * @brief 単一生産者・単一消費者 (SPSC) のロックフリーリングバッファ
+ * @details
+ * 生産者 (受信割り込みなど) が push し、消費者 (メインループ) が pop します。
+ * 生産者と消費者がそれぞれ1つだけであれば、割り込み禁止やロックなしで安全に使用できます。
+ * 動的メモリは使用しません。
+ *
+ * インデックスはフリーランで増加させ、容量が2の累乗であることを利用してマスクで位置を求めます。
+ * カウンタの更新は生産者のみが行うため、アトミックな読み出し・書き込みだけで実装しており、
+ * LDREX/STREX を持たないコア (Cortex-M0 など) でも動作します。
+ *
+ * @tparam T 格納する要素の型 (コピー可能であること)
+ * @tparam Capacity 最大格納数 (2の累乗)
+ */
+template <typename T, std::size_t Capacity>
+class SPSCRing
+{
+public:
+    static_assert(Capacity > 0, "Capacity must be greater than 0");
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    using Index = uint32_t;
+
+    static_assert(Capacity <= (Index{1} << 31), "Capacity is too large");
+    static_assert(std::atomic<Index>::is_always_lock_free, "Index must be lock-free");
+
+    /**
+     * @brief 要素を追加する (生産者側)
+     *
+     * 満杯の場合は要素を破棄し、オーバーフロー回数を加算します。
+     *
+     * @param item 追加する要素
+     * @return true 追加成功
+     * @return false 満杯のため破棄
+     */
+    bool push(const T& item)
+    {
+        const Index head = head_.load(std::memory_order_relaxed);
+        const Index tail = tail_.load(std::memory_order_acquire);
+        const Index used = head - tail;
+        if (used >= Capacity) {
+            overflow_count_.store(
+                overflow_count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed
+            );
+            return false;
+        }
+
+        buffer_[head & MASK] = item;
+        head_.store(head + 1, std::memory_order_release);
+
+        if (used + 1 > high_water_mark_.load(std::memory_order_relaxed)) {
+            high_water_mark_.store(used + 1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    /**
+     * @brief 要素を1つ取り出す (消費者側)
+     *
+     * @param out_item 取り出した要素の格納先
+     * @return true 取り出し成功
+     * @return false 空
+     */
+    bool pop(T& out_item)
+    {
+        return pop_many(&out_item, 1) == 1;
+    }
+
+    /**
+     * @brief 要素をまとめて取り出す (消費者側)
+     *
+     * インデックスの同期は呼び出し1回につき1度だけ行います。
+     *
+     * @param out_items 取り出した要素の格納先配列
+     * @param max_count 取り出す最大数
+     * @return std::size_t 取り出した要素数
+     */
+    std::size_t pop_many(T* out_items, std::size_t max_count)
+    {
+        const Index tail  = tail_.load(std::memory_order_relaxed);
+        const Index head  = head_.load(std::memory_order_acquire);
+        std::size_t count = static_cast<Index>(head - tail);
+        if (count > max_count) {
+            count = max_count;
+        }
+
+        for (std::size_t i = 0; i < count; i++) {
+            out_items[i] = buffer_[(tail + static_cast<Index>(i)) & MASK];
+        }
+        tail_.store(tail + static_cast<Index>(count), std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * @brief 格納されている要素数を取得する
+     *
+     * 生産者・消費者が動作中の場合は呼び出し時点の近似値です。
+     *
+     * @return std::size_t 要素数
+     */
+    std::size_t size() const
+    {
+        const Index tail = tail_.load(std::memory_order_acquire);
+        const Index head = head_.load(std::memory_order_acquire);
+        return static_cast<Index>(head - tail);
+    }
+
+    /**
+     * @brief 空か判定する
+     *
+     * @return true 空
+     * @return false 1つ以上格納されている
+     */
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /**
+     * @brief 最大格納数を取得する
+     *
+     * @return constexpr std::size_t 最大格納数
+     */
+    static constexpr std::size_t capacity()
+    {
+        return Capacity;
+    }
+
+    /**
+     * @brief 満杯のため破棄された要素数を取得する
+     *
+     * @return uint32_t オーバーフロー回数
+     */
+    uint32_t overflow_count() const
+    {
+        return overflow_count_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 同時に格納された要素数の最大値を取得する
+     *
+     * 容量の見積もりに使用します。
+     *
+     * @return uint32_t 最大格納数の記録
+     */
+    uint32_t high_water_mark() const
+    {
+        return high_water_mark_.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr Index MASK = static_cast<Index>(Capacity - 1);
+
+    std::array<T, Capacity> buffer_{};          // 要素の格納領域
+    std::atomic<Index> head_{0};                // 次に書き込む位置 (生産者のみ更新)
+    std::atomic<Index> tail_{0};                // 次に読み出す位置 (消費者のみ更新)
+    std::atomic<uint32_t> overflow_count_{0};   // 満杯で破棄した要素数 (生産者のみ更新)
+    std::atomic<uint32_t> high_water_mark_{0};  // 最大格納数の記録 (生産者のみ更新)
+};
+
+}  // namespace gn10_can
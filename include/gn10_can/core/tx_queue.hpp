@@ -0,0 +1,259 @@
+/**
+ * @file tx_queue.hpp
+ * @author Gento Aiba (aiba-gento)
+ * @brief 送信メールボックスが空くまでフレームを保持する優先度付き送信キューのヘッダーファイル
+ * @version 0.1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026 Gento Aiba
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+// 1バスあたりの送信キューの容量 (ビルド時に -DGN10_CAN_TX_QUEUE_SIZE=N で変更可能)
+#ifndef GN10_CAN_TX_QUEUE_SIZE
+#define GN10_CAN_TX_QUEUE_SIZE 32
+#endif
+
+namespace gn10_can {
+
+/**
+ * @brief 排他制御を行わないロック
+ *
+ * 送信キューを割り込みやスレッドから操作しない場合の既定値です。
+ * std::lock_guard で使用できるよう lock() / unlock() を持ちます。
+ */
+struct NullLock {
+    void lock() {}
+    void unlock() {}
+};
+
+namespace detail {
+
+/**
+ * @brief バス調停の優先順位を表すキーを求める
+ * @details
+ * CANのバス調停と同じ順序になるよう、ベースID (11bit) → IDE → 拡張ID (18bit) の順に並べます。
+ * 同じベースIDでは標準フォーマットが拡張フォーマットに勝ちます。値が小さいほど優先度が高くなります。
+ *
+ * @param id CAN ID
+ * @param is_extended 拡張フォーマットか
+ * @return uint32_t 調停キー
+ */
+constexpr uint32_t arbitration_key(uint32_t id, bool is_extended)
+{
+    if (is_extended) {
+        return ((id >> 18) << 19) | (uint32_t{1} << 18) | (id & 0x3FFFF);
+    }
+    return (id & 0x7FF) << 19;
+}
+
+/**
+ * @brief CAN IDの優先順位で取り出す固定容量の送信キュー
+ * @details
+ * フレームはスロットに格納し、二分ヒープではスロット番号だけを入れ替えるため、
+ * CAN FD フレームでも並べ替えのコピーは発生しません。同じ調停キーのフレームは投入順に取り出します。
+ * 動的メモリは使用しません。排他制御は呼び出し側 (CANBus) が行います。
+ *
+ * @tparam Frame 格納するフレームの型
+ * @tparam Capacity 最大格納数
+ */
+template <typename Frame, std::size_t Capacity>
+class TxQueue
+{
+public:
+    static_assert(Capacity > 0, "Capacity must be greater than 0");
+    static_assert(Capacity < std::numeric_limits<uint16_t>::max(), "Capacity is too large");
+
+    // スロット番号の型 (容量に応じて最小の型を選ぶ)
+    using Index = std::conditional_t<(Capacity < 0xFF), uint8_t, uint16_t>;
+
+    TxQueue()
+    {
+        for (std::size_t i = 0; i < Capacity; i++) {
+            free_[i] = static_cast<Index>(i);
+        }
+    }
+
+    /**
+     * @brief フレームを追加する
+     *
+     * @param frame 追加するフレーム
+     * @return true 追加成功
+     * @return false 満杯
+     */
+    bool push(const Frame& frame)
+    {
+        if (size_ >= Capacity) {
+            return false;
+        }
+
+        // 空になるたびに投入順の通し番号を振り直し、桁あふれを防ぐ
+        if (size_ == 0) {
+            sequence_ = 0;
+        }
+
+        Index slot    = free_[Capacity - 1 - size_];
+        frames_[slot] = frame;
+        orders_[slot] = (uint64_t{arbitration_key(frame.id, frame.is_extended)} << 32) | sequence_;
+        sequence_++;
+
+        heap_[size_] = slot;
+        sift_up(size_);
+        size_++;
+
+        if (size_ > high_water_mark_) {
+            high_water_mark_ = size_;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 同じCAN IDのフレームを新しいフレームで置き換える
+     *
+     * 置き換えたフレームは元の位置 (取り出し順) を引き継ぎます。
+     * 同じCAN IDのフレームが複数ある場合は最後に追加されたものを置き換えます。
+     *
+     * @param frame 新しいフレーム
+     * @return true 置き換え成功
+     * @return false 同じCAN IDのフレームがない
+     */
+    bool replace(const Frame& frame)
+    {
+        const uint32_t key = arbitration_key(frame.id, frame.is_extended);
+
+        std::size_t found = size_;
+        for (std::size_t i = 0; i < size_; i++) {
+            if ((orders_[heap_[i]] >> 32) == key &&
+                (found == size_ || orders_[heap_[i]] > orders_[heap_[found]])) {
+                found = i;
+            }
+        }
+        if (found == size_) {
+            return false;
+        }
+
+        frames_[heap_[found]] = frame;
+        return true;
+    }
+
+    /**
+     * @brief 最も優先度の高いフレームを参照する
+     *
+     * 空の場合に呼び出してはいけません。
+     *
+     * @return const Frame& 最も優先度の高いフレーム
+     */
+    const Frame& top() const
+    {
+        return frames_[heap_[0]];
+    }
+
+    /**
+     * @brief 最も優先度の高いフレームを削除する
+     */
+    void pop()
+    {
+        if (size_ == 0) {
+            return;
+        }
+
+        size_--;
+        free_[Capacity - 1 - size_] = heap_[0];
+        heap_[0]                    = heap_[size_];
+        sift_down(0);
+    }
+
+    /**
+     * @brief 格納されているフレーム数を取得する
+     *
+     * @return std::size_t フレーム数
+     */
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+    /**
+     * @brief 空か判定する
+     *
+     * @return true 空
+     * @return false 1つ以上格納されている
+     */
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    /**
+     * @brief 同時に格納されたフレーム数の最大値を取得する
+     *
+     * @return std::size_t 最大格納数の記録
+     */
+    std::size_t high_water_mark() const
+    {
+        return high_water_mark_;
+    }
+
+private:
+    bool higher(std::size_t a, std::size_t b) const
+    {
+        return orders_[heap_[a]] < orders_[heap_[b]];
+    }
+
+    void swap(std::size_t a, std::size_t b)
+    {
+        Index tmp = heap_[a];
+        heap_[a]  = heap_[b];
+        heap_[b]  = tmp;
+    }
+
+    void sift_up(std::size_t pos)
+    {
+        while (pos > 0) {
+            std::size_t parent = (pos - 1) / 2;
+            if (!higher(pos, parent)) {
+                return;
+            }
+            swap(pos, parent);
+            pos = parent;
+        }
+    }
+
+    void sift_down(std::size_t pos)
+    {
+        while (true) {
+            std::size_t best  = pos;
+            std::size_t left  = pos * 2 + 1;
+            std::size_t right = left + 1;
+            if (left < size_ && higher(left, best)) {
+                best = left;
+            }
+            if (right < size_ && higher(right, best)) {
+                best = right;
+            }
+            if (best == pos) {
+                return;
+            }
+            swap(pos, best);
+            pos = best;
+        }
+    }
+
+    std::array<Frame, Capacity> frames_{};   // スロットごとのフレーム
+    std::array<uint64_t, Capacity> orders_;  // スロットごとの取り出し順 (調停キー + 投入順)
+    std::array<Index, Capacity> heap_;       // 優先度順に並べたスロット番号 (二分ヒープ)
+    std::array<Index, Capacity> free_;       // 空きスロット番号 (末尾から size_ 個は使用中)
+    std::size_t size_            = 0;        // 格納されているフレーム数
+    std::size_t high_water_mark_ = 0;        // 最大格納数の記録
+    uint32_t sequence_           = 0;        // 投入順の通し番号
+};
+
+}  // namespace detail
+}  // namespace gn10_can
@@ -10,50 +10,119 @@
  */
 #pragma once
 
-#include <optional>
+#include <cstddef>
 
-#include "gn10_can/core/fdcan_bus.hpp"
-#include "gn10_can/core/fdcan_device.hpp"
+#include "gn10_can/core/can_device.hpp"
 #include "gn10_can/core/fdcan_frame.hpp"
+#include "gn10_can/core/mailbox.hpp"
+#include "gn10_can/devices/esc_hub_types.hpp"
 #include "gn10_can/devices/motor_driver_types.hpp"
+#include "gn10_can/utils/can_converter.hpp"
 
 namespace gn10_can {
 namespace devices {
 
-class ESCHubClient : public FDCANDevice
+/**
+ * @brief ESCHubのクライアント用デバイスクラス
+ * @details
+ * モーター数と角速度のエンコーディングはコンパイル時に決め、ESCHubServer と同じものを使用します。
+ * 全モーターの角速度を CAN FD の1フレームで送受信します。
+ * 全モーターの状態 (角速度・位置・電流・温度) は get_full_state_feedbacks() で1つのスナップショットとして
+ * 受け取ります (7モーターまで1フレーム)。
+ * | エンコーディング | 16モーターのデータ長 |
+ * | :--- | :--- |
+ * | schema::Raw<float> (既定) | 64バイト |
+ * | schema::Half / schema::Fixed<int16_t, ...> | 32バイト |
+ *
+ * @tparam MotorCount モーター数 (1 ~ 16)
+ * @tparam Encoding 角速度1つのエンコーディング (message_schema.hpp)
+ */
+template <std::size_t MotorCount = 4, typename Encoding = schema::Raw<float>>
+class BasicESCHubClient : public CANDevice
 {
+    using Layout = esc_hub::Layout<MotorCount, Encoding>;
+
 public:
+    static constexpr std::size_t MOTOR_COUNT = MotorCount;  // モーター数
+
+    // 角速度格納用構造体
+    struct AngularVelocityFeedbacks {
+        float angular_velocity_feedback[MotorCount];
+    };
+
+    // 全モーターの状態格納用構造体
+    struct FullStateFeedbacks {
+        esc_hub::MotorFullState motor[MotorCount];
+    };
+
     /**
      * @brief ESCHubClientのコンストラクタ
      * @details CANbusの登録とdevice_idの割り振りを行う
      */
-    ESCHubClient(FDCANBus& bus, uint8_t device_id);
+    BasicESCHubClient(CANBusBase& bus, uint8_t device_id)
+        : CANDevice(bus, id::DeviceType::ESCHub, device_id)
+    {
+        subscribe(
+            id::MsgTypeESCHub::AngularVelocitiesFeedbacks,
+            &BasicESCHubClient::on_angular_velocity_feedbacks
+        );
+        subscribe(
+            id::MsgTypeESCHub::FullStateFeedbacks, &BasicESCHubClient::on_full_state_feedbacks
+        );
+    }
 
     /**
      * @brief 各モータの設定を変更する関数
      *
-     * @param motor_id モーターのid（0,1,2,3）
+     * @param motor_id モーターのid（0 ~ MotorCount - 1）
      * @param config モーターの設定
      */
-    void set_init(const uint8_t motor_id, const MotorConfig& config);
+    void set_init(const uint8_t motor_id, const MotorConfig& config)
+    {
+        if (motor_id >= MotorCount) return;
+        FDCANFrame frame =
+            FDCANFrame::make(id::DeviceType::ESCHub, device_id_, id::MsgTypeESCHub::Init);
+        converter::pack(frame.data, 0, motor_id);
+        converter::pack(frame.data, 1, config);
+        frame.dlc = 16;
+        bus_.send_frame(frame);
+    }
 
     /**
      * @brief 各モータのゲインを設定する関数
      *
-     * @param motor_id モーターのid（0,1,2,3）
+     * @param motor_id モーターのid（0 ~ MotorCount - 1）
      * @param kp Pゲイン
      * @param ki Iゲイン
      * @param kd Dゲイン
      * @param ff フィードフォワードゲイン
      */
-    void set_gains(const uint8_t motor_id, float kp, float ki, float kd, float ff);
+    void set_gains(const uint8_t motor_id, float kp, float ki, float kd, float ff)
+    {
+        if (motor_id >= MotorCount) return;
+        FDCANFrame frame =
+            FDCANFrame::make(id::DeviceType::ESCHub, device_id_, id::MsgTypeESCHub::Gain);
+        const float gains[4] = {kp, ki, kd, ff};
+        converter::pack(frame.data, 0, motor_id);
+        converter::pack_array(frame.data, 1, gains, 4);
+        frame.dlc = 32;
+        bus_.send_frame(frame);
+    }
 
     /**
      * @brief　角速度を設定する変数
      *
-     * @param angular_velocities ４つ分のモーターの角速度の配列
+     * @param angular_velocities MotorCount 個分のモーターの角速度の配列
      */
-    void set_angular_velocities(float angular_velocities[4]);
+    void set_angular_velocities(const float angular_velocities[MotorCount])
+    {
+        FDCANFrame frame = FDCANFrame::make(
+            id::DeviceType::ESCHub, device_id_, id::MsgTypeESCHub::AngularVelocities
+        );
+        esc_hub::encode_values<Encoding>(angular_velocities, MotorCount, frame.data.data());
+        frame.dlc = Layout::VELOCITIES_DLC;
+        bus_.send_frame_latest(frame);
+    }
 
     /**
      * @brief 角速度を受け取る関数
@@ -62,21 +131,125 @@ public:
      * @return true すべての角速度を受け取ることができた
      * @return false すべての角速度を受け取ることができなかった。
      */
-    bool get_angular_velocity_feedbacks(float angular_velocity_feedbacks[4]);
+    bool get_angular_velocity_feedbacks(float angular_velocity_feedbacks[MotorCount])
+    {
+        AngularVelocityFeedbacks feedbacks;
+        if (angular_velocity_feedback_.take(feedbacks)) {
+            for (std::size_t i = 0; i < MotorCount; i++) {
+                angular_velocity_feedbacks[i] = feedbacks.angular_velocity_feedback[i];
+            }
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief 角速度のフィードバックのメールボックスを取得する
+     *
+     * 取り出す前に上書きされた回数や、最新の値の受信時刻の確認に使用します。
+     *
+     * @return const Mailbox<AngularVelocityFeedbacks>& 角速度のフィードバックのメールボックス
+     */
+    const Mailbox<AngularVelocityFeedbacks>& angular_velocity_feedback_mailbox() const
+    {
+        return angular_velocity_feedback_;
+    }
+
+    /**
+     * @brief 全モーターの状態を受け取る関数
+     * @details 複数のフレームに分かれる場合は、全モーター分がそろった時点で受け取れます。
+     *
+     * @param states MotorCount 個分のモーターの状態の格納先
+     * @return true 全モーターの新しい状態を受け取ることができた
+     * @return false 新しい状態を受け取ることができなかった
+     */
+    bool get_full_state_feedbacks(esc_hub::MotorFullState states[MotorCount])
+    {
+        FullStateFeedbacks feedbacks;
+        if (full_state_feedback_.take(feedbacks)) {
+            for (std::size_t i = 0; i < MotorCount; i++) {
+                states[i] = feedbacks.motor[i];
+            }
+            return true;
+        }
+        return false;
+    }
 
     /**
-     * @brief データをprivate関数に格納してあげる関数
+     * @brief 全モーターの状態のメールボックスを取得する
+     *
+     * 受信時刻は全モーター分がそろったフレームの受信時刻です。
+     *
+     * @return const Mailbox<FullStateFeedbacks>& 全モーターの状態のメールボックス
      */
-    void on_receive(const FDCANFrame& frame) override;
+    const Mailbox<FullStateFeedbacks>& full_state_feedback_mailbox() const
+    {
+        return full_state_feedback_;
+    }
 
 private:
-    // 角速度格納用構造体
-    struct AngularVelocityFeedbacks {
-        float angular_velocity_feedback[4];
-    };
+    /**
+     * @brief AngularVelocitiesFeedbacksフレームの受信ハンドラ
+     *
+     * @param frame 受信したCANパケット
+     */
+    void on_angular_velocity_feedbacks(const CANFrameView& frame)
+    {
+        if (frame.dlc < Layout::VELOCITIES_DLC) return;
+        AngularVelocityFeedbacks feedbacks;
+        esc_hub::decode_values<Encoding>(
+            frame.data, MotorCount, feedbacks.angular_velocity_feedback
+        );
+        angular_velocity_feedback_.post(feedbacks, frame.timestamp);
+    }
+
+    /**
+     * @brief FullStateFeedbacksフレームの受信ハンドラ
+     * @details
+     * 先頭のモーターIDが0のフレームから組み立て直し、最後のフレームまで順番に受信したら格納します。
+     * 順番どおりでないフレームを受信した場合は組み立て中の状態を捨てるため、異なる周期のフレームが
+     * 混ざったスナップショットは格納しません。
+     *
+     * @param frame 受信したCANパケット
+     */
+    void on_full_state_feedbacks(const CANFrameView& frame)
+    {
+        if (frame.dlc < 1) return;
+        const std::size_t first = frame.data[0];
+        if (first >= MotorCount || first % esc_hub::STATES_PER_FRAME != 0) return;
+        std::size_t count = MotorCount - first;
+        if (count > esc_hub::STATES_PER_FRAME) {
+            count = esc_hub::STATES_PER_FRAME;
+        }
+        if (frame.dlc < 1 + count * esc_hub::MotorFullStateSchema::DLC) return;
 
-    std::optional<AngularVelocityFeedbacks> angular_velocity_feedback_;
+        // 次に受信するはずのフレームでなければ組み立て直す
+        const std::size_t index = first / esc_hub::STATES_PER_FRAME;
+        if (index != next_state_frame_) {
+            next_state_frame_ = 0;
+            if (index != 0) return;
+        }
+        for (std::size_t i = 0; i < count; i++) {
+            esc_hub::MotorFullStateSchema::unpack(
+                frame.data + 1 + i * esc_hub::MotorFullStateSchema::DLC,
+                esc_hub::MotorFullStateSchema::DLC,
+                pending_states_.motor[first + i]
+            );
+        }
+        next_state_frame_ = index + 1;
+        if (next_state_frame_ == Layout::STATE_FRAMES) {
+            full_state_feedback_.post(pending_states_, frame.timestamp);
+            next_state_frame_ = 0;
+        }
+    }
+
+    Mailbox<AngularVelocityFeedbacks> angular_velocity_feedback_;
+    Mailbox<FullStateFeedbacks> full_state_feedback_;
+    FullStateFeedbacks pending_states_{};  // 組み立て中の全モーターの状態
+    std::size_t next_state_frame_ = 0;     // 次に受信するフレームの番号 (先頭のモーターID / STATES_PER_FRAME)
 };
 
+using ESCHubClient = BasicESCHubClient<>;
+
 }  // namespace devices
-}  // namespace gn10_can
\ No newline at end of file
+}  // namespace gn10_can
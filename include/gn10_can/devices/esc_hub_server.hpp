@@ -1,38 +1,67 @@
 #pragma once
 
-#include <optional>
+#include <cstddef>
 
-#include "gn10_can/core/fdcan_bus.hpp"
-#include "gn10_can/core/fdcan_device.hpp"
+#include "gn10_can/core/can_device.hpp"
 #include "gn10_can/core/fdcan_frame.hpp"
+#include "gn10_can/core/mailbox.hpp"
+#include "gn10_can/devices/esc_hub_types.hpp"
 #include "gn10_can/devices/motor_driver_types.hpp"
+#include "gn10_can/utils/can_converter.hpp"
 
 namespace gn10_can {
 namespace devices {
 
-class ESCHubServer : public FDCANDevice
+/**
+ * @brief ESCHubのサーバー用デバイスクラス
+ * @details モーター数と角速度のエンコーディングは BasicESCHubClient と同じものを使用します。
+ *
+ * @tparam MotorCount モーター数 (1 ~ 16)
+ * @tparam Encoding 角速度1つのエンコーディング (message_schema.hpp)
+ */
+template <std::size_t MotorCount = 4, typename Encoding = schema::Raw<float>>
+class BasicESCHubServer : public CANDevice
 {
+    using Layout = esc_hub::Layout<MotorCount, Encoding>;
+
 public:
+    static constexpr std::size_t MOTOR_COUNT = MotorCount;  // モーター数
+
+    // 角速度格納用構造体
+    struct AngularVelocities {
+        float angular_velocity[MotorCount];
+    };
+
     /**
      * @brief ESCHubServerのコンストラクタ
      * @details CANbusの登録とdevice_idの割り振りを行う
      */
-    ESCHubServer(FDCANBus& bus, uint8_t device_id);
+    BasicESCHubServer(CANBusBase& bus, uint8_t device_id)
+        : CANDevice(bus, id::DeviceType::ESCHub, device_id)
+    {
+        subscribe(id::MsgTypeESCHub::Init, &BasicESCHubServer::on_init);
+        subscribe(id::MsgTypeESCHub::Gain, &BasicESCHubServer::on_gain);
+        subscribe(id::MsgTypeESCHub::AngularVelocities, &BasicESCHubServer::on_angular_velocities);
+    }
 
     /**
      * @brief 各モータの設定を取得する関数
      *
-     * @param motor_id モーターのid（0,1,2,3）
+     * @param motor_id モーターのid（0 ~ MotorCount - 1）
      * @param config モーターの設定
      * @return true 新たな設定に更新した
      * @return false 新たな設定に更新できなかった
      */
-    bool get_init(const uint8_t motor_id, MotorConfig& config);
+    bool get_init(const uint8_t motor_id, MotorConfig& config)
+    {
+        if (motor_id >= MotorCount) return false;
+        return config_[motor_id].take(config);
+    }
 
     /**
      * @brief 各モータのゲインを取得する関数
      *
-     * @param motor_id モーターのid（0,1,2,3）
+     * @param motor_id モーターのid（0 ~ MotorCount - 1）
      * @param kp Pゲイン
      * @param ki Iゲイン
      * @param kd Dゲイン
@@ -40,44 +69,160 @@ public:
      * @return true 新たなゲインに更新した
      * @return false 新たなゲインに更新できなかった
      */
-    bool get_gains(const uint8_t motor_id, float& kp, float& ki, float& kd, float& ff);
+    bool get_gains(const uint8_t motor_id, float& kp, float& ki, float& kd, float& ff)
+    {
+        if (motor_id >= MotorCount) return false;
+        Gains gains;
+        if (gains_[motor_id].take(gains)) {
+            kp = gains.kp;
+            ki = gains.ki;
+            kd = gains.kd;
+            ff = gains.ff;
+            return true;
+        }
+        return false;
+    }
 
     /**
      * @brief 受け取った角速度にアクセスする関数（すべてできる）
      *
-     * @param angular_velocities ４つ分のモーターの角速度の配列
+     * @param angular_velocities MotorCount 個分のモーターの角速度の配列
      * @return true すべての角速度を受け取ることができた
      * @return false すべての角速度を受け取ることができなかった。
      */
-    bool get_angular_velocities(float angular_velocities[4]);
+    bool get_angular_velocities(float angular_velocities[MotorCount])
+    {
+        AngularVelocities received;
+        if (angular_velocity_.take(received)) {
+            for (std::size_t i = 0; i < MotorCount; i++) {
+                angular_velocities[i] = received.angular_velocity[i];
+            }
+            return true;
+        }
+        return false;
+    }
 
     /**
      * @brief motorの角速度のfeedbackを送信する関数
      *
-     * @param angular_velocity_feedbacks ４つ分のモーターの実際回っている角速度の配列
+     * @param angular_velocity_feedbacks MotorCount 個分のモーターの実際回っている角速度の配列
+     */
+    void set_angular_velocity_feedbacks(const float angular_velocity_feedbacks[MotorCount])
+    {
+        FDCANFrame frame = FDCANFrame::make(
+            id::DeviceType::ESCHub, device_id_, id::MsgTypeESCHub::AngularVelocitiesFeedbacks
+        );
+        esc_hub::encode_values<Encoding>(angular_velocity_feedbacks, MotorCount, frame.data.data());
+        frame.dlc = Layout::VELOCITIES_DLC;
+        bus_.send_frame(frame);
+    }
+
+    /**
+     * @brief 全モーターの状態 (角速度・位置・電流・温度) のfeedbackを送信する関数
+     * @details
+     * FullStateFeedbacks フレームで送信します。1フレームに esc_hub::STATES_PER_FRAME (7) 台分が入り、
+     * それを超えるモーター数では複数のフレームに分けて送信します。
+     *
+     * @param states MotorCount 個分のモーターの状態の配列
      */
-    void set_angular_velocity_feedbacks(float angular_velocity_feedbacks[4]);
+    void set_full_state_feedbacks(const esc_hub::MotorFullState states[MotorCount])
+    {
+        for (std::size_t first = 0; first < MotorCount; first += esc_hub::STATES_PER_FRAME) {
+            std::size_t count = MotorCount - first;
+            if (count > esc_hub::STATES_PER_FRAME) {
+                count = esc_hub::STATES_PER_FRAME;
+            }
+            FDCANFrame frame = FDCANFrame::make(
+                id::DeviceType::ESCHub, device_id_, id::MsgTypeESCHub::FullStateFeedbacks
+            );
+            frame.data[0] = static_cast<uint8_t>(first);
+            for (std::size_t i = 0; i < count; i++) {
+                esc_hub::MotorFullStateSchema::pack(
+                    states[first + i], &frame.data[1 + i * esc_hub::MotorFullStateSchema::DLC]
+                );
+            }
+            frame.dlc = static_cast<uint8_t>(1 + count * esc_hub::MotorFullStateSchema::DLC);
+            bus_.send_frame(frame);
+        }
+    }
 
     /**
-     * @brief データをprivate関数に格納してあげる関数
+     * @brief 角速度の目標値のメールボックスを取得する
+     *
+     * 取り出す前に上書きされた回数や、最新の値の受信時刻の確認に使用します。
+     *
+     * @return const Mailbox<AngularVelocities>& 角速度の目標値のメールボックス
      */
-    void on_receive(const FDCANFrame& frame) override;
+    const Mailbox<AngularVelocities>& angular_velocity_mailbox() const
+    {
+        return angular_velocity_;
+    }
 
 private:
-    // 角速度格納用構造体
-    struct AngularVelocities {
-        float angular_velocity[4];
-    };
+    /**
+     * @brief Initフレームの受信ハンドラ
+     *
+     * @param frame 受信したCANパケット
+     */
+    void on_init(const CANFrameView& frame)
+    {
+        if (frame.dlc < 1 + sizeof(MotorConfig)) return;
+        MotorConfig config;
+        uint8_t motor_id;
+        bool success_unpack = true;
+        success_unpack &= converter::unpack(frame.data, frame.dlc, 0, motor_id);
+        success_unpack &= converter::unpack(frame.data, frame.dlc, 1, config);
+        if (motor_id >= MotorCount || !success_unpack) return;
+        config_[motor_id].post(config, frame.timestamp);
+    }
+
+    /**
+     * @brief Gainフレームの受信ハンドラ
+     *
+     * @param frame 受信したCANパケット
+     */
+    void on_gain(const CANFrameView& frame)
+    {
+        uint8_t motor_id;
+        float values[4];
+        if (!converter::unpack(frame.data, frame.dlc, 0, motor_id) ||
+            !converter::unpack_array(frame.data, frame.dlc, 1, values, 4)) {
+            return;
+        }
+        if (motor_id >= MotorCount) return;
+        Gains gains;
+        gains.kp = values[0];
+        gains.ki = values[1];
+        gains.kd = values[2];
+        gains.ff = values[3];
+        gains_[motor_id].post(gains, frame.timestamp);
+    }
+
+    /**
+     * @brief AngularVelocitiesフレームの受信ハンドラ
+     *
+     * @param frame 受信したCANパケット
+     */
+    void on_angular_velocities(const CANFrameView& frame)
+    {
+        if (frame.dlc < Layout::VELOCITIES_DLC) return;
+        AngularVelocities received;
+        esc_hub::decode_values<Encoding>(frame.data, MotorCount, received.angular_velocity);
+        angular_velocity_.post(received, frame.timestamp);
+    }
+
     struct Gains {
         float kp;
         float ki;
         float kd;
         float ff;
     };
-    std::optional<AngularVelocities> angular_velocity_;
-    std::optional<MotorConfig> config_[4];
-    std::optional<Gains> gains_[4];
+    Mailbox<AngularVelocities> angular_velocity_;
+    Mailbox<MotorConfig> config_[MotorCount];
+    Mailbox<Gains> gains_[MotorCount];
 };
 
+using ESCHubServer = BasicESCHubServer<>;
+
 }  // namespace devices
-}  // namespace gn10_can
\ No newline at end of file
+}  // namespace gn10_can
@@ -0,0 +1,113 @@
+/**
+ * @file esc_hub_types.hpp
+ * @author Gento Aiba (aiba-gento)
+ * @brief ESCHub の Client / Server で共有する定数とペイロードの変換
+ * @version 0.1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026 Gento Aiba
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ratio>
+#include <type_traits>
+
+#include "gn10_can/core/can_frame.hpp"
+#include "gn10_can/utils/can_converter.hpp"
+#include "gn10_can/utils/message_schema.hpp"
+
+namespace gn10_can {
+namespace devices {
+
+namespace esc_hub {
+
+static constexpr std::size_t MAX_MOTORS = 16;  // 1台の ESCHub が扱えるモーター数の上限
+
+/**
+ * @brief 1モーター分の状態
+ * @details FullStateFeedbacks フレームで全モーター分をまとめて送信します。
+ */
+struct MotorFullState {
+    float angular_velocity = 0.0f;  ///< @brief 角速度 [rad/s] (半精度で送信、有効桁数は約3桁)
+    float position         = 0.0f;  ///< @brief 多回転の位置 [rad] (0.001 rad 単位、±約2.1e6 rad)
+    float current          = 0.0f;  ///< @brief 電流 [A] (半精度で送信、有効桁数は約3桁)
+    int8_t temperature     = 0;     ///< @brief 温度 [℃]
+};
+
+/**
+ * @brief MotorFullState 1つ分のペイロードの配置 (9バイト)
+ * @details [angular_velocity: 半精度 (2) | position: int32_t (4) | current: 半精度 (2) |
+ *          temperature (1)]、いずれもリトルエンディアン
+ */
+using MotorFullStateSchema = schema::Message<
+    MotorFullState,
+    schema::Field<&MotorFullState::angular_velocity, schema::Half>,
+    schema::Field<&MotorFullState::position, schema::Fixed<int32_t, std::milli>>,
+    schema::Field<&MotorFullState::current, schema::Half>,
+    schema::Field<&MotorFullState::temperature>>;
+
+/**
+ * @brief FullStateFeedbacks フレーム1つに入るモーター数
+ * @details 先頭1バイトはフレームに含まれる最初のモーターIDです。
+ */
+static constexpr std::size_t STATES_PER_FRAME =
+    (CANFrameView::MAX_DLC - 1) / MotorFullStateSchema::DLC;
+
+/**
+ * @brief モーター数とエンコーディングが1フレームに収まるか確認する
+ *
+ * @tparam MotorCount モーター数
+ * @tparam Encoding 角速度1つのエンコーディング (message_schema.hpp)
+ */
+template <std::size_t MotorCount, typename Encoding>
+struct Layout {
+    static_assert(MotorCount > 0 && MotorCount <= MAX_MOTORS, "MotorCount must be 1 to 16");
+    static_assert(std::is_same<typename Encoding::Value, float>::value,
+                  "Encoding must encode a float");
+    static_assert(MotorCount * Encoding::SIZE <= CANFrameView::MAX_DLC,
+                  "Angular velocities exceed the CAN FD payload (64 bytes)");
+
+    static constexpr std::size_t VELOCITIES_DLC = MotorCount * Encoding::SIZE;  // 角速度のデータ長
+    static constexpr std::size_t STATE_FRAMES =
+        (MotorCount + STATES_PER_FRAME - 1) / STATES_PER_FRAME;  // 全状態の送信に必要なフレーム数
+};
+
+/**
+ * @brief 角速度の配列をエンコードする
+ *
+ * @tparam Encoding 角速度1つのエンコーディング
+ * @param values 角速度の配列
+ * @param count 要素数
+ * @param out 書き込み先 (count * Encoding::SIZE バイト以上)
+ */
+template <typename Encoding>
+void encode_values(const float* values, std::size_t count, uint8_t* out)
+{
+    for (std::size_t i = 0; i < count; i++) {
+        Encoding::encode(values[i], out + i * Encoding::SIZE);
+    }
+}
+
+/**
+ * @brief 角速度の配列をデコードする
+ *
+ * @tparam Encoding 角速度1つのエンコーディング
+ * @param in 受信データ (count * Encoding::SIZE バイト以上)
+ * @param count 要素数
+ * @param out_values 角速度の配列の格納先
+ */
+template <typename Encoding>
+void decode_values(const uint8_t* in, std::size_t count, float* out_values)
+{
+    for (std::size_t i = 0; i < count; i++) {
+        Encoding::decode(in + i * Encoding::SIZE, out_values[i]);
+    }
+}
+
+}  // namespace esc_hub
+
+}  // namespace devices
+}  // namespace gn10_can
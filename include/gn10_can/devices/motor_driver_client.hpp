@@ -28,10 +28,10 @@ public:
     /**
      * @brief モータードライバー用デバイスクラスのコンストラクタ
      *
-     * @param bus CANBusクラスの参照
+     * @param bus CANBus / FDCANBusクラスの参照
      * @param dev_id デバイスID
      */
-    MotorDriverClient(CANBus& bus, uint8_t dev_id);
+    MotorDriverClient(CANBusBase& bus, uint8_t dev_id);
 
     /**
      * @brief モータードライバー初期化コマンド送信関数
@@ -55,13 +55,6 @@ public:
      */
     void set_gain(devices::GainType type, float value);
 
-    /**
-     * @brief CANパケット受信時の呼び出し関数の実装
-     *
-     * @param frame 受信したCANパケット
-     */
-    void on_receive(const CANFrame& frame) override;
-
     /**
      * @brief 最新のフィードバック値を取得する
      *
@@ -90,6 +83,29 @@ public:
     int8_t temperature() const;
 
 private:
+    /**
+     * @brief Feedbackフレームの受信ハンドラ
+     *
+     * @param frame 受信したCANパケット
+     */
+    void on_feedback(const CANFrameView& frame);
+
+    /**
+     * @brief HardwareStatusフレームの受信ハンドラ
+     *
+     * @param frame 受信したCANパケット
+     */
+    void on_hardware_status(const CANFrameView& frame);
+
+    /**
+     * @brief Stateフレームの受信ハンドラ
+     *
+     * Feedback と HardwareStatus の両方の値を更新します。
+     *
+     * @param frame 受信したCANパケット
+     */
+    void on_state(const CANFrameView& frame);
+
     float feedback_value_{0.0f};
     uint8_t limit_switches_{0};
     float load_current_{0.0f};
@@ -0,0 +1,189 @@
+/**
+ * @file motor_driver_group.hpp
+ * @author Gento Aiba (aiba-gento)
+ * @brief 複数のモータードライバーの目標値を1フレームで送るグループ送信のヘッダーファイル
+ * @version 0.1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026 Gento Aiba
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "gn10_can/core/can_device.hpp"
+#include "gn10_can/devices/motor_driver_server.hpp"
+#include "gn10_can/utils/message_schema.hpp"
+
+namespace gn10_can {
+namespace devices {
+
+/**
+ * @brief 複数のモータードライバーの目標値をまとめて送信するクラス (制御側)
+ * @details
+ * グループの目標値を GroupTarget フレーム1つに並べて送信します。i 番目の目標値はスロット i に入り、
+ * 各モータードライバーは BasicMotorDriverGroupMember で自身のスロットだけを取り出します。
+ * モーターごとに set_target() を呼ぶ場合と比べてフレーム数が減り、各モーターが目標値を受け取る
+ * 時刻のずれもなくなります。
+ *
+ * グループIDはモータードライバーのデバイスIDと同じ範囲 (0 ~ 15) で、同じ値のデバイスIDの
+ * モータードライバーとは別のコマンド (GroupTarget) で区別します。
+ *
+ * 1フレームに入るスロット数はエンコーディングとバスの最大データ長で決まります。
+ * | エンコーディング | CAN (8バイト) | CAN FD (64バイト) |
+ * | :--- | :--- | :--- |
+ * | schema::Raw<float> (既定) | 2 | 16 |
+ * | schema::Half / schema::Fixed<int16_t, ...> | 4 | 32 |
+ *
+ * @code
+ * // 0.01 単位の int16_t (±327.67) で4モーター分を CAN の1フレームに入れる
+ * using Encoding = schema::Fixed<int16_t, std::centi>;
+ * BasicMotorDriverGroupClient<Encoding> drivetrain(bus, 0);
+ * drivetrain.set_targets(std::array<float, 4>{1.0f, -1.0f, 1.0f, -1.0f});
+ * @endcode
+ *
+ * @tparam Encoding 目標値1つのエンコーディング (message_schema.hpp、受信側と同じもの)
+ */
+template <typename Encoding = schema::Raw<float>>
+class BasicMotorDriverGroupClient : public CANDevice
+{
+public:
+    static_assert(std::is_same<typename Encoding::Value, float>::value,
+                  "Encoding must encode a float");
+
+    static constexpr std::size_t SLOT_SIZE = Encoding::SIZE;                     // スロットのバイト数
+    static constexpr std::size_t MAX_SLOTS = CANFrameView::MAX_DLC / SLOT_SIZE;  // 最大スロット数
+
+    /**
+     * @brief コンストラクタ
+     *
+     * @param bus CANBus / FDCANBusクラスの参照
+     * @param group_id グループID
+     */
+    BasicMotorDriverGroupClient(CANBusBase& bus, uint8_t group_id)
+        : CANDevice(bus, id::DeviceType::MotorDriver, group_id)
+    {
+        // 受信するコマンドはない
+        set_command_mask(0);
+    }
+
+    /**
+     * @brief グループの目標値を送信する
+     *
+     * 送信待ちの GroupTarget フレームがあれば新しい目標値で置き換えます (set_target() と同じ)。
+     *
+     * @param targets スロット順の目標値
+     * @param count 目標値の数 (1 ~ バスの最大データ長 / SLOT_SIZE)
+     * @return true 送信成功、または送信キューに保持
+     * @return false 送信失敗（バスの最大データ長超過、送信キューが満杯など）
+     */
+    bool set_targets(const float* targets, std::size_t count)
+    {
+        if (count == 0 || count > MAX_SLOTS) {
+            return false;
+        }
+        std::array<uint8_t, CANFrameView::MAX_DLC> payload{};
+        for (std::size_t i = 0; i < count; i++) {
+            Encoding::encode(targets[i], &payload[i * SLOT_SIZE]);
+        }
+        return send_latest(id::MsgTypeMotorDriver::GroupTarget, payload.data(), count * SLOT_SIZE);
+    }
+
+    /**
+     * @brief グループの目標値を送信する (array版)
+     *
+     * @tparam N 目標値の数
+     * @param targets スロット順の目標値
+     * @return true 送信成功、または送信キューに保持
+     * @return false 送信失敗（バスの最大データ長超過、送信キューが満杯など）
+     */
+    template <std::size_t N>
+    bool set_targets(const std::array<float, N>& targets)
+    {
+        static_assert(N > 0 && N <= MAX_SLOTS, "Too many targets for one frame");
+        return set_targets(targets.data(), N);
+    }
+};
+
+/**
+ * @brief グループの目標値から自身のスロットを取り出すクラス (モータードライバー側)
+ * @details
+ * GroupTarget フレームを受信すると自身のスロットの目標値を取り出し、MotorDriverServer に
+ * Target フレームを受信した場合と同じように渡します。制御ループは従来通り
+ * MotorDriverServer::get_new_target() で目標値を取り出せます。
+ * フレームが自身のスロットを含まない (目標値の数が少ない) 場合は何もしません。
+ *
+ * @code
+ * MotorDriverServer server(bus, 2);
+ * MotorDriverGroupMember member(bus, 0, 2, server);  // グループ0のスロット2
+ * @endcode
+ *
+ * @tparam Encoding 目標値1つのエンコーディング (送信側と同じもの)
+ */
+template <typename Encoding = schema::Raw<float>>
+class BasicMotorDriverGroupMember : public CANDevice
+{
+public:
+    static_assert(std::is_same<typename Encoding::Value, float>::value,
+                  "Encoding must encode a float");
+
+    static constexpr std::size_t SLOT_SIZE = Encoding::SIZE;  // スロットのバイト数
+
+    /**
+     * @brief コンストラクタ
+     *
+     * @param bus CANBus / FDCANBusクラスの参照
+     * @param group_id グループID
+     * @param slot グループ内のスロット番号
+     * @param server 目標値を渡すモータードライバー
+     */
+    BasicMotorDriverGroupMember(
+        CANBusBase& bus, uint8_t group_id, uint8_t slot, MotorDriverServer& server
+    )
+        : CANDevice(bus, id::DeviceType::MotorDriver, group_id), slot_(slot), server_(server)
+    {
+        subscribe(
+            id::MsgTypeMotorDriver::GroupTarget, &BasicMotorDriverGroupMember::on_group_target
+        );
+    }
+
+    /**
+     * @brief グループ内のスロット番号を取得する
+     *
+     * @return uint8_t スロット番号
+     */
+    uint8_t slot() const
+    {
+        return slot_;
+    }
+
+private:
+    /**
+     * @brief GroupTargetフレームの受信ハンドラ
+     *
+     * @param frame 受信したCANパケット
+     */
+    void on_group_target(const CANFrameView& frame)
+    {
+        const std::size_t offset = static_cast<std::size_t>(slot_) * SLOT_SIZE;
+        if (offset + SLOT_SIZE > frame.dlc) {
+            return;
+        }
+        float target;
+        Encoding::decode(frame.data + offset, target);
+        server_.target_.post(target, frame.timestamp);
+    }
+
+    uint8_t slot_;               // グループ内のスロット番号
+    MotorDriverServer& server_;  // 目標値を渡すモータードライバー
+};
+
+using MotorDriverGroupClient = BasicMotorDriverGroupClient<>;
+using MotorDriverGroupMember = BasicMotorDriverGroupMember<>;
+
+}  // namespace devices
+}  // namespace gn10_can
@@ -10,14 +10,16 @@
  */
 #pragma once
 
-#include <optional>
-
 #include "gn10_can/core/can_device.hpp"
+#include "gn10_can/core/mailbox.hpp"
 #include "gn10_can/devices/motor_driver_types.hpp"
 
 namespace gn10_can {
 namespace devices {
 
+template <typename Encoding>
+class BasicMotorDriverGroupMember;
+
 /**
  * @brief モータードライバー用デバイスクラス
  *
@@ -28,10 +30,10 @@ public:
     /**
      * @brief モータードライバー用デバイスクラスのコンストラクタ
      *
-     * @param bus CANBusクラスの参照
+     * @param bus CANBus / FDCANBusクラスの参照
      * @param dev_id デバイスID
      */
-    MotorDriverServer(CANBus& bus, uint8_t dev_id);
+    MotorDriverServer(CANBusBase& bus, uint8_t dev_id);
 
     /**
      * @brief モータードライバーフィードバック送信関数
@@ -49,6 +51,16 @@ public:
      */
     void send_hardware_status(float load_current, int8_t temperature);
 
+    /**
+     * @brief モータードライバー状態一括送信関数
+     *
+     * send_feedback() と send_hardware_status() の内容を1フレーム (8バイト) で送信します。
+     * 負荷電流は半精度浮動小数点数で送信します (MotorStateSchema)。
+     *
+     * @param state 現在値・負荷電流・温度・リミットスイッチ状態
+     */
+    void send_state(const MotorState& state);
+
     /**
      * @brief 新しい設定があれば更新する
      *
@@ -78,18 +90,45 @@ public:
     bool get_new_gain(GainType type, float& value);
 
     /**
-     * @brief CANパケット受信時の呼び出し関数の実装
+     * @brief 目標値のメールボックスを取得する
      *
-     * @param frame 受信したCANパケット
+     * 取り出す前に上書きされた回数や、最新の値の受信時刻の確認に使用します。
+     *
+     * @return const Mailbox<float>& 目標値のメールボックス
      */
-    void on_receive(const CANFrame& frame) override;
+    const Mailbox<float>& target_mailbox() const;
 
 private:
+    // グループの目標値を target_ に渡す
+    template <typename Encoding>
+    friend class BasicMotorDriverGroupMember;
+
+    /**
+     * @brief Initフレームの受信ハンドラ
+     *
+     * @param frame 受信したCANパケット
+     */
+    void on_init(const CANFrameView& frame);
+
+    /**
+     * @brief Targetフレームの受信ハンドラ
+     *
+     * @param frame 受信したCANパケット
+     */
+    void on_target(const CANFrameView& frame);
+
+    /**
+     * @brief Gainフレームの受信ハンドラ
+     *
+     * @param frame 受信したCANパケット
+     */
+    void on_gain(const CANFrameView& frame);
+
     static constexpr std::size_t kGainTypeCount = static_cast<std::size_t>(GainType::Count);
 
-    std::optional<MotorConfig> config_;
-    std::optional<float> target_;
-    std::optional<float> gains_[kGainTypeCount];
+    Mailbox<MotorConfig> config_;
+    Mailbox<float> target_;
+    Mailbox<float> gains_[kGainTypeCount];
 };
 }  // namespace devices
 }  // namespace gn10_can
@@ -15,6 +15,8 @@
 #include <cstdint>
 #include <cstring>
 
+#include "gn10_can/utils/message_schema.hpp"
+
 namespace gn10_can {
 namespace devices {
 
@@ -222,5 +224,30 @@ private:
     PackedData data_{};
 };
 
+/**
+ * @brief モータードライバーの状態 (State フレームの内容)
+ * @details
+ * Feedback と HardwareStatus の内容を1フレームにまとめたものです。
+ */
+struct MotorState {
+    float feedback         = 0.0f;  ///< @brief 現在値 (速度制御の場合は速度、位置制御の場合は位置)
+    float load_current     = 0.0f;  ///< @brief 負荷電流 (半精度で送信、有効桁数は約3桁)
+    int8_t temperature     = 0;     ///< @brief 温度
+    uint8_t limit_switches = 0;     ///< @brief リミットスイッチ状態 (ビットマップ形式)
+};
+
+/**
+ * @brief State フレームのペイロードの配置 (8バイト)
+ * @details [feedback: float (4) | load_current: 半精度 (2) | temperature (1) | limit_switches (1)]
+ */
+using MotorStateSchema = schema::Message<
+    MotorState,
+    schema::Field<&MotorState::feedback>,
+    schema::Field<&MotorState::load_current, schema::Half>,
+    schema::Field<&MotorState::temperature>,
+    schema::Field<&MotorState::limit_switches>>;
+
+static_assert(MotorStateSchema::DLC == 8, "State must fit in a classic CAN frame");
+
 }  // namespace devices
 }  // namespace gn10_can
\ No newline at end of file
@@ -1,16 +1,15 @@
 #pragma once
-#include <optional>
-
-#include "gn10_can/core/fdcan_device.hpp"
+#include "gn10_can/core/can_device.hpp"
+#include "gn10_can/core/mailbox.hpp"
 #include "gn10_can/devices/power_manager_types.hpp"
 
 namespace gn10_can {
 namespace devices {
 
-class PowerManagerClient : public FDCANDevice
+class PowerManagerClient : public CANDevice
 {
 public:
-    PowerManagerClient(FDCANBus& bus, uint8_t dev_id);
+    PowerManagerClient(CANBusBase& bus, uint8_t dev_id);
 
     void set_init(power_manager::Config config);
 
@@ -20,11 +19,17 @@ public:
 
     bool get_new_sensor(power_manager::Sensor& sensor);
 
-    void on_receive(const FDCANFrame& frame) override;
+    const Mailbox<power_manager::Status>& status_mailbox() const;
+
+    const Mailbox<power_manager::Sensor>& sensor_mailbox() const;
 
 private:
-    std::optional<power_manager::Status> status_{};
-    std::optional<power_manager::Sensor> sensor_{};
+    void on_status(const CANFrameView& frame);
+
+    void on_sensor(const CANFrameView& frame);
+
+    Mailbox<power_manager::Status> status_;
+    Mailbox<power_manager::Sensor> sensor_;
 };
 }  // namespace devices
 }  // namespace gn10_can
\ No newline at end of file
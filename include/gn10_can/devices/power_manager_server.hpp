@@ -1,16 +1,15 @@
 #pragma once
-#include <optional>
-
-#include "gn10_can/core/fdcan_device.hpp"
+#include "gn10_can/core/can_device.hpp"
+#include "gn10_can/core/mailbox.hpp"
 #include "gn10_can/devices/power_manager_types.hpp"
 
 namespace gn10_can {
 namespace devices {
 
-class PowerManagerServer : public FDCANDevice
+class PowerManagerServer : public CANDevice
 {
 public:
-    PowerManagerServer(FDCANBus& bus, uint8_t dev_id);
+    PowerManagerServer(CANBusBase& bus, uint8_t dev_id);
 
     bool get_new_init(power_manager::Config& config);
 
@@ -20,11 +19,13 @@ public:
 
     void set_sensor(power_manager::Sensor sensor);
 
-    void on_receive(const FDCANFrame& frame) override;
-
 private:
-    std::optional<power_manager::Config> config_{};
-    std::optional<bool> enable_stop_{};
+    void on_init(const CANFrameView& frame);
+
+    void on_stop(const CANFrameView& frame);
+
+    Mailbox<power_manager::Config> config_;
+    Mailbox<bool> enable_stop_;
 };
 }  // namespace devices
 }  // namespace gn10_can
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 #include <cstdint>
 
+#include "gn10_can/utils/message_schema.hpp"
+
 namespace gn10_can {
 namespace devices {
 
@@ -34,6 +36,24 @@ struct Sensor {
     float voltage;
     float current;
 };
+
+// 送信側と受信側で共有するペイロードの配置
+using ConfigSchema = schema::Message<
+    Config,
+    schema::Field<&Config::use_remote_emergency_stop>,
+    schema::Field<&Config::sensor_rate_ms>>;
+
+using StatusSchema = schema::Message<
+    Status,
+    schema::Field<&Status::emergency_stop_enabled>,
+    schema::Field<&Status::remote_emergency_stop_connected>,
+    schema::Field<&Status::remote_emergency_stop_enabled>,
+    schema::Field<&Status::over_current>>;
+
+using SensorSchema = schema::Message<
+    Sensor,
+    schema::Field<&Sensor::voltage>,
+    schema::Field<&Sensor::current>>;
 }  // namespace power_manager
 
 }  // namespace devices
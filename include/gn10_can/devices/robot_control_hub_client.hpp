@@ -9,9 +9,9 @@
  *
  */
 #pragma once
-#include <optional>
-
-#include "gn10_can/core/fdcan_device.hpp"
+#include "gn10_can/core/can_device.hpp"
+#include "gn10_can/core/fdcan_frame.hpp"
+#include "gn10_can/core/mailbox.hpp"
 #include "gn10_can/utils/can_converter.hpp"
 
 namespace gn10_can {
@@ -24,14 +24,15 @@ namespace devices {
  * @tparam Feedback フィードバックのデータ構造体
  */
 template <typename Command, typename Feedback>
-class RobotControlHubClient : public FDCANDevice
+class RobotControlHubClient : public CANDevice
 {
 public:
-    RobotControlHubClient(FDCANBus& bus, uint8_t dev_id)
-        : FDCANDevice(bus, id::DeviceType::RobotControlHub, dev_id)
+    RobotControlHubClient(CANBusBase& bus, uint8_t dev_id)
+        : CANDevice(bus, id::DeviceType::RobotControlHub, dev_id)
     {
         static_assert(sizeof(Command) <= 64, "Command size exceeds FDCAN limit (64bytes)");
         static_assert(sizeof(Feedback) <= 64, "Feedback size exceeds FDCAN limit (64bytes)");
+        subscribe(id::MsgTypeRobotControlHub::Feedback, &RobotControlHubClient::on_feedback);
     }
 
     void send_command(const Command& command)
@@ -46,29 +47,33 @@ public:
 
     bool get_feedback(Feedback& feedback)
     {
-        if (feedback_.has_value()) {
-            feedback = feedback_.value();
-            feedback_.reset();
-            return true;
-        }
-        return false;
+        return feedback_.take(feedback);
     }
 
-    void on_receive(const FDCANFrame& frame) override
+    /**
+     * @brief フィードバックのメールボックスを取得する
+     *
+     * 取り出す前に上書きされた回数や、最新の値の受信時刻の確認に使用します。
+     *
+     * @return const Mailbox<Feedback>& フィードバックのメールボックス
+     */
+    const Mailbox<Feedback>& feedback_mailbox() const
     {
-        auto id_fields = id::unpack(frame.id);
-        if (id_fields.is_command(id::MsgTypeRobotControlHub::Feedback)) {
-            if (frame.dlc == sizeof(Feedback)) {
-                Feedback feedback;
-                if (converter::unpack(frame.data.data(), frame.dlc, 0, feedback)) {
-                    feedback_ = feedback;
-                }
+        return feedback_;
+    }
+
+private:
+    void on_feedback(const CANFrameView& frame)
+    {
+        if (frame.dlc == sizeof(Feedback)) {
+            Feedback feedback;
+            if (converter::unpack(frame.data, frame.dlc, 0, feedback)) {
+                feedback_.post(feedback, frame.timestamp);
             }
         }
     }
 
-private:
-    std::optional<Feedback> feedback_;
+    Mailbox<Feedback> feedback_;
 };
 
 }  // namespace devices
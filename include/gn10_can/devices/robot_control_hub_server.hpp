@@ -9,9 +9,9 @@
  *
  */
 #pragma once
-#include <optional>
-
-#include "gn10_can/core/fdcan_device.hpp"
+#include "gn10_can/core/can_device.hpp"
+#include "gn10_can/core/fdcan_frame.hpp"
+#include "gn10_can/core/mailbox.hpp"
 #include "gn10_can/utils/can_converter.hpp"
 
 namespace gn10_can {
@@ -24,24 +24,32 @@ namespace devices {
  * @tparam Feedback フィードバックのデータ構造体
  */
 template <typename Command, typename Feedback>
-class RobotControlHubServer : public FDCANDevice
+class RobotControlHubServer : public CANDevice
 {
 public:
-    RobotControlHubServer(FDCANBus& bus, uint8_t dev_id)
-        : FDCANDevice(bus, id::DeviceType::RobotControlHub, dev_id)
+    RobotControlHubServer(CANBusBase& bus, uint8_t dev_id)
+        : CANDevice(bus, id::DeviceType::RobotControlHub, dev_id)
     {
         static_assert(sizeof(Command) <= 64, "Command size exceeds FDCAN limit (64bytes)");
         static_assert(sizeof(Feedback) <= 64, "Feedback size exceeds FDCAN limit (64bytes)");
+        subscribe(id::MsgTypeRobotControlHub::Command, &RobotControlHubServer::on_command);
     }
 
     bool get_command(Command& command)
     {
-        if (command_.has_value()) {
-            command = command_.value();
-            command_.reset();
-            return true;
-        }
-        return false;
+        return command_.take(command);
+    }
+
+    /**
+     * @brief 指令値のメールボックスを取得する
+     *
+     * 取り出す前に上書きされた回数や、最新の値の受信時刻の確認に使用します。
+     *
+     * @return const Mailbox<Command>& 指令値のメールボックス
+     */
+    const Mailbox<Command>& command_mailbox() const
+    {
+        return command_;
     }
 
     void send_feedback(const Feedback& feedback)
@@ -54,21 +62,18 @@ public:
         bus_.send_frame(frame);
     }
 
-    void on_receive(const FDCANFrame& frame) override
+private:
+    void on_command(const CANFrameView& frame)
     {
-        auto id_fields = id::unpack(frame.id);
-        if (id_fields.is_command(id::MsgTypeRobotControlHub::Command)) {
-            if (frame.dlc == sizeof(Command)) {
-                Command command;
-                if (converter::unpack(frame.data.data(), frame.dlc, 0, command)) {
-                    command_ = command;
-                }
+        if (frame.dlc == sizeof(Command)) {
+            Command command;
+            if (converter::unpack(frame.data, frame.dlc, 0, command)) {
+                command_.post(command, frame.timestamp);
             }
         }
     }
 
-private:
-    std::optional<Command> command_;
+    Mailbox<Command> command_;
 };
 
 }  // namespace devices
@@ -10,7 +10,6 @@
  */
 #pragma once
 
-#include "gn10_can/core/can_bus.hpp"
 #include "gn10_can/core/can_device.hpp"
 #include "gn10_can/core/can_frame.hpp"
 
@@ -19,7 +18,7 @@ namespace devices {
 class ServoMotorClient : public CANDevice
 {
 public:
-    ServoMotorClient(CANBus& bus, uint8_t device_id);
+    ServoMotorClient(CANBusBase& bus, uint8_t device_id);
     /**
      * @brief サーボモータのパルス幅最大値と最小値の設定
      *
@@ -33,7 +32,6 @@ public:
      * @param angles_rad 2台分の角度が入った配列 [サーボ1の角度, サーボ2の角度]
      */
     void set_angle_rad(const std::array<float, 2>& angles_rad);
-    void on_receive(const CANFrame& frame) override;
 };
 }  // namespace devices
 }  // namespace gn10_can
\ No newline at end of file
@@ -1,18 +1,17 @@
 #pragma once
 
 #include <array>
-#include <optional>
 
-#include "gn10_can/core/can_bus.hpp"
 #include "gn10_can/core/can_device.hpp"
 #include "gn10_can/core/can_frame.hpp"
+#include "gn10_can/core/mailbox.hpp"
 
 namespace gn10_can {
 namespace devices {
 class ServoMotorServer : public CANDevice
 {
 public:
-    ServoMotorServer(CANBus& bus, uint8_t device_id);
+    ServoMotorServer(CANBusBase& bus, uint8_t device_id);
     /**
      * @brief 受け取ったパルス幅の最大値と最小値の設定
      *
@@ -30,15 +29,36 @@ public:
      * @return false
      */
     bool get_new_angle_rad(std::array<float, 2>& angles_rad);
-    void on_receive(const CANFrame& frame) override;
+    /**
+     * @brief サーボモータの角度のメールボックスを取得する
+     *
+     * 取り出す前に上書きされた回数や、最新の値の受信時刻の確認に使用します。
+     *
+     * @return const Mailbox<std::array<float, 2>>& 角度のメールボックス
+     */
+    const Mailbox<std::array<float, 2>>& angle_rad_mailbox() const;
 
 private:
+    /**
+     * @brief Initフレームの受信ハンドラ
+     *
+     * @param frame 受信したCANパケット
+     */
+    void on_init(const CANFrameView& frame);
+
+    /**
+     * @brief AngleRadフレームの受信ハンドラ
+     *
+     * @param frame 受信したCANパケット
+     */
+    void on_angle_rad(const CANFrameView& frame);
+
     struct PulseSet {
         uint16_t min_us;
         uint16_t max_us;
     };
-    std::optional<PulseSet> pulse_set_;
-    std::optional<std::array<float, 2>> angles_rad_;
+    Mailbox<PulseSet> pulse_set_;
+    Mailbox<std::array<float, 2>> angles_rad_;
 };
 
 }  // namespace devices
@@ -23,10 +23,10 @@ public:
     /**
      * @brief ソレノイド用クライアントクラスのコンストラクタ
      *
-     * @param bus CANBusクラスの参照
+     * @param bus CANBus / FDCANBusクラスの参照
      * @param dev_id デバイスID
      */
-    SolenoidDriverClient(CANBus& bus, uint8_t dev_id);
+    SolenoidDriverClient(CANBusBase& bus, uint8_t dev_id);
 
     /**
      * @brief モータードライバー初期化コマンド送信関数
@@ -49,8 +49,6 @@ public:
      */
     void set_target(const std::array<bool, 8>& target);
 
-    void on_receive(const CANFrame& frame) override;
-
 private:
 };
 
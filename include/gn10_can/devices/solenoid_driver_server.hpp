@@ -11,9 +11,9 @@
 #pragma once
 
 #include <array>
-#include <optional>
 
 #include "gn10_can/core/can_device.hpp"
+#include "gn10_can/core/mailbox.hpp"
 
 namespace gn10_can {
 namespace devices {
@@ -24,17 +24,18 @@ public:
     /**
      * @brief ソレノイド用サーバークラスのコンストラクタ
      *
-     * @param bus CANBusクラスの参照
+     * @param bus CANBus / FDCANBusクラスの参照
      * @param dev_id デバイスID
      */
-    SolenoidDriverServer(CANBus& bus, uint8_t dev_id);
+    SolenoidDriverServer(CANBusBase& bus, uint8_t dev_id);
 
     /**
-     * @brief 新しい設定があれば更新する
+     * @brief 新しい初期化コマンドを受信したか確認する
      *
-     * @param config 設定
-     * @return true 新しい設定が有り更新した
-     * @return false 新しい設定はなく、更新しなかった
+     * @note 受信した初期化コマンドは一度だけ報告する。
+     *       Init を一度も受信していない間は false を返す。
+     * @return true 前回の呼び出し以降に初期化コマンドを受信した
+     * @return false 新しい初期化コマンドはない
      */
     bool get_new_init();
 
@@ -57,15 +58,31 @@ public:
     bool get_new_target(std::array<bool, 8>& target);
 
     /**
-     * @brief CANパケット受信時の呼び出し関数の実装
+     * @brief 目標値のメールボックスを取得する
      *
-     * @param frame 受信したCANパケット
+     * 取り出す前に上書きされた回数や、最新の値の受信時刻の確認に使用します。
+     *
+     * @return const Mailbox<uint8_t>& 目標値のメールボックス
      */
-    void on_receive(const CANFrame& frame) override;
+    const Mailbox<uint8_t>& target_mailbox() const;
 
 private:
-    std::optional<uint8_t> init_;
-    std::optional<uint8_t> target_;
+    /**
+     * @brief Initフレームの受信ハンドラ
+     *
+     * @param frame 受信したCANパケット
+     */
+    void on_init(const CANFrameView& frame);
+
+    /**
+     * @brief Targetフレームの受信ハンドラ
+     *
+     * @param frame 受信したCANパケット
+     */
+    void on_target(const CANFrameView& frame);
+
+    Mailbox<uint8_t> init_;
+    Mailbox<uint8_t> target_;
 };
 
 }  // namespace devices
@@ -10,18 +10,32 @@
  */
 #pragma once
 
+#include <cstddef>
+
+#include "gn10_can/core/acceptance_filter.hpp"
 #include "gn10_can/core/can_frame.hpp"
 
+// 受信割り込みからメインループへフレームを受け渡すリングバッファの容量 (2の累乗)
+// (ビルド時に -DGN10_CAN_RX_RING_SIZE=N で変更可能)
+#ifndef GN10_CAN_RX_RING_SIZE
+#define GN10_CAN_RX_RING_SIZE 32
+#endif
+
 namespace gn10_can {
-namespace drivers {
+
+namespace detail {
 
 /**
  * @brief CAN通信ハードウェアインターフェースの抽象化クラス
  *
+ * @tparam MaxDLC 扱うフレームの最大データ長 (CAN: 8, CAN FD: 64)
  */
+template <std::size_t MaxDLC>
 class ICANDriver
 {
 public:
+    using Frame = CANFrame<MaxDLC>;
+
     virtual ~ICANDriver() = default;
 
     /**
@@ -31,7 +45,7 @@ public:
      * @return true 送信成功
      * @return false 送信失敗
      */
-    virtual bool send(const CANFrame& frame) = 0;
+    virtual bool send(const Frame& frame) = 0;
 
     /**
      * @brief CANフレーム受信関数
@@ -40,7 +54,135 @@ public:
      * @return true 受信成功
      * @return false 受信失敗（受信データなしなど）
      */
-    virtual bool receive(CANFrame& out_frame) = 0;
+    virtual bool receive(Frame& out_frame) = 0;
+
+    /**
+     * @brief 複数のCANフレームをまとめて送信する関数
+     *
+     * 既定の実装は send() を1フレームずつ呼び出します。
+     * ハードウェアFIFOへの一括書き込みや sendmmsg などを使えるドライバはオーバーライドしてください。
+     *
+     * @param frames 送信するCANフレームの配列
+     * @param count 送信するフレーム数
+     * @return std::size_t 送信できたフレーム数（失敗したフレーム以降は送信しない）
+     */
+    virtual std::size_t send_many(const Frame* frames, std::size_t count)
+    {
+        std::size_t sent = 0;
+        while (sent < count && send(frames[sent])) {
+            sent++;
+        }
+        return sent;
+    }
+
+    /**
+     * @brief 複数のCANフレームをまとめて受信する関数
+     *
+     * 既定の実装は receive() を1フレームずつ呼び出します。
+     * 受信FIFOの一括読み出しや recvmmsg などを使えるドライバはオーバーライドしてください。
+     * 戻り値が max_count 未満の場合、受信データが尽きたものとして扱います。
+     *
+     * @param out_frames 受信したCANフレームの格納先の配列
+     * @param max_count 格納先の要素数
+     * @return std::size_t 受信したフレーム数
+     */
+    virtual std::size_t receive_many(Frame* out_frames, std::size_t max_count)
+    {
+        std::size_t received = 0;
+        while (received < max_count && receive(out_frames[received])) {
+            received++;
+        }
+        return received;
+    }
+
+    /**
+     * @brief 受信済みで読み出されていないフレーム数を取得する
+     *
+     * CANBus::update() が打ち切られたときに持ち越し数として報告します。
+     * 既定の実装は把握できないものとして 0 を返します。受信FIFOやリングバッファの
+     * 格納数を取得できるドライバはオーバーライドしてください。
+     *
+     * @return std::size_t 受信待ちのフレーム数
+     */
+    virtual std::size_t receive_pending() const
+    {
+        return 0;
+    }
+
+    /**
+     * @brief 送信完了イベントを1つ取り出す
+     *
+     * フレームが実際にコントローラから送出された時刻を取得します。
+     * 既定の実装は送信完了イベントに対応していないものとして false を返します。
+     *
+     * @param out_event 送信完了イベントの格納先
+     * @return true 取り出し成功
+     * @return false イベントなし（未対応を含む）
+     */
+    virtual bool receive_tx_event(TxEvent&)
+    {
+        return false;
+    }
+
+    /**
+     * @brief 受信オーバーランで失われたフレーム数を取得する
+     *
+     * 統計情報 (BusStats) の受信オーバーラン数として報告します。
+     * 既定の実装は把握できないものとして 0 を返します。
+     *
+     * @return uint32_t 受信オーバーランの回数
+     */
+    virtual uint32_t rx_overrun_count() const
+    {
+        return 0;
+    }
+
+    /**
+     * @brief 設定できるハードウェア受信フィルタの数を取得する
+     *
+     * CANBus は接続デバイスに合わせて、この数以下の受信フィルタを set_filters() で設定します。
+     * 既定の実装は受信フィルタに対応していないものとして 0 を返します。
+     *
+     * @return std::size_t 受信フィルタ数 (0: 未対応)
+     */
+    virtual std::size_t filter_capacity() const
+    {
+        return 0;
+    }
+
+    /**
+     * @brief ハードウェア受信フィルタを設定する
+     *
+     * いずれかのフィルタに一致する標準IDのデータフレームだけを受信し、それ以外 (拡張IDを含む) は
+     * ハードウェアで破棄します。count が 0 の場合は何も受信しません。
+     * 初期化前に呼び出された場合は、初期化時に設定してください。
+     *
+     * @param filters 受信フィルタの配列
+     * @param count フィルタ数 (filter_capacity() 以下)
+     * @return true 設定成功
+     * @return false 設定失敗 (未対応を含む)
+     */
+    virtual bool set_filters(const AcceptanceFilter*, std::size_t)
+    {
+        return false;
+    }
+
+    /**
+     * @brief ハードウェア受信フィルタを解除し、全てのフレームを受信する
+     *
+     * @return true 設定成功
+     * @return false 設定失敗 (未対応を含む)
+     */
+    virtual bool clear_filters()
+    {
+        return false;
+    }
 };
+}  // namespace detail
+
+namespace drivers {
+
+using ICANDriver = detail::ICANDriver<8>;
+
 }  // namespace drivers
 }  // namespace gn10_can
@@ -11,36 +11,12 @@
 #pragma once
 
 #include "gn10_can/core/fdcan_frame.hpp"
+#include "gn10_can/drivers/can_driver_interface.hpp"
 
 namespace gn10_can {
 namespace drivers {
 
-/**
- * @brief CAN通信ハードウェアインターフェースの抽象化クラス
- *
- */
-class IFDCANDriver
-{
-public:
-    virtual ~IFDCANDriver() = default;
-
-    /**
-     * @brief CANフレーム送信関数
-     *
-     * @param frame 送信するCANフレーム
-     * @return true 送信成功
-     * @return false 送信失敗
-     */
-    virtual bool send(const FDCANFrame& frame) = 0;
+using IFDCANDriver = detail::ICANDriver<64>;
 
-    /**
-     * @brief CANフレーム受信関数
-     *
-     * @param out_frame 受信したCANフレームの格納先
-     * @return true 受信成功
-     * @return false 受信失敗（受信データなしなど）
-     */
-    virtual bool receive(FDCANFrame& out_frame) = 0;
-};
 }  // namespace drivers
 }  // namespace gn10_can
@@ -10,8 +10,12 @@
  */
 #pragma once
 
+#include <array>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <limits>
 #include <type_traits>
 
 #include "gn10_can/core/can_frame.hpp"
@@ -99,5 +103,754 @@ bool unpack(const std::array<uint8_t, N>& buffer, uint8_t start_byte, T& out_val
     return unpack(buffer.data(), N, start_byte, out_value);
 }
 
+namespace detail {
+
+/**
+ * @brief ビットフィールドに格納する値を符号なし整数に変換する
+ */
+template <typename T>
+constexpr uint64_t to_bits(T value)
+{
+    if constexpr (std::is_enum<T>::value) {
+        return static_cast<uint64_t>(static_cast<std::underlying_type_t<T>>(value));
+    } else {
+        return static_cast<uint64_t>(value);
+    }
+}
+
+/**
+ * @brief ビットフィールドから読み出した符号なし整数を値に変換する
+ * @details 符号付き整数は最上位ビットを符号として符号拡張します。
+ */
+template <typename T>
+constexpr T from_bits(uint64_t raw, uint8_t bit_width)
+{
+    if constexpr (std::is_same<T, bool>::value) {
+        return raw != 0;
+    } else if constexpr (std::is_enum<T>::value) {
+        return static_cast<T>(from_bits<std::underlying_type_t<T>>(raw, bit_width));
+    } else {
+        if constexpr (std::is_signed<T>::value) {
+            if (bit_width < 64 && ((raw >> (bit_width - 1)) & 1) != 0) {
+                raw |= ~uint64_t{0} << bit_width;
+            }
+        }
+        return static_cast<T>(raw);
+    }
+}
+
+/**
+ * @brief ビットフィールドの位置と幅が有効か
+ */
+template <typename T>
+constexpr bool valid_bits(size_t buffer_len, size_t start_bit, uint8_t bit_width)
+{
+    static_assert(std::is_integral<T>::value || std::is_enum<T>::value,
+                  "Type must be integral, bool or enum");
+
+    return bit_width > 0 && bit_width <= sizeof(T) * 8 && start_bit + bit_width <= buffer_len * 8;
+}
+
+}  // namespace detail
+
+/**
+ * @brief バッファの任意のビット位置に整数・bool・列挙型の値を収納する関数
+ * @details
+ * ビット番号は先頭バイトの最下位ビットを0とし、バイト内は下位ビットから、バイトは先頭から順に
+ * 数えます (リトルエンディアン)。値の下位 bit_width ビットだけを書き込み、範囲外のビットは
+ * 変更しません。bit_width に収まらない値は上位ビットを切り捨てます。
+ *
+ * @code
+ * std::array<uint8_t, 1> payload{};
+ * converter::pack_bits(payload, 7, 1, true);          // bit 7
+ * converter::pack_bits(payload, 4, 3, uint8_t{5});  // bit 4-6
+ * @endcode
+ *
+ * @tparam T 収納する値の型 (整数・bool・列挙型)
+ * @param buffer データを収納するバッファ
+ * @param buffer_len バッファの長さ (バイト)
+ * @param start_bit 開始ビット位置
+ * @param bit_width ビット幅 (1 ~ T のビット数)
+ * @param value 収納する値
+ * @return true 成功
+ * @return false 失敗（バッファオーバーフロー、不正なビット幅など）
+ */
+template <typename T>
+constexpr bool pack_bits(
+    uint8_t* buffer, size_t buffer_len, size_t start_bit, uint8_t bit_width, T value
+)
+{
+    if (!detail::valid_bits<T>(buffer_len, start_bit, bit_width)) {
+        return false;
+    }
+
+    const uint64_t raw = detail::to_bits(value);
+    uint8_t written    = 0;
+    while (written < bit_width) {
+        const size_t bit    = start_bit + written;
+        const uint8_t shift = static_cast<uint8_t>(bit % 8);
+        uint8_t chunk       = static_cast<uint8_t>(8 - shift);
+        if (chunk > bit_width - written) {
+            chunk = static_cast<uint8_t>(bit_width - written);
+        }
+        const uint8_t mask  = static_cast<uint8_t>(((1u << chunk) - 1u) << shift);
+        const uint8_t bits  = static_cast<uint8_t>(static_cast<uint8_t>(raw >> written) << shift);
+        buffer[bit / 8]     = static_cast<uint8_t>((buffer[bit / 8] & ~mask) | (bits & mask));
+        written            += chunk;
+    }
+    return true;
+}
+
+/**
+ * @brief バッファの任意のビット位置から整数・bool・列挙型の値を取り出す関数
+ * @details
+ * ビット番号は pack_bits() と同じです。符号付き整数は取り出したビットの最上位を符号として
+ * 符号拡張し、bool は0以外を true とします。
+ *
+ * @tparam T 取り出す値の型 (整数・bool・列挙型)
+ * @param buffer データを取り出すバッファ
+ * @param buffer_len バッファの長さ (バイト)
+ * @param start_bit 開始ビット位置
+ * @param bit_width ビット幅 (1 ~ T のビット数)
+ * @param out_value 取り出した値の格納先
+ * @return true 成功
+ * @return false 失敗（バッファオーバーフロー、不正なビット幅など）
+ */
+template <typename T>
+constexpr bool unpack_bits(
+    const uint8_t* buffer, size_t buffer_len, size_t start_bit, uint8_t bit_width, T& out_value
+)
+{
+    if (!detail::valid_bits<T>(buffer_len, start_bit, bit_width)) {
+        return false;
+    }
+
+    uint64_t raw = 0;
+    uint8_t read = 0;
+    while (read < bit_width) {
+        const size_t bit    = start_bit + read;
+        const uint8_t shift = static_cast<uint8_t>(bit % 8);
+        uint8_t chunk       = static_cast<uint8_t>(8 - shift);
+        if (chunk > bit_width - read) {
+            chunk = static_cast<uint8_t>(bit_width - read);
+        }
+        const uint64_t bits  = (buffer[bit / 8] >> shift) & ((1u << chunk) - 1u);
+        raw                 |= bits << read;
+        read                += chunk;
+    }
+    out_value = detail::from_bits<T>(raw, bit_width);
+    return true;
+}
+
+/**
+ * @brief std::arrayバッファの任意のビット位置に値を収納する関数
+ *
+ * @tparam T 収納する値の型 (整数・bool・列挙型)
+ * @tparam N バッファのサイズ
+ * @param buffer データを収納するバッファ
+ * @param start_bit 開始ビット位置
+ * @param bit_width ビット幅
+ * @param value 収納する値
+ * @return true 成功
+ * @return false 失敗（バッファオーバーフロー、不正なビット幅など）
+ */
+template <typename T, size_t N>
+constexpr bool pack_bits(
+    std::array<uint8_t, N>& buffer, size_t start_bit, uint8_t bit_width, T value
+)
+{
+    return pack_bits(buffer.data(), N, start_bit, bit_width, value);
+}
+
+/**
+ * @brief std::arrayバッファの任意のビット位置から値を取り出す関数
+ *
+ * @tparam T 取り出す値の型 (整数・bool・列挙型)
+ * @tparam N バッファのサイズ
+ * @param buffer データを取り出すバッファ
+ * @param start_bit 開始ビット位置
+ * @param bit_width ビット幅
+ * @param out_value 取り出した値の格納先
+ * @return true 成功
+ * @return false 失敗（バッファオーバーフロー、不正なビット幅など）
+ */
+template <typename T, size_t N>
+constexpr bool unpack_bits(
+    const std::array<uint8_t, N>& buffer, size_t start_bit, uint8_t bit_width, T& out_value
+)
+{
+    return unpack_bits(buffer.data(), N, start_bit, bit_width, out_value);
+}
+
+/**
+ * @brief float を IEEE 754 半精度浮動小数点数 (binary16) に変換する
+ * @details
+ * 最も近い値に丸め (同距離の場合は偶数側)、半精度の範囲を超える有限値は ±65504 に飽和させます。
+ * 無限大と NaN はそのまま無限大・NaN になります。
+ *
+ * @param value 変換する値
+ * @return uint16_t 半精度浮動小数点数のビット列
+ */
+inline uint16_t float_to_half(float value)
+{
+    static_assert(sizeof(float) == 4, "float must be IEEE 754 binary32");
+
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign     = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+    const uint32_t exponent = (bits >> 23) & 0xFFu;
+    uint32_t mantissa       = bits & 0x7FFFFFu;
+    const int32_t half_exp  = static_cast<int32_t>(exponent) - 127 + 15;
+
+    if (exponent == 0xFFu) {
+        if (mantissa != 0) {
+            return static_cast<uint16_t>(sign | 0x7E00u);  // NaN
+        }
+        return static_cast<uint16_t>(sign | 0x7C00u);  // 無限大
+    }
+    if (half_exp >= 31) {
+        return static_cast<uint16_t>(sign | 0x7BFFu);  // 最大値に飽和
+    }
+    if (half_exp <= 0) {
+        // 非正規化数 (2^-25 未満は0)
+        if (half_exp < -10) {
+            return sign;
+        }
+        mantissa                |= 0x800000u;
+        const uint32_t shift     = static_cast<uint32_t>(14 - half_exp);
+        uint32_t half            = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1u);
+        const uint32_t halfway   = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1u) != 0)) {
+            half++;
+        }
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    uint32_t half            = (static_cast<uint32_t>(half_exp) << 10) | (mantissa >> 13);
+    const uint32_t remainder = mantissa & 0x1FFFu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u) != 0)) {
+        half++;
+    }
+    if (half >= 0x7C00u) {
+        half = 0x7BFFu;  // 丸めで範囲を超えた場合も最大値に飽和
+    }
+    return static_cast<uint16_t>(sign | half);
+}
+
+/**
+ * @brief IEEE 754 半精度浮動小数点数 (binary16) を float に変換する
+ *
+ * @param half 半精度浮動小数点数のビット列
+ * @return float 変換した値 (誤差なし)
+ */
+inline float half_to_float(uint16_t half)
+{
+    const uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+    uint32_t exponent   = (half >> 10) & 0x1Fu;
+    uint32_t mantissa   = half & 0x3FFu;
+    uint32_t bits       = sign;
+
+    if (exponent == 0x1Fu) {
+        bits |= 0x7F800000u | (mantissa << 13);
+    } else if (exponent != 0) {
+        bits |= ((exponent + 112) << 23) | (mantissa << 13);
+    } else if (mantissa != 0) {
+        // 非正規化数は float では正規化数になる
+        exponent = 113;
+        while ((mantissa & 0x400u) == 0) {
+            mantissa <<= 1;
+            exponent--;
+        }
+        bits |= (exponent << 23) | ((mantissa & 0x3FFu) << 13);
+    }
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief 実数を固定小数点数 (分解能の整数倍) に変換する
+ * @details
+ * value / resolution を最も近い整数に丸め、T の範囲を超える場合は最小値・最大値に飽和させます。
+ * NaN は0になります。
+ *
+ * @tparam T 格納する整数型 (32ビット以下)
+ * @param value 変換する値
+ * @param resolution 分解能 (1 LSB あたりの値)
+ * @return T 固定小数点数
+ */
+template <typename T>
+T to_fixed(float value, float resolution)
+{
+    static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value,
+                  "Type must be an integer");
+    static_assert(sizeof(T) <= 4, "Type must be 32 bits or less");
+
+    const double scaled = std::round(static_cast<double>(value) / static_cast<double>(resolution));
+    if (std::isnan(scaled)) {
+        return 0;
+    }
+    if (scaled <= static_cast<double>(std::numeric_limits<T>::min())) {
+        return std::numeric_limits<T>::min();
+    }
+    if (scaled >= static_cast<double>(std::numeric_limits<T>::max())) {
+        return std::numeric_limits<T>::max();
+    }
+    return static_cast<T>(scaled);
+}
+
+/**
+ * @brief 固定小数点数を実数に変換する
+ *
+ * @tparam T 格納する整数型
+ * @param raw 固定小数点数
+ * @param resolution 分解能 (1 LSB あたりの値)
+ * @return float 変換した値
+ */
+template <typename T>
+float from_fixed(T raw, float resolution)
+{
+    static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value,
+                  "Type must be an integer");
+
+    return static_cast<float>(static_cast<double>(raw) * static_cast<double>(resolution));
+}
+
+/**
+ * @brief バッファに実数を半精度浮動小数点数 (2バイト) で収納する関数
+ *
+ * @param buffer データを収納するバッファ
+ * @param buffer_len バッファの長さ
+ * @param start_byte 開始バイト位置
+ * @param value 収納する値 (float_to_half() で変換)
+ * @return true 成功
+ * @return false 失敗（バッファオーバーフローなど）
+ */
+inline bool pack_half(uint8_t* buffer, size_t buffer_len, uint8_t start_byte, float value)
+{
+    return pack(buffer, buffer_len, start_byte, float_to_half(value));
+}
+
+/**
+ * @brief バッファから半精度浮動小数点数 (2バイト) を実数として取り出す関数
+ *
+ * @param buffer データを取り出すバッファ
+ * @param buffer_len バッファの長さ
+ * @param start_byte 開始バイト位置
+ * @param out_value 取り出した値の格納先
+ * @return true 成功
+ * @return false 失敗（バッファオーバーフローなど）
+ */
+inline bool unpack_half(
+    const uint8_t* buffer, size_t buffer_len, uint8_t start_byte, float& out_value
+)
+{
+    uint16_t half;
+    if (!unpack(buffer, buffer_len, start_byte, half)) {
+        return false;
+    }
+    out_value = half_to_float(half);
+    return true;
+}
+
+/**
+ * @brief バッファに実数を固定小数点数で収納する関数
+ *
+ * @code
+ * // 0.01 A 単位の int16_t (±327.67 A) で格納する
+ * converter::pack_fixed<int16_t>(payload, 0, current, 0.01f);
+ * @endcode
+ *
+ * @tparam T 格納する整数型 (32ビット以下)
+ * @param buffer データを収納するバッファ
+ * @param buffer_len バッファの長さ
+ * @param start_byte 開始バイト位置
+ * @param value 収納する値 (to_fixed() で丸め・飽和)
+ * @param resolution 分解能 (1 LSB あたりの値)
+ * @return true 成功
+ * @return false 失敗（バッファオーバーフローなど）
+ */
+template <typename T>
+bool pack_fixed(
+    uint8_t* buffer, size_t buffer_len, uint8_t start_byte, float value, float resolution
+)
+{
+    return pack(buffer, buffer_len, start_byte, to_fixed<T>(value, resolution));
+}
+
+/**
+ * @brief バッファから固定小数点数を実数として取り出す関数
+ *
+ * @tparam T 格納されている整数型
+ * @param buffer データを取り出すバッファ
+ * @param buffer_len バッファの長さ
+ * @param start_byte 開始バイト位置
+ * @param resolution 分解能 (1 LSB あたりの値)
+ * @param out_value 取り出した値の格納先
+ * @return true 成功
+ * @return false 失敗（バッファオーバーフローなど）
+ */
+template <typename T>
+bool unpack_fixed(
+    const uint8_t* buffer, size_t buffer_len, uint8_t start_byte, float resolution, float& out_value
+)
+{
+    T raw;
+    if (!unpack(buffer, buffer_len, start_byte, raw)) {
+        return false;
+    }
+    out_value = from_fixed(raw, resolution);
+    return true;
+}
+
+/**
+ * @brief std::arrayバッファに実数を半精度浮動小数点数で収納する関数
+ *
+ * @tparam N バッファのサイズ
+ * @param buffer データを収納するバッファ
+ * @param start_byte 開始バイト位置
+ * @param value 収納する値
+ * @return true 成功
+ * @return false 失敗（バッファオーバーフローなど）
+ */
+template <size_t N>
+bool pack_half(std::array<uint8_t, N>& buffer, uint8_t start_byte, float value)
+{
+    return pack_half(buffer.data(), N, start_byte, value);
+}
+
+/**
+ * @brief std::arrayバッファから半精度浮動小数点数を実数として取り出す関数
+ *
+ * @tparam N バッファのサイズ
+ * @param buffer データを取り出すバッファ
+ * @param start_byte 開始バイト位置
+ * @param out_value 取り出した値の格納先
+ * @return true 成功
+ * @return false 失敗（バッファオーバーフローなど）
+ */
+template <size_t N>
+bool unpack_half(const std::array<uint8_t, N>& buffer, uint8_t start_byte, float& out_value)
+{
+    return unpack_half(buffer.data(), N, start_byte, out_value);
+}
+
+/**
+ * @brief std::arrayバッファに実数を固定小数点数で収納する関数
+ *
+ * @tparam T 格納する整数型 (32ビット以下)
+ * @tparam N バッファのサイズ
+ * @param buffer データを収納するバッファ
+ * @param start_byte 開始バイト位置
+ * @param value 収納する値
+ * @param resolution 分解能 (1 LSB あたりの値)
+ * @return true 成功
+ * @return false 失敗（バッファオーバーフローなど）
+ */
+template <typename T, size_t N>
+bool pack_fixed(std::array<uint8_t, N>& buffer, uint8_t start_byte, float value, float resolution)
+{
+    return pack_fixed<T>(buffer.data(), N, start_byte, value, resolution);
+}
+
+/**
+ * @brief std::arrayバッファから固定小数点数を実数として取り出す関数
+ *
+ * @tparam T 格納されている整数型
+ * @tparam N バッファのサイズ
+ * @param buffer データを取り出すバッファ
+ * @param start_byte 開始バイト位置
+ * @param resolution 分解能 (1 LSB あたりの値)
+ * @param out_value 取り出した値の格納先
+ * @return true 成功
+ * @return false 失敗（バッファオーバーフローなど）
+ */
+template <typename T, size_t N>
+bool unpack_fixed(
+    const std::array<uint8_t, N>& buffer, uint8_t start_byte, float resolution, float& out_value
+)
+{
+    return unpack_fixed<T>(buffer.data(), N, start_byte, resolution, out_value);
+}
+
+/**
+ * @brief 通信路上のバイト順
+ */
+enum class Endian : uint8_t {
+    Little = 0,  ///< @brief リトルエンディアン (下位バイトが先頭)
+    Big    = 1,  ///< @brief ビッグエンディアン (上位バイトが先頭)
+};
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && \
+    __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+inline constexpr Endian NATIVE_ENDIAN = Endian::Big;  // このマイコン・PC のバイト順
+#else
+inline constexpr Endian NATIVE_ENDIAN = Endian::Little;  // このマイコン・PC のバイト順
+#endif
+
+/**
+ * @brief 符号なし整数のバイト順を反転する
+ * @details
+ * GCC / Clang ではバイト反転命令 (x86 の bswap、ARM の rev) になる組み込み関数を使用し、
+ * それ以外のコンパイラではシフト演算で反転します。いずれも constexpr で使用できます。
+ *
+ * @tparam U 符号なし整数型 (uint8_t / uint16_t / uint32_t / uint64_t)
+ * @param value 反転する値
+ * @return constexpr U バイト順を反転した値
+ */
+template <typename U>
+constexpr U byte_swap(U value)
+{
+    static_assert(std::is_unsigned<U>::value, "Type must be an unsigned integer");
+
+#if defined(__GNUC__) || defined(__clang__)
+    if constexpr (sizeof(U) == 2) {
+        return __builtin_bswap16(value);
+    } else if constexpr (sizeof(U) == 4) {
+        return __builtin_bswap32(value);
+    } else if constexpr (sizeof(U) == 8) {
+        return __builtin_bswap64(value);
+    }
+#endif
+    U result = 0;
+    for (size_t i = 0; i < sizeof(U); i++) {
+        result = static_cast<U>((result << 8) | ((value >> (i * 8)) & 0xFFu));
+    }
+    return result;
+}
+
+namespace detail {
+
+/**
+ * @brief バイト数に対応する符号なし整数型
+ */
+template <size_t Size>
+struct UintOf;
+
+template <>
+struct UintOf<1> {
+    using Type = uint8_t;
+};
+
+template <>
+struct UintOf<2> {
+    using Type = uint16_t;
+};
+
+template <>
+struct UintOf<4> {
+    using Type = uint32_t;
+};
+
+template <>
+struct UintOf<8> {
+    using Type = uint64_t;
+};
+
+/**
+ * @brief 配列の要素として送受信できる型か
+ */
+template <typename T>
+constexpr void check_array_element()
+{
+    static_assert(std::is_arithmetic<T>::value && !std::is_same<T, bool>::value,
+                  "Element type must be an integer or floating point");
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8,
+                  "Element size must be 1, 2, 4 or 8 bytes");
+}
+
+/**
+ * @brief 要素1つを指定したバイト順で書き込む
+ */
+template <Endian Order, typename T>
+inline void store(uint8_t* out, T value)
+{
+    typename UintOf<sizeof(T)>::Type bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    if constexpr (Order != NATIVE_ENDIAN) {
+        bits = byte_swap(bits);
+    }
+    std::memcpy(out, &bits, sizeof(T));
+}
+
+/**
+ * @brief 指定したバイト順の要素1つを読み出す
+ */
+template <Endian Order, typename T>
+inline T load(const uint8_t* in)
+{
+    typename UintOf<sizeof(T)>::Type bits;
+    std::memcpy(&bits, in, sizeof(T));
+    if constexpr (Order != NATIVE_ENDIAN) {
+        bits = byte_swap(bits);
+    }
+    T value;
+    std::memcpy(&value, &bits, sizeof(T));
+    return value;
+}
+
+}  // namespace detail
+
+/**
+ * @brief バッファに数値の配列を指定したバイト順で収納する関数
+ * @details
+ * 範囲の確認は配列全体で1度だけ行います。通信路のバイト順がこのマイコン・PC と同じ場合は
+ * 1回の memcpy、異なる場合は要素ごとのバイト反転になり、コンパイラがベクトル命令
+ * (SSE / NEON のバイトシャッフル) に展開できる単純なループです。
+ *
+ * @code
+ * float velocities[4] = {...};
+ * converter::pack_array(frame.data, 0, velocities, 4);                // リトルエンディアン
+ * converter::pack_array<converter::Endian::Big>(frame.data, 0, velocities, 4);
+ * @endcode
+ *
+ * @tparam Order 通信路のバイト順 (既定: リトルエンディアン)
+ * @tparam T 要素の型 (整数・浮動小数点数)
+ * @param buffer データを収納するバッファ
+ * @param buffer_len バッファの長さ
+ * @param start_byte 開始バイト位置
+ * @param values 収納する配列
+ * @param count 要素数
+ * @return true 成功
+ * @return false 失敗（バッファオーバーフローなど）
+ */
+template <Endian Order = Endian::Little, typename T>
+bool pack_array(
+    uint8_t* buffer, size_t buffer_len, uint8_t start_byte, const T* values, size_t count
+)
+{
+    detail::check_array_element<T>();
+
+    if (start_byte + count * sizeof(T) > buffer_len) {
+        return false;
+    }
+    uint8_t* out = &buffer[start_byte];
+    if constexpr (Order == NATIVE_ENDIAN) {
+        std::memcpy(out, values, count * sizeof(T));
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            detail::store<Order>(out + i * sizeof(T), values[i]);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief バッファから指定したバイト順の数値の配列を取り出す関数
+ * @details 範囲の確認は配列全体で1度だけ行います (pack_array() 参照)。
+ *
+ * @tparam Order 通信路のバイト順 (既定: リトルエンディアン)
+ * @tparam T 要素の型 (整数・浮動小数点数)
+ * @param buffer データを取り出すバッファ
+ * @param buffer_len バッファの長さ
+ * @param start_byte 開始バイト位置
+ * @param out_values 取り出した配列の格納先
+ * @param count 要素数
+ * @return true 成功
+ * @return false 失敗（バッファオーバーフローなど）
+ */
+template <Endian Order = Endian::Little, typename T>
+bool unpack_array(
+    const uint8_t* buffer, size_t buffer_len, uint8_t start_byte, T* out_values, size_t count
+)
+{
+    detail::check_array_element<T>();
+
+    if (start_byte + count * sizeof(T) > buffer_len) {
+        return false;
+    }
+    const uint8_t* in = &buffer[start_byte];
+    if constexpr (Order == NATIVE_ENDIAN) {
+        std::memcpy(out_values, in, count * sizeof(T));
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            out_values[i] = detail::load<Order, T>(in + i * sizeof(T));
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief std::arrayバッファに数値の配列を指定したバイト順で収納する関数
+ *
+ * @tparam Order 通信路のバイト順 (既定: リトルエンディアン)
+ * @tparam T 要素の型 (整数・浮動小数点数)
+ * @tparam N バッファのサイズ
+ * @param buffer データを収納するバッファ
+ * @param start_byte 開始バイト位置
+ * @param values 収納する配列
+ * @param count 要素数
+ * @return true 成功
+ * @return false 失敗（バッファオーバーフローなど）
+ */
+template <Endian Order = Endian::Little, typename T, size_t N>
+bool pack_array(std::array<uint8_t, N>& buffer, uint8_t start_byte, const T* values, size_t count)
+{
+    return pack_array<Order>(buffer.data(), N, start_byte, values, count);
+}
+
+/**
+ * @brief std::arrayバッファから指定したバイト順の数値の配列を取り出す関数
+ *
+ * @tparam Order 通信路のバイト順 (既定: リトルエンディアン)
+ * @tparam T 要素の型 (整数・浮動小数点数)
+ * @tparam N バッファのサイズ
+ * @param buffer データを取り出すバッファ
+ * @param start_byte 開始バイト位置
+ * @param out_values 取り出した配列の格納先
+ * @param count 要素数
+ * @return true 成功
+ * @return false 失敗（バッファオーバーフローなど）
+ */
+template <Endian Order = Endian::Little, typename T, size_t N>
+bool unpack_array(
+    const std::array<uint8_t, N>& buffer, uint8_t start_byte, T* out_values, size_t count
+)
+{
+    return unpack_array<Order>(buffer.data(), N, start_byte, out_values, count);
+}
+
+/**
+ * @brief std::arrayバッファに std::array の数値を指定したバイト順で収納する関数
+ *
+ * @tparam Order 通信路のバイト順 (既定: リトルエンディアン)
+ * @tparam T 要素の型 (整数・浮動小数点数)
+ * @tparam N バッファのサイズ
+ * @tparam M 要素数
+ * @param buffer データを収納するバッファ
+ * @param start_byte 開始バイト位置
+ * @param values 収納する配列
+ * @return true 成功
+ * @return false 失敗（バッファオーバーフローなど）
+ */
+template <Endian Order = Endian::Little, typename T, size_t N, size_t M>
+bool pack_array(std::array<uint8_t, N>& buffer, uint8_t start_byte, const std::array<T, M>& values)
+{
+    return pack_array<Order>(buffer.data(), N, start_byte, values.data(), M);
+}
+
+/**
+ * @brief std::arrayバッファから std::array の数値を指定したバイト順で取り出す関数
+ *
+ * @tparam Order 通信路のバイト順 (既定: リトルエンディアン)
+ * @tparam T 要素の型 (整数・浮動小数点数)
+ * @tparam N バッファのサイズ
+ * @tparam M 要素数
+ * @param buffer データを取り出すバッファ
+ * @param start_byte 開始バイト位置
+ * @param out_values 取り出した配列の格納先
+ * @return true 成功
+ * @return false 失敗（バッファオーバーフローなど）
+ */
+template <Endian Order = Endian::Little, typename T, size_t N, size_t M>
+bool unpack_array(
+    const std::array<uint8_t, N>& buffer, uint8_t start_byte, std::array<T, M>& out_values
+)
+{
+    return unpack_array<Order>(buffer.data(), N, start_byte, out_values.data(), M);
+}
+
 }  // namespace converter
 }  // namespace gn10_can
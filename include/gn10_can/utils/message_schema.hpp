@@ -0,0 +1,348 @@
+/**
+ * @file message_schema.hpp
+ * @author Gento Aiba (aiba-gento)
+ * @brief メッセージのフィールド配置を1度だけ宣言し、送信側と受信側の変換を生成するスキーマ
+ * @version 0.1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026 Gento Aiba
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ratio>
+#include <type_traits>
+#include <utility>
+
+#include "gn10_can/core/can_frame.hpp"
+#include "gn10_can/utils/can_converter.hpp"
+
+namespace gn10_can {
+namespace schema {
+
+/**
+ * @brief 値をリトルエンディアンのバイト列で格納するエンコーディング
+ * @details
+ * 整数・浮動小数点数・列挙型はこのマイコン・PC のバイト順によらずリトルエンディアンで
+ * 格納します (converter::pack_array() と同じ)。それ以外の型 (構造体など) は
+ * メモリ上の表現をそのまま複製します。
+ *
+ * @tparam T 値の型 (トリビアルにコピー可能であること)
+ */
+template <typename T>
+struct Raw {
+    static_assert(std::is_trivially_copyable<T>::value, "Type must be POD");
+
+    using Value = T;
+
+    static constexpr std::size_t SIZE = sizeof(T);  // バイト数
+
+    static constexpr bool SCALAR =
+        (std::is_arithmetic<T>::value || std::is_enum<T>::value) &&
+        (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);  // 数値・列挙型か
+
+    static void encode(const T& value, uint8_t* out)
+    {
+        if constexpr (SCALAR) {
+            converter::detail::store<converter::Endian::Little>(out, value);
+        } else {
+            std::memcpy(out, &value, sizeof(T));
+        }
+    }
+
+    static void decode(const uint8_t* in, T& out_value)
+    {
+        if constexpr (SCALAR) {
+            out_value = converter::detail::load<converter::Endian::Little, T>(in);
+        } else {
+            std::memcpy(&out_value, in, sizeof(T));
+        }
+    }
+};
+
+/**
+ * @brief bool を1バイト (0 / 1) で格納するエンコーディング
+ * @details
+ * 送信側は Raw<bool> と同じバイト列になります。受信側は0以外を true とするため、
+ * 0 / 1 以外のバイトを受信しても bool に不正な値が入りません。
+ */
+struct Bool {
+    using Value = bool;
+
+    static constexpr std::size_t SIZE = 1;  // バイト数
+
+    static void encode(bool value, uint8_t* out)
+    {
+        out[0] = static_cast<uint8_t>(value);
+    }
+
+    static void decode(const uint8_t* in, bool& out_value)
+    {
+        out_value = in[0] != 0;
+    }
+};
+
+/**
+ * @brief float を半精度浮動小数点数 (2バイト) で格納するエンコーディング
+ * @details
+ * 有効桁数は約3桁です。範囲 (±65504) を超える値は飽和させます (converter::float_to_half())。
+ * リトルエンディアンで格納します。
+ */
+struct Half {
+    using Value = float;
+
+    static constexpr std::size_t SIZE = 2;  // バイト数
+
+    static void encode(float value, uint8_t* out)
+    {
+        converter::detail::store<converter::Endian::Little>(out, converter::float_to_half(value));
+    }
+
+    static void decode(const uint8_t* in, float& out_value)
+    {
+        const uint16_t half = converter::detail::load<converter::Endian::Little, uint16_t>(in);
+        out_value           = converter::half_to_float(half);
+    }
+};
+
+/**
+ * @brief float を固定小数点数で格納するエンコーディング
+ * @details
+ * 値を分解能 Resolution の整数倍に丸め、Storage の範囲を超える値は飽和させます
+ * (converter::to_fixed())。リトルエンディアンで格納します。
+ *
+ * @code
+ * schema::Field<&State::current, schema::Fixed<int16_t, std::milli>>  // 0.001 単位
+ * @endcode
+ *
+ * @tparam Storage 格納する整数型 (32ビット以下)
+ * @tparam Resolution 分解能 (std::ratio、1 LSB あたりの値)
+ */
+template <typename Storage, typename Resolution = std::ratio<1>>
+struct Fixed {
+    using Value = float;
+
+    static constexpr std::size_t SIZE = sizeof(Storage);  // バイト数
+
+    static constexpr float RESOLUTION =
+        static_cast<float>(Resolution::num) / static_cast<float>(Resolution::den);  // 分解能
+
+    static void encode(float value, uint8_t* out)
+    {
+        const Storage raw = converter::to_fixed<Storage>(value, RESOLUTION);
+        converter::detail::store<converter::Endian::Little>(out, raw);
+    }
+
+    static void decode(const uint8_t* in, float& out_value)
+    {
+        const Storage raw = converter::detail::load<converter::Endian::Little, Storage>(in);
+        out_value         = converter::from_fixed(raw, RESOLUTION);
+    }
+};
+
+namespace detail {
+
+/**
+ * @brief 型ごとの既定のエンコーディング
+ */
+template <typename T>
+struct DefaultEncoding {
+    using Type = Raw<T>;
+};
+
+template <>
+struct DefaultEncoding<bool> {
+    using Type = Bool;
+};
+
+/**
+ * @brief メンバポインタから構造体とメンバの型を取り出す
+ */
+template <typename MemberPointer>
+struct MemberTraits;
+
+template <typename S, typename T>
+struct MemberTraits<T S::*> {
+    using Struct = S;
+    using Type   = T;
+};
+
+}  // namespace detail
+
+/**
+ * @brief 構造体のメンバ1つを表すフィールド
+ *
+ * @tparam Member メンバポインタ (&Struct::member)
+ * @tparam Encoding エンコーディング (既定: bool は Bool、それ以外は Raw)
+ */
+template <auto Member,
+          typename Encoding = typename detail::DefaultEncoding<
+              typename detail::MemberTraits<decltype(Member)>::Type>::Type>
+struct Field {
+    using Struct = typename detail::MemberTraits<decltype(Member)>::Struct;
+    using Type   = typename detail::MemberTraits<decltype(Member)>::Type;
+
+    static_assert(std::is_same<Type, typename Encoding::Value>::value,
+                  "Encoding does not match the member type");
+
+    static constexpr std::size_t SIZE = Encoding::SIZE;  // バイト数
+
+    static void pack(const Struct& value, uint8_t* out)
+    {
+        Encoding::encode(value.*Member, out);
+    }
+
+    static void unpack(const uint8_t* in, Struct& out_value)
+    {
+        Encoding::decode(in, out_value.*Member);
+    }
+};
+
+/**
+ * @brief 使用しない (予約) バイト
+ * @details
+ * 送信側は0で埋め、受信側は読み飛ばします。
+ *
+ * @tparam N バイト数
+ */
+template <std::size_t N>
+struct Reserved {
+    static constexpr std::size_t SIZE = N;  // バイト数
+
+    template <typename Struct>
+    static void pack(const Struct&, uint8_t* out)
+    {
+        std::memset(out, 0, N);
+    }
+
+    template <typename Struct>
+    static void unpack(const uint8_t*, Struct&)
+    {
+    }
+};
+
+/**
+ * @brief メッセージのスキーマ (フィールドの並びとエンコーディング)
+ * @details
+ * フィールドを先頭から順に詰めて配置し、各フィールドのオフセットとデータ長 (DLC) を
+ * コンパイル時に求めます。送信側 (pack) と受信側 (unpack) が同じスキーマを使用するため、
+ * 両者の配置が食い違うことはありません。
+ * unpack() はデータ長を1度だけ確認し、各フィールドは確認なしで取り出します。
+ *
+ * @code
+ * using StatusSchema = schema::Message<
+ *     Status,
+ *     schema::Field<&Status::emergency_stop_enabled>,
+ *     schema::Field<&Status::over_current>>;
+ *
+ * send(id::MsgTypePowerManager::Status, StatusSchema::pack(status));
+ * @endcode
+ *
+ * @tparam Struct メッセージの構造体
+ * @tparam Fields フィールド (Field / Reserved) の並び
+ */
+template <typename Struct, typename... Fields>
+class Message
+{
+public:
+    static constexpr std::size_t DLC = (std::size_t{0} + ... + Fields::SIZE);  // データ長
+
+    static_assert(DLC > 0, "Message must have at least one field");
+    static_assert(DLC <= 64, "Message exceeds the CAN FD payload (64 bytes)");
+
+    using Payload = std::array<uint8_t, DLC>;
+
+    /**
+     * @brief フィールドのオフセット
+     *
+     * @param index フィールドの番号
+     * @return constexpr std::size_t 先頭からのバイト位置
+     */
+    static constexpr std::size_t offset(std::size_t index)
+    {
+        constexpr std::array<std::size_t, sizeof...(Fields)> sizes{Fields::SIZE...};
+        std::size_t position = 0;
+        for (std::size_t i = 0; i < index && i < sizes.size(); i++) {
+            position += sizes[i];
+        }
+        return position;
+    }
+
+    /**
+     * @brief 構造体をバイト列に変換する
+     *
+     * @param value 変換する構造体
+     * @return Payload DLC バイトのバイト列
+     */
+    static Payload pack(const Struct& value)
+    {
+        Payload payload{};
+        pack(value, payload.data());
+        return payload;
+    }
+
+    /**
+     * @brief 構造体をバッファに書き込む
+     *
+     * @param value 変換する構造体
+     * @param out 書き込み先 (DLC バイト以上)
+     */
+    static void pack(const Struct& value, uint8_t* out)
+    {
+        pack_fields(value, out, std::index_sequence_for<Fields...>{});
+    }
+
+    /**
+     * @brief バイト列から構造体を取り出す
+     *
+     * @param data 受信データ
+     * @param length 受信データ長
+     * @param out_value 取り出した構造体の格納先 (失敗した場合は変更しない)
+     * @return true 成功
+     * @return false データ長が DLC に満たない
+     */
+    static bool unpack(const uint8_t* data, std::size_t length, Struct& out_value)
+    {
+        if (length < DLC) {
+            return false;
+        }
+        unpack_fields(data, out_value, std::index_sequence_for<Fields...>{});
+        return true;
+    }
+
+    /**
+     * @brief 受信フレームから構造体を取り出す
+     *
+     * @param frame 受信フレーム
+     * @param out_value 取り出した構造体の格納先 (失敗した場合は変更しない)
+     * @return true 成功
+     * @return false データ長が DLC に満たない
+     */
+    static bool unpack(const CANFrameView& frame, Struct& out_value)
+    {
+        return unpack(frame.data, frame.dlc, out_value);
+    }
+
+private:
+    template <std::size_t Index>
+    static constexpr std::size_t OFFSET = offset(Index);  // コンパイル時に求めたオフセット
+
+    template <std::size_t... Indices>
+    static void pack_fields(const Struct& value, uint8_t* out, std::index_sequence<Indices...>)
+    {
+        (Fields::pack(value, out + OFFSET<Indices>), ...);
+    }
+
+    template <std::size_t... Indices>
+    static void unpack_fields(const uint8_t* in, Struct& out_value, std::index_sequence<Indices...>)
+    {
+        (Fields::unpack(in + OFFSET<Indices>, out_value), ...);
+    }
+};
+
+}  // namespace schema
+}  // namespace gn10_can
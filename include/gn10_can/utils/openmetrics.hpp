@@ -0,0 +1,248 @@
+/**
+ * @file openmetrics.hpp
+ * @author Gento Aiba (aiba-gento)
+ * @brief バスの統計情報を OpenMetrics テキスト形式で出力するユーティリティのヘッダーファイル
+ * @version 0.1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026 Gento Aiba
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "gn10_can/core/bus_stats.hpp"
+
+namespace gn10_can {
+namespace openmetrics {
+
+namespace detail {
+
+/**
+ * @brief ラベル値をエスケープする
+ *
+ * @param value ラベル値
+ * @return std::string エスケープしたラベル値
+ */
+inline std::string escape_label(const std::string& value)
+{
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value) {
+        if (c == '\\') {
+            escaped += "\\\\";
+        } else if (c == '"') {
+            escaped += "\\\"";
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+/**
+ * @brief メトリクスファミリーのヘッダー (TYPE / HELP) を出力する
+ */
+inline void write_family(std::string& out, const char* name, const char* type, const char* help)
+{
+    out += "# TYPE ";
+    out += name;
+    out += ' ';
+    out += type;
+    out += "\n# HELP ";
+    out += name;
+    out += ' ';
+    out += help;
+    out += '\n';
+}
+
+/**
+ * @brief サンプルを1行出力する
+ */
+inline void write_sample(
+    std::string& out,
+    const char* name,
+    const char* suffix,
+    const std::string& labels,
+    const char* value
+)
+{
+    out += name;
+    out += suffix;
+    out += '{';
+    out += labels;
+    out += "} ";
+    out += value;
+    out += '\n';
+}
+
+/**
+ * @brief 整数値のサンプルを1行出力する
+ */
+inline void write_sample(
+    std::string& out,
+    const char* name,
+    const char* suffix,
+    const std::string& labels,
+    uint32_t value
+)
+{
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "%lu", static_cast<unsigned long>(value));
+    write_sample(out, name, suffix, labels, buffer);
+}
+
+/**
+ * @brief 実数値のサンプルを1行出力する
+ */
+inline void write_sample(
+    std::string& out, const char* name, const char* suffix, const std::string& labels, double value
+)
+{
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.15g", value);
+    write_sample(out, name, suffix, labels, buffer);
+}
+
+/**
+ * @brief ルーティングIDとコマンドのラベルを作成する
+ */
+inline std::string route_labels(const std::string& bus_label, uint8_t routing_id, int command)
+{
+    char buffer[48];
+    if (command < 0) {
+        std::snprintf(buffer, sizeof(buffer), ",routing_id=\"0x%02X\"", routing_id);
+    } else {
+        std::snprintf(
+            buffer, sizeof(buffer), ",routing_id=\"0x%02X\",command=\"%d\"", routing_id, command
+        );
+    }
+    return bus_label + buffer;
+}
+
+}  // namespace detail
+
+/**
+ * @brief 統計情報を OpenMetrics テキスト形式に変換する
+ * @details
+ * Prometheus などのスクレイプ先として公開するための Linux ホスト向けユーティリティです。
+ * 動的メモリを使用するため、マイコンでは使用しないでください。
+ * 出力は末尾に "# EOF" を含む1つの完結した公開データです。
+ *
+ * @tparam Duration 処理時間の型
+ * @tparam MaxRoutes 個別に記録するルーティングIDの最大数
+ * @param stats 統計情報のスナップショット (CANBus::stats())
+ * @param bus_name bus ラベルに設定するバス名
+ * @return std::string OpenMetrics テキスト
+ */
+template <typename Duration, std::size_t MaxRoutes>
+std::string to_text(const BusStatsSnapshot<Duration, MaxRoutes>& stats, const std::string& bus_name)
+{
+    using Seconds = std::chrono::duration<double>;
+
+    const std::string bus = "bus=\"" + detail::escape_label(bus_name) + "\"";
+    std::string out;
+
+    // バス全体のカウンタ
+    struct Total {
+        const char* name;
+        const char* help;
+        uint32_t value;
+    };
+    const Total totals[] = {
+        {"gn10_can_rx_frames", "Received frames.", stats.rx_frames},
+        {"gn10_can_rx_bytes", "Received payload bytes.", stats.rx_bytes},
+        {"gn10_can_tx_frames", "Frames accepted by the driver.", stats.tx_frames},
+        {"gn10_can_tx_bytes", "Payload bytes accepted by the driver.", stats.tx_bytes},
+        {"gn10_can_unrouted_frames", "Received frames with no subscribed device.",
+         stats.unrouted_frames},
+        {"gn10_can_send_failures", "Frames that could not be sent or queued.", stats.send_failures},
+        {"gn10_can_rx_overruns", "Frames lost to receive overruns.", stats.rx_overruns},
+        {"gn10_can_untracked_frames", "Frames not counted per route because all slots were used.",
+         stats.untracked},
+    };
+    for (const auto& total : totals) {
+        detail::write_family(out, total.name, "counter", total.help);
+        detail::write_sample(out, total.name, "_total", bus, total.value);
+    }
+
+    // ルーティングID × コマンドごとのカウンタ
+    using Counters = typename BusStatsSnapshot<Duration, MaxRoutes>::CommandCounters;
+    struct RouteCounter {
+        const char* name;
+        const char* help;
+        uint32_t Counters::*member;
+    };
+    const RouteCounter route_counters[] = {
+        {"gn10_can_route_rx_frames", "Received frames per routing ID and command.",
+         &Counters::rx_frames},
+        {"gn10_can_route_rx_bytes", "Received payload bytes per routing ID and command.",
+         &Counters::rx_bytes},
+        {"gn10_can_route_tx_frames", "Sent frames per routing ID and command.",
+         &Counters::tx_frames},
+        {"gn10_can_route_tx_bytes", "Sent payload bytes per routing ID and command.",
+         &Counters::tx_bytes},
+    };
+    for (const auto& counter : route_counters) {
+        detail::write_family(out, counter.name, "counter", counter.help);
+        for (std::size_t i = 0; i < stats.route_count; i++) {
+            const auto& route = stats.routes[i];
+            for (std::size_t command = 0; command < route.commands.size(); command++) {
+                const auto& counters = route.commands[command];
+                if (counters.rx_frames == 0 && counters.tx_frames == 0) {
+                    continue;
+                }
+                detail::write_sample(
+                    out, counter.name, "_total",
+                    detail::route_labels(bus, route.routing_id, static_cast<int>(command)),
+                    counters.*counter.member
+                );
+            }
+        }
+    }
+
+    // 受信処理時間
+    detail::write_family(
+        out, "gn10_can_handler_seconds", "summary", "Time spent delivering a received frame."
+    );
+    for (std::size_t i = 0; i < stats.route_count; i++) {
+        const auto& route = stats.routes[i];
+        if (route.handler_calls == 0) {
+            continue;
+        }
+        const std::string labels = detail::route_labels(bus, route.routing_id, -1);
+        detail::write_sample(
+            out, "gn10_can_handler_seconds", "_count", labels, route.handler_calls
+        );
+        detail::write_sample(
+            out, "gn10_can_handler_seconds", "_sum", labels, Seconds(route.handler_total).count()
+        );
+    }
+
+    detail::write_family(
+        out, "gn10_can_handler_max_seconds", "gauge", "Longest time spent delivering a frame."
+    );
+    for (std::size_t i = 0; i < stats.route_count; i++) {
+        const auto& route = stats.routes[i];
+        if (route.handler_calls == 0) {
+            continue;
+        }
+        detail::write_sample(
+            out, "gn10_can_handler_max_seconds", "",
+            detail::route_labels(bus, route.routing_id, -1), Seconds(route.handler_max).count()
+        );
+    }
+
+    out += "# EOF\n";
+    return out;
+}
+
+}  // namespace openmetrics
+}  // namespace gn10_can
@@ -0,0 +1,54 @@
+/**
+ * @file timestamp_extender.hpp
+ * @author Gento Aiba (aiba-gento)
+ * @brief 16bitのハードウェアタイムスタンプを64bitに拡張するクラスのヘッダーファイル
+ * @version 0.1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026 Gento Aiba
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace gn10_can {
+
+/**
+ * @brief 16bitのハードウェアタイムスタンプを64bitに拡張する
+ * @details
+ * 直前に観測した値との差分からラップアラウンドを検出して上位ビットを補います。
+ * 直前の値より古い (半周期以内に戻った) 値は、送信完了イベントのように遅れて届いた時刻として扱い、
+ * 拡張値を巻き戻さずに過去の時刻を返します。
+ * カウンタの半周期以上、時刻を観測しない期間があると正しく拡張できないため、
+ * フレーム間隔に合わせてカウンタのプリスケーラを選んでください。
+ * 1つの割り込み優先度からのみ呼び出してください。
+ */
+class TimestampExtender
+{
+public:
+    /**
+     * @brief ハードウェアタイムスタンプを拡張する
+     *
+     * @param raw 16bitのハードウェアタイムスタンプ
+     * @return uint64_t 拡張した時刻 (0にはならない)
+     */
+    uint64_t extend(uint16_t raw)
+    {
+        const uint16_t forward = static_cast<uint16_t>(raw - last_raw_);
+        if (forward < HALF_RANGE) {
+            last_raw_ = raw;
+            now_ += forward;
+            return now_;
+        }
+        return now_ - static_cast<uint16_t>(last_raw_ - raw);
+    }
+
+private:
+    static constexpr uint16_t HALF_RANGE = 0x8000;
+
+    uint16_t last_raw_ = 0;        // 直前に観測したハードウェアタイムスタンプ
+    uint64_t now_      = 0x10000;  // 直前に観測した時刻の拡張値 (0を「時刻なし」と区別するため1周期分ずらす)
+};
+
+}  // namespace gn10_can
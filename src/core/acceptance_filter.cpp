@@ -0,0 +1,218 @@
+#include "gn10_can/core/acceptance_filter.hpp"
+
+#include <array>
+#include <cstddef>
+
+namespace gn10_can {
+
+namespace {
+
+constexpr uint32_t STD_ID_MASK  = 0x7FF;
+constexpr uint32_t COMMAND_BITS = id::COMMAND_COUNT - 1;
+
+// 統合前のフィルタを保持する作業領域の大きさ
+constexpr std::size_t WORK_SIZE = MAX_ACCEPTANCE_FILTERS * 2;
+
+uint32_t popcount(uint32_t value)
+{
+    uint32_t count = 0;
+    while (value != 0) {
+        value &= value - 1;
+        count++;
+    }
+    return count;
+}
+
+// フィルタが受け付けるIDの数 (2の何乗か)
+uint32_t width_of(const AcceptanceFilter& filter)
+{
+    return popcount(~filter.mask & STD_ID_MASK);
+}
+
+// outer が受け付けるIDに inner が受け付けるIDがすべて含まれるか
+bool covers(const AcceptanceFilter& outer, const AcceptanceFilter& inner)
+{
+    return (inner.mask & outer.mask) == outer.mask &&
+           (inner.id & outer.mask) == (outer.id & outer.mask);
+}
+
+// 2つのフィルタを両方とも受け付ける最小のフィルタ
+AcceptanceFilter merge(const AcceptanceFilter& a, const AcceptanceFilter& b)
+{
+    AcceptanceFilter merged;
+    merged.mask = a.mask & b.mask & ~(a.id ^ b.id) & STD_ID_MASK;
+    merged.id   = a.id & merged.mask;
+    return merged;
+}
+
+/**
+ * @brief 統合しながらフィルタを保持する固定容量の集合
+ */
+class FilterSet
+{
+public:
+    void add(const AcceptanceFilter& filter)
+    {
+        for (std::size_t i = 0; i < size_; i++) {
+            if (covers(items_[i], filter)) {
+                return;
+            }
+        }
+        if (size_ >= items_.size()) {
+            merge_closest();
+        }
+        items_[size_] = filter;
+        size_++;
+        remove_covered(size_ - 1);
+    }
+
+    // マスクが同じで1bitだけ異なるフィルタを統合する (受け付けるIDは変わらない)
+    void merge_exact()
+    {
+        bool merged = true;
+        while (merged) {
+            merged = false;
+            for (std::size_t i = 0; i < size_ && !merged; i++) {
+                for (std::size_t j = i + 1; j < size_ && !merged; j++) {
+                    const AcceptanceFilter& a = items_[i];
+                    const AcceptanceFilter& b = items_[j];
+                    if (a.mask == b.mask && popcount((a.id ^ b.id) & a.mask) == 1) {
+                        replace_pair(i, j);
+                        merged = true;
+                    }
+                }
+            }
+        }
+    }
+
+    // 数が limit 以下になるまで、受け付けるIDの増加が少ない組から統合する
+    void shrink_to(std::size_t limit)
+    {
+        while (size_ > limit) {
+            merge_closest();
+        }
+    }
+
+    std::size_t copy_to(AcceptanceFilter* out) const
+    {
+        for (std::size_t i = 0; i < size_; i++) {
+            out[i] = items_[i];
+        }
+        return size_;
+    }
+
+private:
+    void merge_closest()
+    {
+        std::size_t best_i  = 0;
+        std::size_t best_j  = 1;
+        uint32_t best_width = STD_ID_MASK;
+        for (std::size_t i = 0; i < size_; i++) {
+            for (std::size_t j = i + 1; j < size_; j++) {
+                uint32_t width = width_of(merge(items_[i], items_[j]));
+                if (width < best_width) {
+                    best_width = width;
+                    best_i     = i;
+                    best_j     = j;
+                }
+            }
+        }
+        if (size_ >= 2) {
+            replace_pair(best_i, best_j);
+        }
+    }
+
+    // i と j を統合したフィルタを i に置き、j と統合後のフィルタに含まれるものを削除する
+    void replace_pair(std::size_t i, std::size_t j)
+    {
+        items_[i] = merge(items_[i], items_[j]);
+        erase(j);
+        if (i == size_) {
+            i = j;  // 末尾にあった i は j の位置に移動している
+        }
+        remove_covered(i);
+    }
+
+    void remove_covered(std::size_t keep)
+    {
+        std::size_t i = 0;
+        while (i < size_) {
+            if (i != keep && covers(items_[keep], items_[i])) {
+                erase(i);
+                if (keep == size_) {
+                    keep = i;
+                }
+            } else {
+                i++;
+            }
+        }
+    }
+
+    // 末尾の要素を index の位置に移して削除する
+    void erase(std::size_t index)
+    {
+        size_--;
+        items_[index] = items_[size_];
+    }
+
+    std::array<AcceptanceFilter, WORK_SIZE> items_;
+    std::size_t size_ = 0;
+};
+
+}  // namespace
+
+std::size_t plan_acceptance_filters(
+    const std::array<uint8_t, id::ROUTING_ID_COUNT>& command_masks,
+    AcceptanceFilter* out_filters,
+    std::size_t capacity
+)
+{
+    if (capacity == 0) {
+        return 0;
+    }
+
+    // コマンド部 (3bit) の部分集合を、受け付けるIDの多い順に並べたマスク
+    constexpr uint8_t COMMAND_CUBE_MASKS[] = {
+        0b000, 0b001, 0b010, 0b100, 0b011, 0b101, 0b110, 0b111
+    };
+
+    FilterSet filters;
+    for (std::size_t routing_id = 0; routing_id < command_masks.size(); routing_id++) {
+        const uint8_t accepted = command_masks[routing_id];
+        uint8_t uncovered      = accepted;
+
+        // 受け付けるコマンドの集合を、はみ出さない大きな部分集合から順に覆う
+        for (uint8_t cube_mask : COMMAND_CUBE_MASKS) {
+            for (uint8_t value = 0; value <= COMMAND_BITS; value++) {
+                if ((value & ~cube_mask) != 0) {
+                    continue;
+                }
+
+                uint8_t members = 0;
+                for (uint8_t command = 0; command <= COMMAND_BITS; command++) {
+                    if ((command & cube_mask) == value) {
+                        members |= static_cast<uint8_t>(1 << command);
+                    }
+                }
+                if ((members & accepted) != members || (members & uncovered) == 0) {
+                    continue;
+                }
+                uncovered &= static_cast<uint8_t>(~members);
+
+                AcceptanceFilter filter;
+                filter.id   = (static_cast<uint32_t>(routing_id) << id::BIT_WIDTH_COMMAND) | value;
+                filter.mask = (STD_ID_MASK & ~COMMAND_BITS) | cube_mask;
+                filters.add(filter);
+            }
+        }
+    }
+
+    filters.merge_exact();
+    if (capacity > MAX_ACCEPTANCE_FILTERS) {
+        capacity = MAX_ACCEPTANCE_FILTERS;
+    }
+    filters.shrink_to(capacity);
+    return filters.copy_to(out_filters);
+}
+
+}  // namespace gn10_can
@@ -0,0 +1,225 @@
+#include "gn10_can/core/bus_load.hpp"
+
+#include <cstddef>
+
+#include "gn10_can/core/fdcan_frame.hpp"
+
+namespace gn10_can {
+
+namespace {
+
+// CRC デリミタ (1) + ACK スロット (1) + ACK デリミタ (1) + EOF (7) + IFS (3)
+constexpr uint32_t CLASSIC_TRAILER_BITS = 13;
+// ACK スロット (1) + ACK デリミタ (1) + EOF (7) + IFS (3) (CRC デリミタはデータフェーズ側で数える)
+constexpr uint32_t FD_TRAILER_BITS = 12;
+
+constexpr uint16_t CRC15_POLY = 0x4599;
+
+/**
+ * @brief ビット列を流しながらスタッフビットと CRC-15 を数える
+ */
+class BitStream
+{
+public:
+    void push(bool bit)
+    {
+        // CRC-15 (クラシックCAN)
+        bool crc_next = bit != (((crc_ >> 14) & 1) != 0);
+        crc_          = static_cast<uint16_t>((crc_ << 1) & 0x7FFF);
+        if (crc_next) {
+            crc_ ^= CRC15_POLY;
+        }
+
+        bits_++;
+        if (run_ > 0 && bit == last_) {
+            run_++;
+        } else {
+            last_ = bit;
+            run_  = 1;
+        }
+
+        // 同じ値が5ビット続いたら反転ビットを挿入する (挿入ビットも次の連続に数える)
+        if (run_ == 5) {
+            stuff_++;
+            last_ = !bit;
+            run_  = 1;
+        }
+    }
+
+    void push_bits(uint32_t value, uint8_t width)
+    {
+        for (uint8_t i = width; i > 0; i--) {
+            push(((value >> (i - 1)) & 1) != 0);
+        }
+    }
+
+    uint32_t bits() const
+    {
+        return bits_;
+    }
+
+    uint32_t stuff() const
+    {
+        return stuff_;
+    }
+
+    uint16_t crc() const
+    {
+        return crc_;
+    }
+
+private:
+    uint32_t bits_  = 0;
+    uint32_t stuff_ = 0;
+    uint8_t run_    = 0;
+    bool last_      = false;
+    uint16_t crc_   = 0;
+};
+
+// 長さ n のスタッフ対象区間に挿入されうるスタッフビットの最大数
+constexpr uint32_t worst_stuff(uint32_t bits)
+{
+    if (bits == 0) {
+        return 0;
+    }
+    return (bits - 1) / 4;
+}
+
+uint32_t ceil_div(uint64_t numerator, uint32_t denominator)
+{
+    return static_cast<uint32_t>((numerator + denominator - 1) / denominator);
+}
+
+}  // namespace
+
+FrameBits classic_frame_bits(const CANFrameView& frame, StuffMode mode)
+{
+    uint8_t dlc = frame.dlc;
+    if (dlc > 8) {
+        dlc = 8;
+    }
+
+    BitStream stream;
+    stream.push(false);  // SOF
+    if (frame.is_extended) {
+        stream.push_bits(frame.id >> 18, 11);
+        stream.push(true);  // SRR
+        stream.push(true);  // IDE
+        stream.push_bits(frame.id & 0x3FFFF, 18);
+        stream.push(false);  // RTR
+        stream.push(false);  // r1
+        stream.push(false);  // r0
+    } else {
+        stream.push_bits(frame.id & 0x7FF, 11);
+        stream.push(false);  // RTR
+        stream.push(false);  // IDE
+        stream.push(false);  // r0
+    }
+    stream.push_bits(dlc, 4);
+    for (uint8_t i = 0; i < dlc; i++) {
+        stream.push_bits(frame.data[i], 8);
+    }
+    stream.push_bits(stream.crc(), 15);
+
+    FrameBits result;
+    if (mode == StuffMode::Actual) {
+        result.stuff = stream.stuff();
+    } else {
+        result.stuff = worst_stuff(stream.bits());
+    }
+    result.nominal = stream.bits() + result.stuff + CLASSIC_TRAILER_BITS;
+    return result;
+}
+
+FrameBits fd_frame_bits(const CANFrameView& frame, bool bit_rate_switch, StuffMode mode)
+{
+    uint8_t dlc = frame.dlc;
+    if (dlc > 64) {
+        dlc = 64;
+    }
+    const uint8_t padded = fd::padded_length(dlc);
+
+    // SOF から BRS までがアービトレーションフェーズ
+    BitStream stream;
+    stream.push(false);  // SOF
+    if (frame.is_extended) {
+        stream.push_bits(frame.id >> 18, 11);
+        stream.push(true);  // SRR
+        stream.push(true);  // IDE
+        stream.push_bits(frame.id & 0x3FFFF, 18);
+        stream.push(false);  // RRS
+    } else {
+        stream.push_bits(frame.id & 0x7FF, 11);
+        stream.push(false);  // RRS
+        stream.push(false);  // IDE
+    }
+    stream.push(true);             // FDF
+    stream.push(false);            // res
+    stream.push(bit_rate_switch);  // BRS
+
+    const uint32_t arbitration_bits  = stream.bits();
+    const uint32_t arbitration_stuff = stream.stuff();
+
+    // ESI からデータフィールドまでがデータフェーズ (ダイナミックスタッフィング)
+    stream.push(false);  // ESI
+    stream.push_bits(fd::dlc_to_code(dlc), 4);
+    for (uint8_t i = 0; i < padded; i++) {
+        uint8_t byte = fd::PADDING_BYTE;
+        if (i < dlc) {
+            byte = frame.data[i];
+        }
+        stream.push_bits(byte, 8);
+    }
+
+    uint32_t nominal_stuff = arbitration_stuff;
+    uint32_t total_stuff   = stream.stuff();
+    if (mode == StuffMode::WorstCase) {
+        nominal_stuff = worst_stuff(arbitration_bits);
+        total_stuff   = worst_stuff(stream.bits());
+    }
+
+    // スタッフカウント (4) + CRC (17 / 21) + 固定スタッフビット + CRC デリミタ
+    uint32_t crc_bits         = 17;
+    uint32_t fixed_stuff_bits = 6;
+    if (padded > 16) {
+        crc_bits         = 21;
+        fixed_stuff_bits = 7;
+    }
+    const uint32_t crc_field_bits = 4 + crc_bits + fixed_stuff_bits + 1;
+
+    const uint32_t data_stuff = total_stuff - nominal_stuff;
+
+    FrameBits result;
+    result.stuff   = total_stuff + fixed_stuff_bits;
+    result.nominal = arbitration_bits + nominal_stuff + FD_TRAILER_BITS;
+    result.data    = (stream.bits() - arbitration_bits) + data_stuff + crc_field_bits;
+
+    // ビットレートを切り替えない場合は全てアービトレーションフェーズの速度で送る
+    if (!bit_rate_switch) {
+        result.nominal += result.data;
+        result.data = 0;
+    }
+    return result;
+}
+
+FrameBits frame_bits(const CANFrameView& frame, const BitRate& rate, StuffMode mode)
+{
+    // ドライバは8バイト以下のフレームを CAN FD のバスでもクラシックCANのフレームで送る
+    if (!rate.is_fd || !fd::requires_fd_format(frame.dlc)) {
+        return classic_frame_bits(frame, mode);
+    }
+    return fd_frame_bits(frame, rate.data != 0 && rate.data != rate.nominal, mode);
+}
+
+uint32_t frame_time_ns(const CANFrameView& frame, const BitRate& rate, StuffMode mode)
+{
+    const FrameBits bits = frame_bits(frame, rate, mode);
+
+    uint32_t time_ns = ceil_div(uint64_t{bits.nominal} * 1000000000u, rate.nominal);
+    if (bits.data > 0) {
+        time_ns += ceil_div(uint64_t{bits.data} * 1000000000u, rate.data);
+    }
+    return time_ns;
+}
+
+}  // namespace gn10_can
@@ -1,5 +1,6 @@
 #include "gn10_can/core/can_bus.hpp"
 
+#include <array>
 #include <cstddef>
 
 #include "gn10_can/core/can_device.hpp"
@@ -7,57 +8,65 @@
 
 namespace gn10_can {
 
-CANBus::CANBus(drivers::ICANDriver& driver) : driver_(driver), devices_{}, device_count_(0) {}
-
-void CANBus::update()
-{
-    CANFrame frame;
-    while (driver_.receive(frame)) {
-        dispatch(frame);
-    }
-}
-
-void CANBus::dispatch(const CANFrame& frame)
+bool CANBusBase::dispatch(const CANFrameView& frame)
 {
     uint32_t routing_id = frame.get_routing_id();
 
-    for (std::size_t i = 0; i < device_count_; i++) {
-        CANDevice* device = devices_[i];
-        if (!device) {
-            continue;
-        }
+    // 未登録のルーティングIDは仮想関数を呼ぶ前に定数時間で棄却する
+    if (!routes_.contains(routing_id)) {
+        return false;
+    }
 
-        if (routing_id == device->get_routing_id()) {
-            device->on_receive(frame);
+    // 受け付けないコマンドのフレームはデバイスを呼び出さずに読み飛ばす
+    uint8_t command = frame.get_command();
+    bool delivered  = false;
+    routes_.for_each(routing_id, [command, &frame, &delivered](CANDevice& device) {
+        if (device.accepts(command)) {
+            device.handle(command, frame);
+            delivered = true;
         }
-    }
+    });
+    return delivered;
 }
 
-bool CANBus::send_frame(const CANFrame& frame)
+std::size_t CANBusBase::plan_filters(AcceptanceFilter* out_filters, std::size_t capacity) const
 {
-    return driver_.send(frame);
+    std::array<uint8_t, id::ROUTING_ID_COUNT> command_masks{};
+    for (uint32_t routing_id = 0; routing_id < command_masks.size(); routing_id++) {
+        if (!routes_.contains(routing_id)) {
+            continue;
+        }
+        uint8_t& mask = command_masks[routing_id];
+        routes_.for_each(routing_id, [&mask](CANDevice& device) {
+            for (uint8_t command = 0; command < id::COMMAND_COUNT; command++) {
+                if (device.accepts(command)) {
+                    mask |= static_cast<uint8_t>(1 << command);
+                }
+            }
+        });
+    }
+    return plan_acceptance_filters(command_masks, out_filters, capacity);
 }
 
-bool CANBus::attach(CANDevice* device)
+bool CANBusBase::attach(CANDevice* device)
 {
-    if (device_count_ < MAX_DEVICES && device != nullptr) {
-        devices_[device_count_++] = device;
-        return true;
+    if (device == nullptr) {
+        return false;
+    }
+    if (!routes_.insert(device->get_routing_id(), device)) {
+        return false;
     }
-    return false;
+    on_routes_changed();
+    return true;
 }
 
-void CANBus::detach(CANDevice* device)
+void CANBusBase::detach(CANDevice* device)
 {
-    for (std::size_t i = 0; i < device_count_; i++) {
-        if (devices_[i] == device) {
-            // 見つかった場所を削除し、最後の要素を持ってきて穴埋めする（Orderは変わるが効率的）
-            // ポインタを移動
-            devices_[i]             = devices_[--device_count_];
-            devices_[device_count_] = nullptr;  // Clear logic
-            return;
-        }
+    if (device == nullptr) {
+        return;
     }
+    routes_.remove(device->get_routing_id(), device);
+    on_routes_changed();
 }
 
 }  // namespace gn10_can
@@ -5,9 +5,12 @@
 namespace gn10_can {
 namespace devices {
 
-MotorDriverClient::MotorDriverClient(CANBus& bus, uint8_t dev_id)
+MotorDriverClient::MotorDriverClient(CANBusBase& bus, uint8_t dev_id)
     : CANDevice(bus, id::DeviceType::MotorDriver, dev_id)
 {
+    subscribe(id::MsgTypeMotorDriver::Feedback, &MotorDriverClient::on_feedback);
+    subscribe(id::MsgTypeMotorDriver::HardwareStatus, &MotorDriverClient::on_hardware_status);
+    subscribe(id::MsgTypeMotorDriver::State, &MotorDriverClient::on_state);
 }
 
 void MotorDriverClient::set_init(const MotorConfig& config)
@@ -19,7 +22,7 @@ void MotorDriverClient::set_target(float target)
 {
     std::array<uint8_t, 4> payload{};
     converter::pack(payload, 0, target);
-    send(id::MsgTypeMotorDriver::Target, payload);
+    send_latest(id::MsgTypeMotorDriver::Target, payload);
 }
 
 void MotorDriverClient::set_gain(devices::GainType type, float value)
@@ -30,28 +33,38 @@ void MotorDriverClient::set_gain(devices::GainType type, float value)
     send(id::MsgTypeMotorDriver::Gain, payload);
 }
 
-void MotorDriverClient::on_receive(const CANFrame& frame)
+void MotorDriverClient::on_feedback(const CANFrameView& frame)
 {
-    auto id_fields = id::unpack(frame.id);
+    float val;
+    uint8_t sw;
+    if (converter::unpack(frame.data, frame.dlc, 0, val)) {
+        feedback_value_ = val;
+    }
+    if (converter::unpack(frame.data, frame.dlc, 4, sw)) {
+        limit_switches_ = sw;
+    }
+}
 
-    if (id_fields.is_command(id::MsgTypeMotorDriver::Feedback)) {
-        float val;
-        uint8_t sw;
-        if (converter::unpack(frame.data.data(), frame.dlc, 0, val)) {
-            feedback_value_ = val;
-        }
-        if (converter::unpack(frame.data.data(), frame.dlc, 4, sw)) {
-            limit_switches_ = sw;
-        }
-    } else if (id_fields.is_command(id::MsgTypeMotorDriver::HardwareStatus)) {
-        float curr;
-        int8_t temp;
-        if (converter::unpack(frame.data.data(), frame.dlc, 0, curr)) {
-            load_current_ = curr;
-        }
-        if (converter::unpack(frame.data.data(), frame.dlc, 4, temp)) {
-            temperature_ = temp;
-        }
+void MotorDriverClient::on_hardware_status(const CANFrameView& frame)
+{
+    float curr;
+    int8_t temp;
+    if (converter::unpack(frame.data, frame.dlc, 0, curr)) {
+        load_current_ = curr;
+    }
+    if (converter::unpack(frame.data, frame.dlc, 4, temp)) {
+        temperature_ = temp;
+    }
+}
+
+void MotorDriverClient::on_state(const CANFrameView& frame)
+{
+    MotorState state;
+    if (MotorStateSchema::unpack(frame, state)) {
+        feedback_value_ = state.feedback;
+        load_current_   = state.load_current;
+        temperature_    = state.temperature;
+        limit_switches_ = state.limit_switches;
     }
 }
 
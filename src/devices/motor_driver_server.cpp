@@ -5,9 +5,12 @@
 namespace gn10_can {
 namespace devices {
 
-MotorDriverServer::MotorDriverServer(CANBus& bus, uint8_t dev_id)
+MotorDriverServer::MotorDriverServer(CANBusBase& bus, uint8_t dev_id)
     : CANDevice(bus, id::DeviceType::MotorDriver, dev_id)
 {
+    subscribe(id::MsgTypeMotorDriver::Init, &MotorDriverServer::on_init);
+    subscribe(id::MsgTypeMotorDriver::Target, &MotorDriverServer::on_target);
+    subscribe(id::MsgTypeMotorDriver::Gain, &MotorDriverServer::on_gain);
 }
 
 void MotorDriverServer::send_feedback(float feedback_val, uint8_t limit_switch_state)
@@ -26,56 +29,59 @@ void MotorDriverServer::send_hardware_status(float load_current, int8_t temperat
     send(id::MsgTypeMotorDriver::HardwareStatus, payload);
 }
 
+void MotorDriverServer::send_state(const MotorState& state)
+{
+    send(id::MsgTypeMotorDriver::State, MotorStateSchema::pack(state));
+}
+
 bool MotorDriverServer::get_new_init(MotorConfig& config)
 {
-    if (config_.has_value()) {
-        config = config_.value();
-        config_.reset();
-        return true;
-    }
-    return false;
+    return config_.take(config);
 }
 
 bool MotorDriverServer::get_new_target(float& target)
 {
-    if (target_.has_value()) {
-        target = target_.value();
-        target_.reset();
-        return true;
-    }
-    return false;
+    return target_.take(target);
 }
 
 bool MotorDriverServer::get_new_gain(GainType type, float& value)
 {
     auto index = static_cast<std::size_t>(type);
-    if (index < kGainTypeCount && gains_[index].has_value()) {
-        value = gains_[index].value();
-        gains_[index].reset();
-        return true;
+    if (index < kGainTypeCount) {
+        return gains_[index].take(value);
     }
     return false;
 }
 
-void MotorDriverServer::on_receive(const CANFrame& frame)
+const Mailbox<float>& MotorDriverServer::target_mailbox() const
 {
-    auto id_fields = id::unpack(frame.id);
+    return target_;
+}
 
-    if (id_fields.is_command(id::MsgTypeMotorDriver::Init)) {
-        config_ = MotorConfig::from_bytes(frame.data);
-    } else if (id_fields.is_command(id::MsgTypeMotorDriver::Target)) {
-        float val;
-        if (converter::unpack(frame.data.data(), frame.dlc, 0, val)) {
-            target_ = val;
-        }
-    } else if (id_fields.is_command(id::MsgTypeMotorDriver::Gain)) {
-        if (frame.dlc >= 5) {
-            uint8_t type_val = frame.data[0];
-            float gain_val;
-            if (type_val < static_cast<uint8_t>(GainType::Count) &&
-                converter::unpack(frame.data.data(), frame.dlc, 1, gain_val)) {
-                gains_[type_val] = gain_val;
-            }
+void MotorDriverServer::on_init(const CANFrameView& frame)
+{
+    std::array<uint8_t, 8> bytes;
+    if (converter::unpack(frame.data, frame.dlc, 0, bytes)) {
+        config_.post(MotorConfig::from_bytes(bytes), frame.timestamp);
+    }
+}
+
+void MotorDriverServer::on_target(const CANFrameView& frame)
+{
+    float val;
+    if (converter::unpack(frame.data, frame.dlc, 0, val)) {
+        target_.post(val, frame.timestamp);
+    }
+}
+
+void MotorDriverServer::on_gain(const CANFrameView& frame)
+{
+    if (frame.dlc >= 5) {
+        uint8_t type_val = frame.data[0];
+        float gain_val;
+        if (type_val < static_cast<uint8_t>(GainType::Count) &&
+            converter::unpack(frame.data, frame.dlc, 1, gain_val)) {
+            gains_[type_val].post(gain_val, frame.timestamp);
         }
     }
 }
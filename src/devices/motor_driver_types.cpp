@@ -1,5 +1,7 @@
 #include "gn10_can/devices/motor_driver_types.hpp"
 
+#include "gn10_can/utils/can_converter.hpp"
+
 namespace gn10_can {
 namespace devices {
 
@@ -25,38 +27,34 @@ float MotorConfig::get_accel_ratio() const
 
 void MotorConfig::set_forward_limit_switch(bool enable_stop, uint8_t switch_id)
 {
+    // Forward bits: enable (7), switch id (6-4)
     uint8_t val = data_.limit_switches_config;
-    // Clear forward bits (7-4)
-    val &= 0x0F;
-    // Set new forward bits
-    if (enable_stop) val |= (1 << 7);
-    val |= (switch_id & 0x07) << 4;
+    converter::pack_bits(&val, 1, 7, 1, enable_stop);
+    converter::pack_bits(&val, 1, 4, 3, switch_id);
     data_.limit_switches_config = val;
 }
 
 void MotorConfig::get_forward_limit_switch(bool& enable_stop, uint8_t& switch_id) const
 {
-    uint8_t val = data_.limit_switches_config;
-    enable_stop = (val >> 7) & 0x01;
-    switch_id   = (val >> 4) & 0x07;
+    const uint8_t val = data_.limit_switches_config;
+    converter::unpack_bits(&val, 1, 7, 1, enable_stop);
+    converter::unpack_bits(&val, 1, 4, 3, switch_id);
 }
 
 void MotorConfig::set_reverse_limit_switch(bool enable_stop, uint8_t switch_id)
 {
+    // Reverse bits: enable (3), switch id (2-0)
     uint8_t val = data_.limit_switches_config;
-    // Clear reverse bits (3-0)
-    val &= 0xF0;
-    // Set new reverse bits
-    if (enable_stop) val |= (1 << 3);
-    val |= (switch_id & 0x07);
+    converter::pack_bits(&val, 1, 3, 1, enable_stop);
+    converter::pack_bits(&val, 1, 0, 3, switch_id);
     data_.limit_switches_config = val;
 }
 
 void MotorConfig::get_reverse_limit_switch(bool& enable_stop, uint8_t& switch_id) const
 {
-    uint8_t val = data_.limit_switches_config;
-    enable_stop = (val >> 3) & 0x01;
-    switch_id   = val & 0x07;
+    const uint8_t val = data_.limit_switches_config;
+    converter::unpack_bits(&val, 1, 3, 1, enable_stop);
+    converter::unpack_bits(&val, 1, 0, 3, switch_id);
 }
 
 void MotorConfig::set_feedback_cycle(uint8_t ms)
@@ -5,17 +5,16 @@
 namespace gn10_can {
 
 namespace devices {
-PowerManagerClient::PowerManagerClient(FDCANBus& bus, uint8_t dev_id)
-    : FDCANDevice(bus, id::DeviceType::PowerManager, dev_id)
+PowerManagerClient::PowerManagerClient(CANBusBase& bus, uint8_t dev_id)
+    : CANDevice(bus, id::DeviceType::PowerManager, dev_id)
 {
+    subscribe(id::MsgTypePowerManager::Status, &PowerManagerClient::on_status);
+    subscribe(id::MsgTypePowerManager::Sensor, &PowerManagerClient::on_sensor);
 }
 
 void PowerManagerClient::set_init(power_manager::Config config)
 {
-    std::array<uint8_t, 3> payload{};
-    converter::pack(payload, 0, config.use_remote_emergency_stop);
-    converter::pack(payload, 1, config.sensor_rate_ms);
-    send(id::MsgTypePowerManager::Init, payload);
+    send(id::MsgTypePowerManager::Init, power_manager::ConfigSchema::pack(config));
 }
 
 void PowerManagerClient::set_stop(bool enable_stop)
@@ -27,51 +26,37 @@ void PowerManagerClient::set_stop(bool enable_stop)
 
 bool PowerManagerClient::get_new_status(power_manager::Status& status)
 {
-    if (status_.has_value()) {
-        status = status_.value();
-        status_.reset();
-        return true;
-    }
-    return false;
+    return status_.take(status);
 }
 
 bool PowerManagerClient::get_new_sensor(power_manager::Sensor& sensor)
 {
-    if (sensor_.has_value()) {
-        sensor = sensor_.value();
-        sensor_.reset();
-        return true;
+    return sensor_.take(sensor);
+}
+
+const Mailbox<power_manager::Status>& PowerManagerClient::status_mailbox() const
+{
+    return status_;
+}
+
+const Mailbox<power_manager::Sensor>& PowerManagerClient::sensor_mailbox() const
+{
+    return sensor_;
+}
+
+void PowerManagerClient::on_status(const CANFrameView& frame)
+{
+    power_manager::Status status{};
+    if (power_manager::StatusSchema::unpack(frame, status)) {
+        status_.post(status, frame.timestamp);
     }
-    return false;
 }
 
-void PowerManagerClient::on_receive(const FDCANFrame& frame)
+void PowerManagerClient::on_sensor(const CANFrameView& frame)
 {
-    auto id_fields = id::unpack(frame.id);
-    if (id_fields.is_command(id::MsgTypePowerManager::Status)) {
-        bool emergency_stop_enabled;
-        bool remote_emergency_stop_connected;
-        bool remote_emergency_stop_enabled;
-        bool over_current;
-        if (converter::unpack(frame.data.data(), frame.dlc, 0, emergency_stop_enabled) &&
-            converter::unpack(frame.data.data(), frame.dlc, 1, remote_emergency_stop_connected) &&
-            converter::unpack(frame.data.data(), frame.dlc, 2, remote_emergency_stop_enabled) &&
-            converter::unpack(frame.data.data(), frame.dlc, 3, over_current)) {
-            status_                                         = power_manager::Status{};
-            status_.value().emergency_stop_enabled          = emergency_stop_enabled;
-            status_.value().remote_emergency_stop_connected = remote_emergency_stop_connected;
-            status_.value().remote_emergency_stop_enabled   = remote_emergency_stop_enabled;
-            status_.value().over_current                    = over_current;
-        }
-    } else if (id_fields.is_command(id::MsgTypePowerManager::Sensor)) {
-        float voltage;
-        float current;
-        if (converter::unpack(frame.data.data(), frame.dlc, 0, voltage) &&
-            converter::unpack(frame.data.data(), frame.dlc, 4, current)) {
-            sensor_                 = power_manager::Sensor{};
-            sensor_.value().voltage = voltage;
-            sensor_.value().current = current;
-        }
+    power_manager::Sensor sensor{};
+    if (power_manager::SensorSchema::unpack(frame, sensor)) {
+        sensor_.post(sensor, frame.timestamp);
     }
 }
 
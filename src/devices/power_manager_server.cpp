@@ -5,65 +5,46 @@
 namespace gn10_can {
 namespace devices {
 
-PowerManagerServer::PowerManagerServer(FDCANBus& bus, uint8_t dev_id)
-    : FDCANDevice(bus, id::DeviceType::PowerManager, dev_id)
+PowerManagerServer::PowerManagerServer(CANBusBase& bus, uint8_t dev_id)
+    : CANDevice(bus, id::DeviceType::PowerManager, dev_id)
 {
+    subscribe(id::MsgTypePowerManager::Init, &PowerManagerServer::on_init);
+    subscribe(id::MsgTypePowerManager::Stop, &PowerManagerServer::on_stop);
 }
 
 bool PowerManagerServer::get_new_init(power_manager::Config& config)
 {
-    if (config_.has_value()) {
-        config = config_.value();
-        config_.reset();
-        return true;
-    }
-    return false;
+    return config_.take(config);
 }
 
 bool PowerManagerServer::get_new_stop(bool& enable_stop)
 {
-    if (enable_stop_.has_value()) {
-        enable_stop = enable_stop_.value();
-        enable_stop_.reset();
-        return true;
-    }
-    return false;
+    return enable_stop_.take(enable_stop);
 }
 
 void PowerManagerServer::set_status(power_manager::Status status)
 {
-    std::array<uint8_t, 4> payload{};
-    converter::pack(payload, 0, status.emergency_stop_enabled);
-    converter::pack(payload, 1, status.remote_emergency_stop_connected);
-    converter::pack(payload, 2, status.remote_emergency_stop_enabled);
-    converter::pack(payload, 3, status.over_current);
-    send(id::MsgTypePowerManager::Status, payload);
+    send(id::MsgTypePowerManager::Status, power_manager::StatusSchema::pack(status));
 }
 
 void PowerManagerServer::set_sensor(power_manager::Sensor sensor)
 {
-    std::array<uint8_t, 8> payload{};
-    converter::pack(payload, 0, sensor.voltage);
-    converter::pack(payload, 4, sensor.current);
-    send(id::MsgTypePowerManager::Sensor, payload);
+    send(id::MsgTypePowerManager::Sensor, power_manager::SensorSchema::pack(sensor));
 }
 
-void PowerManagerServer::on_receive(const FDCANFrame& frame)
+void PowerManagerServer::on_init(const CANFrameView& frame)
 {
-    auto id_fields = id::unpack(frame.id);
-    if (id_fields.is_command(id::MsgTypePowerManager::Init)) {
-        power_manager::Config config{};
-        if (converter::unpack(frame.data.data(), frame.dlc, 0, config.use_remote_emergency_stop) &&
-            converter::unpack(frame.data.data(), frame.dlc, 1, config.sensor_rate_ms)) {
-            config_         = power_manager::Config{};
-            config_.value() = config;
-        }
+    power_manager::Config config{};
+    if (power_manager::ConfigSchema::unpack(frame, config)) {
+        config_.post(config, frame.timestamp);
     }
-    if (id_fields.is_command(id::MsgTypePowerManager::Stop)) {
-        bool enable_stop;
-        if (converter::unpack(frame.data.data(), frame.dlc, 0, enable_stop)) {
-            enable_stop_.value() = enable_stop;
-        }
+}
+
+void PowerManagerServer::on_stop(const CANFrameView& frame)
+{
+    bool enable_stop;
+    if (converter::unpack(frame.data, frame.dlc, 0, enable_stop)) {
+        enable_stop_.post(enable_stop, frame.timestamp);
     }
 }
 
@@ -5,9 +5,11 @@
 namespace gn10_can {
 namespace devices {
 
-ServoMotorClient::ServoMotorClient(CANBus& bus, uint8_t device_id)
+ServoMotorClient::ServoMotorClient(CANBusBase& bus, uint8_t device_id)
     : CANDevice(bus, id::DeviceType::ServoMotor, device_id)
 {
+    // 受信するコマンドはない
+    set_command_mask(0);
 }
 
 void ServoMotorClient::set_init(uint16_t min_us, uint16_t max_us)
@@ -22,10 +24,8 @@ void ServoMotorClient::set_angle_rad(const std::array<float, 2>& angles_rad)
 {
     std::array<uint8_t, 8> payload{};
     converter::pack(payload, 0, angles_rad);
-    send(id::MsgTypeServoMotor::AngleRad, payload);
+    send_latest(id::MsgTypeServoMotor::AngleRad, payload);
 }
 
-void ServoMotorClient::on_receive(const CANFrame&) {}
-
 }  // namespace devices
 }  // namespace gn10_can
\ No newline at end of file
@@ -5,9 +5,11 @@
 namespace gn10_can {
 namespace devices {
 
-SolenoidDriverClient::SolenoidDriverClient(CANBus& bus, uint8_t dev_id)
+SolenoidDriverClient::SolenoidDriverClient(CANBusBase& bus, uint8_t dev_id)
     : CANDevice(bus, id::DeviceType::SolenoidDriver, dev_id)
 {
+    // 受信するコマンドはない
+    set_command_mask(0);
 }
 
 void SolenoidDriverClient::set_init()
@@ -25,14 +27,12 @@ void SolenoidDriverClient::set_target(const uint8_t& target)
 
 void SolenoidDriverClient::set_target(const std::array<bool, 8>& target)
 {
-    uint8_t data = 0;
-    for (int i = 0; i < 8; i++) {
-        data |= static_cast<uint8_t>(target[i]) << i;
+    std::array<uint8_t, 1> payload{};
+    for (size_t i = 0; i < target.size(); i++) {
+        converter::pack_bits(payload, i, 1, target[i]);
     }
-    set_target(data);
+    send(id::MsgTypeSolenoidDriver::Target, payload);
 }
 
-void SolenoidDriverClient::on_receive(const CANFrame&) {}
-
 }  // namespace devices
 }  // namespace gn10_can
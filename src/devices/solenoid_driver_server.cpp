@@ -5,26 +5,21 @@
 namespace gn10_can {
 namespace devices {
 
-SolenoidDriverServer::SolenoidDriverServer(CANBus& bus, uint8_t dev_id)
+SolenoidDriverServer::SolenoidDriverServer(CANBusBase& bus, uint8_t dev_id)
     : CANDevice(bus, id::DeviceType::SolenoidDriver, dev_id)
 {
+    subscribe(id::MsgTypeSolenoidDriver::Init, &SolenoidDriverServer::on_init);
+    subscribe(id::MsgTypeSolenoidDriver::Target, &SolenoidDriverServer::on_target);
 }
 
 bool SolenoidDriverServer::get_new_init()
 {
-    if (init_.has_value()) {
-        return false;
-    }
-    return true;
+    uint8_t init;
+    return init_.take(init);
 }
 bool SolenoidDriverServer::get_new_target(uint8_t& target)
 {
-    if (!target_.has_value()) {
-        return false;
-    }
-    target = target_.value();
-    target_.reset();
-    return true;
+    return target_.take(target);
 }
 
 bool SolenoidDriverServer::get_new_target(std::array<bool, 8>& target)
@@ -33,26 +28,30 @@ bool SolenoidDriverServer::get_new_target(std::array<bool, 8>& target)
     if (!get_new_target(data)) {
         return false;
     }
-    for (int i = 0; i < 8; i++) {
-        target[i] = (data >> i) & 1;
+    for (size_t i = 0; i < target.size(); i++) {
+        converter::unpack_bits(&data, 1, i, 1, target[i]);
     }
     return true;
 }
 
-void SolenoidDriverServer::on_receive(const CANFrame& frame)
+const Mailbox<uint8_t>& SolenoidDriverServer::target_mailbox() const
+{
+    return target_;
+}
+
+void SolenoidDriverServer::on_init(const CANFrameView& frame)
+{
+    uint8_t value;
+    if (converter::unpack(frame.data, frame.dlc, 0, value)) {
+        init_.post(value, frame.timestamp);
+    }
+}
+
+void SolenoidDriverServer::on_target(const CANFrameView& frame)
 {
-    auto id_fields = id::unpack(frame.id);
-
-    if (id_fields.is_command(id::MsgTypeSolenoidDriver::Init)) {
-        uint8_t value;
-        if (converter::unpack(frame.data.data(), frame.dlc, 0, value)) {
-            init_ = value;
-        }
-    } else if (id_fields.is_command(id::MsgTypeSolenoidDriver::Target)) {
-        uint8_t value;
-        if (converter::unpack(frame.data.data(), frame.dlc, 0, value)) {
-            target_ = value;
-        }
+    uint8_t value;
+    if (converter::unpack(frame.data, frame.dlc, 0, value)) {
+        target_.post(value, frame.timestamp);
     }
 }
 
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "gn10_can/core/can_device.hpp"
+
+// 受信したフレームを数えるデバイス
+class CountingDevice : public gn10_can::CANDevice
+{
+public:
+    CountingDevice(
+        gn10_can::CANBusBase& bus,
+        uint8_t id,
+        gn10_can::id::DeviceType type = gn10_can::id::DeviceType::MotorDriver
+    )
+        : CANDevice(bus, type, id)
+    {
+    }
+
+    void on_receive(const gn10_can::CANFrameView& frame) override
+    {
+        if (frame.dlc > 0) {
+            values.push_back(frame.data[0]);
+        }
+        last_dlc.store(frame.dlc, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::atomic<int> count{0};         // 受信数 (任意のスレッドから読める)
+    std::atomic<uint8_t> last_dlc{0};  // 最後に受信したフレームのデータ長
+    std::vector<uint8_t> values;       // 受信したフレームの先頭バイト (受信処理のスレッドのみ)
+};
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+// テストから進める時計 (std::chrono の Clock 要件を満たす)
+struct ManualClock {
+    using rep        = int64_t;
+    using period     = std::micro;
+    using duration   = std::chrono::duration<rep, period>;
+    using time_point = std::chrono::time_point<ManualClock>;
+
+    static constexpr bool is_steady = true;
+
+    static time_point now()
+    {
+        return time_point(duration(ticks));
+    }
+
+    static inline int64_t ticks = 0;
+};
@@ -1,20 +1,25 @@
 #pragma once
 
+#include <cstddef>
 #include <queue>
 #include <vector>
 
 #include "gn10_can/drivers/can_driver_interface.hpp"
+#include "gn10_can/drivers/fdcan_driver_interface.hpp"
 
-class MockDriver : public gn10_can::drivers::ICANDriver
+template <std::size_t MaxDLC>
+class BasicMockDriver : public gn10_can::detail::ICANDriver<MaxDLC>
 {
 public:
-    bool send(const gn10_can::CANFrame& frame) override
+    using Frame = gn10_can::detail::CANFrame<MaxDLC>;
+
+    bool send(const Frame& frame) override
     {
         sent_frames.push_back(frame);
         return true;
     }
 
-    bool receive(gn10_can::CANFrame& out_frame) override
+    bool receive(Frame& out_frame) override
     {
         if (receive_queue.empty()) {
             return false;
@@ -24,12 +29,20 @@ public:
         return true;
     }
 
+    std::size_t receive_pending() const override
+    {
+        return receive_queue.size();
+    }
+
     // Helper methods for testing
-    void push_receive_frame(const gn10_can::CANFrame& frame)
+    void push_receive_frame(const Frame& frame)
     {
         receive_queue.push(frame);
     }
 
-    std::vector<gn10_can::CANFrame> sent_frames;
-    std::queue<gn10_can::CANFrame> receive_queue;
+    std::vector<Frame> sent_frames;
+    std::queue<Frame> receive_queue;
 };
+
+using MockDriver   = BasicMockDriver<8>;
+using MockFDDriver = BasicMockDriver<64>;
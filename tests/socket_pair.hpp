@@ -0,0 +1,84 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <linux/can.h>
+
+#include <cstdint>
+#include <cstring>
+
+// CAN_RAW ソケットの代わりに、フレームをそのままデータグラムで送受信するソケットの組
+class SocketPair
+{
+public:
+    SocketPair()
+    {
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds) == 0) {
+            driver_fd = fds[0];
+            peer_fd   = fds[1];
+        }
+    }
+
+    ~SocketPair()
+    {
+        close_peer();
+    }
+
+    SocketPair(const SocketPair&)            = delete;
+    SocketPair& operator=(const SocketPair&) = delete;
+
+    // クラシックCANのフレームを書き込む (data が nullptr の場合は0で埋める)
+    void write_classic(canid_t can_id, const uint8_t* data, uint8_t len)
+    {
+        struct can_frame raw{};
+        raw.can_id = can_id;
+        raw.len    = len;
+        if (data != nullptr) {
+            std::memcpy(raw.data, data, len);
+        }
+        ASSERT_EQ(::send(peer_fd, &raw, CAN_MTU, 0), static_cast<ssize_t>(CAN_MTU));
+    }
+
+    // CAN FD のフレームを書き込む (data が nullptr の場合は0で埋める)
+    void write_fd(canid_t can_id, const uint8_t* data, uint8_t len)
+    {
+        struct canfd_frame raw{};
+        raw.can_id = can_id;
+        raw.len    = len;
+        if (data != nullptr) {
+            std::memcpy(raw.data, data, len);
+        }
+        ASSERT_EQ(::send(peer_fd, &raw, CANFD_MTU, 0), static_cast<ssize_t>(CANFD_MTU));
+    }
+
+    // 受信したバイト数を返す (データがなければ -1)
+    ssize_t read(struct canfd_frame& out_raw)
+    {
+        return ::recv(peer_fd, &out_raw, sizeof(out_raw), MSG_DONTWAIT);
+    }
+
+    // 受信したフレームを読み捨て、その数を返す
+    int drain()
+    {
+        struct canfd_frame raw;
+        int count = 0;
+        while (read(raw) > 0) {
+            count++;
+        }
+        return count;
+    }
+
+    void close_peer()
+    {
+        if (peer_fd >= 0) {
+            ::close(peer_fd);
+            peer_fd = -1;
+        }
+    }
+
+    int driver_fd = -1;
+    int peer_fd   = -1;
+};
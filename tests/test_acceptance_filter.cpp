@@ -0,0 +1,242 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <vector>
+
+#include "gn10_can/core/acceptance_filter.hpp"
+#include "gn10_can/core/can_bus.hpp"
+#include "gn10_can/core/can_device.hpp"
+#include "gn10_can/devices/motor_driver_server.hpp"
+#include "mock_driver.hpp"
+
+using namespace gn10_can;
+using gn10_can::devices::MotorDriverServer;
+
+using CommandMasks = std::array<uint8_t, id::ROUTING_ID_COUNT>;
+
+// 受信フィルタに対応したドライバ
+class FilterDriver : public MockDriver
+{
+public:
+    explicit FilterDriver(std::size_t capacity) : capacity(capacity) {}
+
+    std::size_t filter_capacity() const override
+    {
+        return capacity;
+    }
+
+    bool set_filters(const AcceptanceFilter* filters, std::size_t count) override
+    {
+        this->filters.assign(filters, filters + count);
+        filtering = true;
+        set_count++;
+        return true;
+    }
+
+    bool clear_filters() override
+    {
+        filters.clear();
+        filtering = false;
+        return true;
+    }
+
+    // ハードウェアが受け付ける標準IDか
+    bool accepts(uint32_t std_id) const
+    {
+        if (!filtering) {
+            return true;
+        }
+        for (const AcceptanceFilter& filter : filters) {
+            if (filter.matches(std_id)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::size_t capacity;
+    std::vector<AcceptanceFilter> filters;
+    bool filtering        = false;
+    std::size_t set_count = 0;
+};
+
+class CommandDevice : public CANDevice
+{
+public:
+    CommandDevice(CANBusBase& bus, id::DeviceType type, uint8_t id, uint8_t mask)
+        : CANDevice(bus, type, id)
+    {
+        set_command_mask(mask);
+    }
+
+    void declare(uint8_t mask)
+    {
+        set_command_mask(mask);
+    }
+};
+
+static bool expected_accept(const CommandMasks& masks, uint32_t std_id)
+{
+    return ((masks[std_id >> id::BIT_WIDTH_COMMAND] >> (std_id & 0x07)) & 0x01) != 0;
+}
+
+static bool filters_accept(const AcceptanceFilter* filters, std::size_t count, uint32_t std_id)
+{
+    for (std::size_t i = 0; i < count; i++) {
+        if (filters[i].matches(std_id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+TEST(AcceptanceFilterTest, NothingToAccept)
+{
+    CommandMasks masks{};
+    std::array<AcceptanceFilter, MAX_ACCEPTANCE_FILTERS> filters;
+
+    EXPECT_EQ(plan_acceptance_filters(masks, filters.data(), filters.size()), 0u);
+
+    masks[0x12] = 0xFF;
+    EXPECT_EQ(plan_acceptance_filters(masks, filters.data(), 0), 0u);
+}
+
+TEST(AcceptanceFilterTest, MergesAdjacentDevicesExactly)
+{
+    // MotorDriver 0 ~ 3 の全コマンドは1つのフィルタ (0x080 / 0x7E0) に収まる
+    CommandMasks masks{};
+    for (uint8_t dev_id = 0; dev_id < 4; dev_id++) {
+        masks[(1 << id::BIT_WIDTH_DEV_ID) | dev_id] = CANDevice::ALL_COMMANDS;
+    }
+    std::array<AcceptanceFilter, MAX_ACCEPTANCE_FILTERS> filters;
+
+    ASSERT_EQ(plan_acceptance_filters(masks, filters.data(), filters.size()), 1u);
+    EXPECT_EQ(filters[0].id, 0x080u);
+    EXPECT_EQ(filters[0].mask, 0x7E0u);
+}
+
+TEST(AcceptanceFilterTest, CoversExactlyWhenCapacityAllows)
+{
+    CommandMasks masks{};
+    masks[0x10] = 0b00000110;
+    masks[0x11] = 0b00000110;
+    masks[0x12] = 0b10000001;
+    masks[0x75] = CANDevice::ALL_COMMANDS;
+    masks[0x80] = 0b01010101;
+    std::array<AcceptanceFilter, MAX_ACCEPTANCE_FILTERS> filters;
+
+    std::size_t count = plan_acceptance_filters(masks, filters.data(), filters.size());
+    ASSERT_GT(count, 0u);
+    EXPECT_LE(count, 7u);
+    for (uint32_t std_id = 0; std_id <= 0x7FF; std_id++) {
+        EXPECT_EQ(filters_accept(filters.data(), count, std_id), expected_accept(masks, std_id))
+            << "std_id=0x" << std::hex << std_id;
+    }
+}
+
+TEST(AcceptanceFilterTest, WidensFiltersToFitCapacity)
+{
+    // 16台のデバイスがそれぞれ異なるコマンドを受け付ける
+    CommandMasks masks{};
+    for (uint32_t i = 0; i < 16; i++) {
+        masks[(i * 37) & 0xFF] = static_cast<uint8_t>(1 << (i % 8));
+    }
+    std::array<AcceptanceFilter, MAX_ACCEPTANCE_FILTERS> filters;
+
+    for (std::size_t capacity = 1; capacity <= 8; capacity++) {
+        std::size_t count = plan_acceptance_filters(masks, filters.data(), capacity);
+        ASSERT_GT(count, 0u);
+        ASSERT_LE(count, capacity);
+
+        // 受け付けるべきIDは必ず通す
+        for (uint32_t std_id = 0; std_id <= 0x7FF; std_id++) {
+            if (expected_accept(masks, std_id)) {
+                EXPECT_TRUE(filters_accept(filters.data(), count, std_id))
+                    << "capacity=" << capacity << " std_id=0x" << std::hex << std_id;
+            }
+        }
+    }
+}
+
+TEST(AcceptanceFilterTest, BusReprogramsFiltersOnAttachAndDetach)
+{
+    FilterDriver driver(8);
+    CANBus bus(driver);
+
+    using Cmd = id::MsgTypeMotorDriver;
+
+    CommandDevice motor(bus, id::DeviceType::MotorDriver, 0, 0b00000010);
+    bus.update();
+    EXPECT_TRUE(driver.filtering);
+    EXPECT_TRUE(driver.accepts(id::pack(id::DeviceType::MotorDriver, 0, Cmd::Target)));
+    EXPECT_FALSE(driver.accepts(id::pack(id::DeviceType::MotorDriver, 0, Cmd::Init)));
+    EXPECT_FALSE(driver.accepts(0x7FF));
+
+    const uint32_t servo_id =
+        id::pack(id::DeviceType::ServoMotor, 3, id::MsgTypeServoMotor::AngleRad);
+    {
+        CommandDevice servo(bus, id::DeviceType::ServoMotor, 3, CANDevice::ALL_COMMANDS);
+        bus.update();
+        EXPECT_TRUE(driver.accepts(servo_id));
+        EXPECT_EQ(bus.hardware_filter_count(), driver.filters.size());
+    }
+
+    // 切断したデバイス宛てのフレームは通さない
+    bus.update();
+    EXPECT_FALSE(driver.accepts(servo_id));
+
+    // 受け付けるコマンドの変更も反映する
+    std::size_t set_count = driver.set_count;
+    motor.declare(0);
+    bus.update();
+    EXPECT_GT(driver.set_count, set_count);
+    EXPECT_TRUE(driver.filters.empty());
+    EXPECT_EQ(bus.hardware_filter_count(), 0u);
+}
+
+TEST(AcceptanceFilterTest, ReprogramsOncePerUpdate)
+{
+    FilterDriver driver(8);
+    CANBus bus(driver);
+
+    // コンストラクタでの subscribe() ごとには設定しない
+    MotorDriverServer server(bus, 1);
+    CommandDevice servo(bus, id::DeviceType::ServoMotor, 3, CANDevice::ALL_COMMANDS);
+    EXPECT_EQ(driver.set_count, 0u);
+
+    bus.update();
+    EXPECT_EQ(driver.set_count, 1u);
+    EXPECT_TRUE(driver.accepts(
+        id::pack(id::DeviceType::MotorDriver, 1, id::MsgTypeMotorDriver::Target)
+    ));
+
+    // 変更がなければ設定し直さない
+    bus.update();
+    EXPECT_EQ(driver.set_count, 1u);
+}
+
+TEST(AcceptanceFilterTest, FilteringCanBeDisabled)
+{
+    FilterDriver driver(4);
+    CANBus bus(driver);
+    CommandDevice motor(bus, id::DeviceType::MotorDriver, 0, 0b00000010);
+    bus.update();
+    ASSERT_TRUE(driver.filtering);
+
+    bus.set_hardware_filter_enabled(false);
+    EXPECT_FALSE(driver.filtering);
+    EXPECT_TRUE(driver.accepts(0x7FF));
+
+    bus.set_hardware_filter_enabled(true);
+    EXPECT_TRUE(driver.filtering);
+    EXPECT_FALSE(driver.accepts(0x7FF));
+}
+
+TEST(AcceptanceFilterTest, DriversWithoutFiltersAreLeftAlone)
+{
+    MockDriver driver;
+    CANBus bus(driver);
+    CommandDevice motor(bus, id::DeviceType::MotorDriver, 0, 0b00000010);
+
+    EXPECT_EQ(bus.hardware_filter_count(), 0u);
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+
+#include "gn10_can/core/bus_load.hpp"
+#include "gn10_can/core/can_bus.hpp"
+#include "gn10_can/core/fdcan_frame.hpp"
+#include "manual_clock.hpp"
+#include "mock_driver.hpp"
+
+using namespace gn10_can;
+
+static CANFrame make_frame(uint32_t id, uint8_t dlc, uint8_t fill, bool is_extended = false)
+{
+    CANFrame frame;
+    frame.id          = id;
+    frame.dlc         = dlc;
+    frame.is_extended = is_extended;
+    frame.data.fill(fill);
+    return frame;
+}
+
+TEST(FrameBitsTest, ClassicWorstCaseMatchesKnownLengths)
+{
+    // 標準ID 8バイト: 135ビット、拡張ID 8バイト: 160ビット、標準ID 0バイト: 55ビット
+    EXPECT_EQ(classic_frame_bits(make_frame(0x123, 8, 0), StuffMode::WorstCase).total(), 135u);
+    EXPECT_EQ(
+        classic_frame_bits(make_frame(0x123, 8, 0, true), StuffMode::WorstCase).total(), 160u
+    );
+    EXPECT_EQ(classic_frame_bits(make_frame(0x123, 0, 0), StuffMode::WorstCase).total(), 55u);
+}
+
+TEST(FrameBitsTest, ClassicActualStuffingDependsOnPayload)
+{
+    FrameBits zeros       = classic_frame_bits(make_frame(0x000, 8, 0x00), StuffMode::Actual);
+    FrameBits alternating = classic_frame_bits(make_frame(0x555, 8, 0x55), StuffMode::Actual);
+    FrameBits worst       = classic_frame_bits(make_frame(0x000, 8, 0x00), StuffMode::WorstCase);
+
+    // 同じ値が続くデータほどスタッフビットが多く、最悪値を超えない
+    EXPECT_GT(zeros.stuff, alternating.stuff);
+    EXPECT_LE(zeros.total(), worst.total());
+    EXPECT_GE(alternating.total(), 111u);  // スタッフビットなしの長さ
+    EXPECT_EQ(alternating.data, 0u);
+}
+
+TEST(FrameBitsTest, FDFrameSplitsArbitrationAndDataPhase)
+{
+    FDCANFrame frame;
+    frame.id  = 0x123;
+    frame.dlc = 64;
+
+    FrameBits bits = fd_frame_bits(frame, true, StuffMode::WorstCase);
+    // SOF~BRS (17) + スタッフ (4) + ACK~IFS (12)
+    EXPECT_EQ(bits.nominal, 33u);
+    // ESI~データ (517) + スタッフ (129) + スタッフカウント・CRC21・固定スタッフ7・CRCデリミタ (33)
+    EXPECT_EQ(bits.data, 679u);
+
+    // ビットレートを切り替えない場合は全てアービトレーションフェーズ
+    FrameBits no_brs = fd_frame_bits(frame, false, StuffMode::WorstCase);
+    EXPECT_EQ(no_brs.data, 0u);
+    EXPECT_EQ(no_brs.total(), bits.total());
+}
+
+TEST(FrameBitsTest, FDPayloadIsPaddedToValidLength)
+{
+    FDCANFrame short_frame;
+    short_frame.id  = 0x100;
+    short_frame.dlc = 9;
+    FDCANFrame padded_frame = short_frame;
+    padded_frame.dlc        = 12;
+    for (uint8_t i = 9; i < 12; i++) {
+        padded_frame.data[i] = fd::PADDING_BYTE;
+    }
+
+    EXPECT_EQ(fd::padded_length(9), 12);
+    EXPECT_EQ(fd::padded_length(33), 48);
+    EXPECT_EQ(
+        fd_frame_bits(short_frame, true, StuffMode::Actual).total(),
+        fd_frame_bits(padded_frame, true, StuffMode::Actual).total()
+    );
+}
+
+TEST(FrameBitsTest, FrameTimeUsesPhaseBitRates)
+{
+    CANFrame classic = make_frame(0x123, 8, 0);
+    EXPECT_EQ(frame_time_ns(classic, BitRate::classic(500000), StuffMode::WorstCase), 270000u);
+
+    FDCANFrame fd_frame;
+    fd_frame.id  = 0x123;
+    fd_frame.dlc = 64;
+    // 33ビット @ 1Mbps + 679ビット @ 5Mbps
+    EXPECT_EQ(
+        frame_time_ns(fd_frame, BitRate::fd(1000000, 5000000), StuffMode::WorstCase),
+        33000u + 135800u
+    );
+}
+
+TEST(FrameBitsTest, FDRateCostsShortFramesAsClassic)
+{
+    // 8バイト以下のフレームは CAN FD のバスでもクラシックCANのフレームで送られる
+    const BitRate rate = BitRate::fd(1000000, 5000000);
+    CANFrame classic   = make_frame(0x123, 8, 0);
+    EXPECT_EQ(frame_bits(classic, rate, StuffMode::WorstCase).total(), 135u);
+    EXPECT_EQ(frame_bits(classic, rate, StuffMode::WorstCase).data, 0u);
+    EXPECT_EQ(frame_time_ns(classic, rate, StuffMode::WorstCase), 135000u);
+
+    FDCANFrame long_frame;
+    long_frame.id  = 0x123;
+    long_frame.dlc = 12;
+    EXPECT_GT(frame_bits(long_frame, rate, StuffMode::WorstCase).data, 0u);
+}
+
+TEST(BusLoadMeterTest, ReportsLoadOverSlidingWindows)
+{
+    using Meter = BusLoadMeter<ManualClock, 4>;
+    Meter meter(BitRate::classic(1000000), std::chrono::milliseconds(1), StuffMode::WorstCase);
+
+    // 1区間目に 135us のフレームを3つ
+    CANFrame frame = make_frame(0x123, 8, 0);
+    for (int i = 0; i < 3; i++) {
+        meter.record(frame, ManualClock::time_point(std::chrono::microseconds(100 + i)));
+    }
+
+    auto now = ManualClock::time_point(std::chrono::microseconds(1500));
+    EXPECT_FLOAT_EQ(meter.load(now, 1), 0.405f);
+    EXPECT_FLOAT_EQ(meter.load(now, 4), 0.405f / 4);
+
+    // 次の区間は1フレーム。最大値は1区間目のまま
+    meter.record(frame, now);
+    now = ManualClock::time_point(std::chrono::microseconds(2500));
+    EXPECT_FLOAT_EQ(meter.load(now, 1), 0.135f);
+    EXPECT_FLOAT_EQ(meter.load(now, 2), 0.27f);
+    EXPECT_FLOAT_EQ(meter.peak_load(), 0.405f);
+
+    // 計測窓より古い区間は数えない
+    now = ManualClock::time_point(std::chrono::milliseconds(20));
+    EXPECT_FLOAT_EQ(meter.load(now), 0.0f);
+}
+
+TEST(BusLoadMeterTest, WorksAsBusStatsPolicy)
+{
+    using Meter = BusLoadMeter<ManualClock, 4>;
+    MockDriver driver;
+    InstrumentedCANBus<Meter> bus{
+        driver,
+        Meter(BitRate::classic(1000000), std::chrono::milliseconds(1), StuffMode::WorstCase)
+    };
+
+    ManualClock::ticks = 0;
+    bus.send_frame(make_frame(0x123, 8, 0));
+    driver.push_receive_frame(make_frame(0x321, 8, 0));
+    bus.update();
+
+    ManualClock::ticks = 1000;
+    auto stats         = bus.stats();
+    EXPECT_EQ(stats.frames, 2u);
+    EXPECT_FLOAT_EQ(stats.last_load, 0.27f);
+}
@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <type_traits>
+
+#include "gn10_can/core/bus_stats.hpp"
+#include "gn10_can/core/can_bus.hpp"
+#include "gn10_can/core/can_device.hpp"
+#include "gn10_can/core/fdcan_frame.hpp"
+#include "gn10_can/utils/openmetrics.hpp"
+#include "manual_clock.hpp"
+#include "mock_driver.hpp"
+
+using namespace gn10_can;
+
+using Stats    = BusStats<ManualClock, 4>;
+using StatsBus = InstrumentedCANBus<Stats>;
+
+// 受信処理に指定した時間がかかるデバイス
+class WorkDevice : public CANDevice
+{
+public:
+    WorkDevice(CANBusBase& bus, uint8_t id) : CANDevice(bus, id::DeviceType::MotorDriver, id) {}
+
+    void on_receive(const CANFrameView& frame) override
+    {
+        ManualClock::ticks += frame.data[0];
+    }
+};
+
+// 送信を止められるドライバ (受信オーバーラン数を報告する)
+class StalledDriver : public MockDriver
+{
+public:
+    bool send(const CANFrame& frame) override
+    {
+        if (stalled) {
+            return false;
+        }
+        return MockDriver::send(frame);
+    }
+
+    uint32_t rx_overrun_count() const override
+    {
+        return overruns;
+    }
+
+    bool stalled      = true;
+    uint32_t overruns = 0;
+};
+
+static CANFrame make_frame(uint8_t dev_id, uint8_t command, uint8_t work, uint8_t dlc = 1)
+{
+    CANFrame frame;
+    frame.id      = id::pack(
+        id::DeviceType::MotorDriver, dev_id, static_cast<id::MsgTypeMotorDriver>(command)
+    );
+    frame.dlc     = dlc;
+    frame.data[0] = work;
+    return frame;
+}
+
+TEST(BusStatsTest, DisabledPolicyHasNoState)
+{
+    static_assert(!NoStats::ENABLED);
+    static_assert(std::is_empty<NoStats>::value);
+    static_assert(std::is_empty<NoStats::Snapshot>::value);
+
+    MockDriver driver;
+    CANBus bus{driver};
+    auto snapshot = bus.stats();
+    static_assert(std::is_same<decltype(snapshot), NoStats::Snapshot>::value);
+}
+
+TEST(BusStatsTest, CountsReceivedFramesPerRouteAndCommand)
+{
+    MockDriver driver;
+    StatsBus bus{driver};
+    WorkDevice device(bus, 1);
+
+    ManualClock::ticks = 0;
+    driver.push_receive_frame(make_frame(1, 2, 5, 3));
+    driver.push_receive_frame(make_frame(1, 2, 15, 3));
+    driver.push_receive_frame(make_frame(1, 4, 10));
+    driver.push_receive_frame(make_frame(7, 2, 0));  // 配送先なし
+    bus.update();
+
+    auto stats = bus.stats();
+    EXPECT_EQ(stats.rx_frames, 4u);
+    EXPECT_EQ(stats.rx_bytes, 8u);
+    EXPECT_EQ(stats.unrouted_frames, 1u);
+    ASSERT_EQ(stats.route_count, 1u);
+
+    const auto& route = stats.routes[0];
+    EXPECT_EQ(route.routing_id, device.get_routing_id());
+    EXPECT_EQ(route.commands[2].rx_frames, 2u);
+    EXPECT_EQ(route.commands[2].rx_bytes, 6u);
+    EXPECT_EQ(route.commands[4].rx_frames, 1u);
+    EXPECT_EQ(route.handler_calls, 3u);
+    EXPECT_EQ(route.handler_max, ManualClock::duration(15));
+    EXPECT_EQ(route.handler_mean(), ManualClock::duration(10));
+}
+
+TEST(BusStatsTest, CountsSentFramesWhenDriverAcceptsThem)
+{
+    MockDriver driver;
+    StatsBus bus{driver};
+
+    bus.send_frame(make_frame(3, 1, 0, 8));
+    bus.send_frame_latest(CANFrameView(make_frame(3, 1, 0, 8)));
+
+    auto stats = bus.stats();
+    EXPECT_EQ(stats.tx_frames, 2u);
+    EXPECT_EQ(stats.tx_bytes, 16u);
+    ASSERT_EQ(stats.route_count, 1u);
+    EXPECT_EQ(stats.routes[0].commands[1].tx_frames, 2u);
+    EXPECT_EQ(stats.routes[0].handler_calls, 0u);
+}
+
+TEST(BusStatsTest, CountsQueuedFramesWhenFlushed)
+{
+    StalledDriver driver;
+    StatsBus bus{driver};
+
+    EXPECT_TRUE(bus.send_frame(make_frame(3, 1, 0, 4)));
+    EXPECT_EQ(bus.stats().tx_frames, 0u);
+
+    // 送信キューから送り出した時点で記録する
+    driver.stalled = false;
+    bus.on_tx_complete();
+
+    auto stats = bus.stats();
+    EXPECT_EQ(stats.tx_frames, 1u);
+    EXPECT_EQ(stats.tx_bytes, 4u);
+    EXPECT_EQ(stats.send_failures, 0u);
+}
+
+TEST(BusStatsTest, CountsSendFailuresAndDriverOverruns)
+{
+    StalledDriver driver;
+    driver.overruns = 7;
+    StatsBus bus{driver};
+
+    for (std::size_t i = 0; i < StatsBus::TX_QUEUE_SIZE; i++) {
+        bus.send_frame(make_frame(3, 1, 0));
+    }
+    EXPECT_FALSE(bus.send_frame(make_frame(3, 1, 0)));
+
+    // CAN FD フレームはクラシックCANのバスで送信できない
+    FDCANFrame fd_frame;
+    fd_frame.dlc = 12;
+    EXPECT_FALSE(bus.send_frame(CANFrameView(fd_frame)));
+
+    auto stats = bus.stats();
+    EXPECT_EQ(stats.send_failures, 2u);
+    EXPECT_EQ(stats.rx_overruns, 7u);
+    EXPECT_EQ(stats.tx_frames, 0u);
+}
+
+TEST(BusStatsTest, RoutesBeyondCapacityAreCountedAsUntracked)
+{
+    MockDriver driver;
+    StatsBus bus{driver};
+
+    for (uint8_t dev_id = 0; dev_id < 6; dev_id++) {
+        bus.send_frame(make_frame(dev_id, 0, 0));
+    }
+
+    auto stats = bus.stats();
+    EXPECT_EQ(stats.tx_frames, 6u);
+    EXPECT_EQ(stats.route_count, 4u);
+    EXPECT_EQ(stats.untracked, 2u);
+}
+
+TEST(BusStatsTest, ExportsOpenMetricsText)
+{
+    MockDriver driver;
+    StatsBus bus{driver};
+    WorkDevice device(bus, 1);
+
+    ManualClock::ticks = 0;
+    driver.push_receive_frame(make_frame(1, 2, 20));
+    bus.update();
+
+    std::string text = openmetrics::to_text(bus.stats(), "can\"0");
+
+    EXPECT_NE(text.find("# TYPE gn10_can_rx_frames counter\n"), std::string::npos);
+    EXPECT_NE(text.find("gn10_can_rx_frames_total{bus=\"can\\\"0\"} 1\n"), std::string::npos);
+    EXPECT_NE(
+        text.find(
+            "gn10_can_route_rx_frames_total{bus=\"can\\\"0\",routing_id=\"0x11\",command=\"2\"} 1\n"
+        ),
+        std::string::npos
+    );
+    EXPECT_NE(
+        text.find("gn10_can_handler_max_seconds{bus=\"can\\\"0\",routing_id=\"0x11\"} 2e-05\n"),
+        std::string::npos
+    );
+    EXPECT_EQ(text.substr(text.size() - 6), "# EOF\n");
+}
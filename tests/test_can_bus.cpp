@@ -1,7 +1,14 @@
 #include <gtest/gtest.h>
 
+#include <chrono>
+
 #include "gn10_can/core/can_bus.hpp"
 #include "gn10_can/core/can_device.hpp"
+#include "gn10_can/core/fdcan_bus.hpp"
+#include "gn10_can/devices/esc_hub_client.hpp"
+#include "gn10_can/devices/esc_hub_server.hpp"
+#include "gn10_can/devices/motor_driver_client.hpp"
+#include "gn10_can/devices/motor_driver_server.hpp"
 #include "mock_driver.hpp"
 
 using namespace gn10_can;
@@ -11,12 +18,35 @@ class MockDevice : public CANDevice
 public:
     MockDevice(CANBus& bus, id::DeviceType type, uint8_t id) : CANDevice(bus, type, id) {}
 
-    void on_receive(const CANFrame& frame) override
+    void on_receive(const CANFrameView& frame) override
+    {
+        received_frames.push_back(CANFrame(frame));
+    }
+
+    std::vector<CANFrame> received_frames;
+};
+
+class HandlerDevice : public CANDevice
+{
+public:
+    HandlerDevice(CANBus& bus, uint8_t id) : CANDevice(bus, id::DeviceType::MotorDriver, id)
+    {
+        subscribe(id::MsgTypeMotorDriver::Target, &HandlerDevice::on_target);
+    }
+
+    void on_receive(const CANFrameView& frame) override
     {
-        received_frames.push_back(frame);
+        received_frames.push_back(CANFrame(frame));
     }
 
+    std::vector<CANFrame> target_frames;
     std::vector<CANFrame> received_frames;
+
+private:
+    void on_target(const CANFrameView& frame)
+    {
+        target_frames.push_back(CANFrame(frame));
+    }
 };
 
 class CANBusTest : public ::testing::Test
@@ -104,3 +134,240 @@ TEST_F(CANBusTest, SendFrame)
     ASSERT_EQ(driver.sent_frames.size(), 1);
     EXPECT_EQ(driver.sent_frames[0].id, 0x456);
 }
+
+TEST_F(CANBusTest, SharedRoutingIdDeliversToAll)
+{
+    // Client と Server のように同じルーティングIDを持つデバイスは両方に配送される
+    MockDevice device1(bus, id::DeviceType::MotorDriver, 1);
+    MockDevice device2(bus, id::DeviceType::MotorDriver, 1);
+
+    CANFrame frame;
+    frame.id = device1.get_routing_id() << id::BIT_WIDTH_COMMAND;
+    driver.push_receive_frame(frame);
+    bus.update();
+
+    EXPECT_EQ(device1.received_frames.size(), 1);
+    EXPECT_EQ(device2.received_frames.size(), 1);
+}
+
+TEST_F(CANBusTest, UnknownRoutingIdIgnored)
+{
+    MockDevice device(bus, id::DeviceType::MotorDriver, 1);
+
+    CANFrame frame;
+    frame.id = id::pack(id::DeviceType::MotorDriver, 2, id::MsgTypeMotorDriver::Target);
+    driver.push_receive_frame(frame);
+    bus.update();
+
+    EXPECT_EQ(device.received_frames.size(), 0);
+}
+
+TEST_F(CANBusTest, SlotReusedAfterDetach)
+{
+    std::vector<std::unique_ptr<MockDevice>> devices;
+    for (std::size_t i = 0; i < CANBus::MAX_DEVICES; ++i) {
+        devices.push_back(std::make_unique<MockDevice>(bus, id::DeviceType::MotorDriver, i));
+    }
+
+    // 1つ解放すれば新しいデバイスを登録できる
+    devices.front().reset();
+    MockDevice device(bus, id::DeviceType::ServoMotor, 3);
+
+    CANFrame frame;
+    frame.id = device.get_routing_id() << id::BIT_WIDTH_COMMAND;
+    driver.push_receive_frame(frame);
+    bus.update();
+
+    EXPECT_EQ(device.received_frames.size(), 1);
+}
+
+TEST_F(CANBusTest, SubscribedCommandGoesToHandler)
+{
+    HandlerDevice device(bus, 1);
+
+    driver.push_receive_frame(
+        CANFrame::make(id::DeviceType::MotorDriver, 1, id::MsgTypeMotorDriver::Target)
+    );
+    driver.push_receive_frame(
+        CANFrame::make(id::DeviceType::MotorDriver, 1, id::MsgTypeMotorDriver::Feedback)
+    );
+    bus.update();
+
+    // 登録したコマンドだけがハンドラに届き、それ以外は on_receive() にも届かない
+    EXPECT_EQ(device.target_frames.size(), 1);
+    EXPECT_EQ(device.received_frames.size(), 0);
+}
+
+TEST(FDCANBusTest, ClassicAndFDDevicesShareOneBus)
+{
+    MockFDDriver driver;
+    FDCANBus bus{driver};
+    devices::MotorDriverClient motor_client{bus, 1};
+    devices::MotorDriverServer motor_server{bus, 1};
+    devices::ESCHubClient esc_client{bus, 1};
+    devices::ESCHubServer esc_server{bus, 1};
+
+    float angular_velocities[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+    motor_client.set_target(0.5f);
+    esc_client.set_angular_velocities(angular_velocities);
+
+    // 送信したフレームを折り返し、1回の update() で両方のデバイスに配送する
+    for (const auto& frame : driver.sent_frames) {
+        driver.push_receive_frame(frame);
+    }
+    bus.update();
+
+    float target = 0.0f;
+    EXPECT_TRUE(motor_server.get_new_target(target));
+    EXPECT_FLOAT_EQ(target, 0.5f);
+
+    float received[4] = {};
+    EXPECT_TRUE(esc_server.get_angular_velocities(received));
+    EXPECT_FLOAT_EQ(received[3], 4.0f);
+}
+
+TEST(FDCANBusTest, OversizedPayloadRejectedOnClassicBus)
+{
+    MockDriver driver;
+    CANBus bus{driver};
+
+    FDCANFrame frame = FDCANFrame::make(
+        id::DeviceType::ESCHub, 1, id::MsgTypeESCHub::AngularVelocities, nullptr, 16
+    );
+    EXPECT_FALSE(bus.send_frame(frame));
+    EXPECT_TRUE(driver.sent_frames.empty());
+}
+
+class BatchDriver : public MockDriver
+{
+public:
+    std::size_t receive_many(CANFrame* out_frames, std::size_t max_count) override
+    {
+        receive_many_calls++;
+        return MockDriver::receive_many(out_frames, max_count);
+    }
+
+    std::size_t send_many(const CANFrame* frames, std::size_t count) override
+    {
+        send_many_calls++;
+        return MockDriver::send_many(frames, count);
+    }
+
+    int receive_many_calls = 0;
+    int send_many_calls    = 0;
+};
+
+TEST(CANBusBatchTest, UpdateDrainsWithBatchReceive)
+{
+    BatchDriver driver;
+    CANBus bus{driver};
+    MockDevice device(bus, id::DeviceType::MotorDriver, 1);
+
+    CANFrame frame;
+    frame.id = device.get_routing_id() << id::BIT_WIDTH_COMMAND;
+    for (std::size_t i = 0; i < CANBus::RX_BATCH_SIZE + 2; i++) {
+        driver.push_receive_frame(frame);
+    }
+    bus.update();
+
+    EXPECT_EQ(device.received_frames.size(), CANBus::RX_BATCH_SIZE + 2);
+    EXPECT_EQ(driver.receive_many_calls, 2);
+}
+
+TEST(CANBusBatchTest, SendFramesUsesBatchSend)
+{
+    BatchDriver driver;
+    CANBus bus{driver};
+
+    std::array<CANFrame, 3> frames{};
+    frames[0].id = 0x100;
+    frames[1].id = 0x080;
+    frames[2].id = 0x200;
+    std::array<CANFrameView, 3> views{frames[0], frames[1], frames[2]};
+
+    CANBusBase& base = bus;
+    EXPECT_EQ(base.send_frames(views.data(), views.size()), 3);
+    EXPECT_EQ(driver.send_many_calls, 1);
+    ASSERT_EQ(driver.sent_frames.size(), 3);
+    EXPECT_EQ(driver.sent_frames[1].id, 0x080);
+}
+
+// テスト用の時計 (now() を呼ぶたびに1ティック進む)
+struct StepClock {
+    using rep        = int64_t;
+    using period     = std::micro;
+    using duration   = std::chrono::duration<rep, period>;
+    using time_point = std::chrono::time_point<StepClock>;
+
+    static constexpr bool is_steady = true;
+
+    static time_point now()
+    {
+        return time_point(duration(ticks++));
+    }
+
+    static inline int64_t ticks = 0;
+};
+
+class CANBusBudgetTest : public ::testing::Test
+{
+protected:
+    void push_frames(std::size_t count)
+    {
+        CANFrame frame;
+        frame.id  = device.get_routing_id() << id::BIT_WIDTH_COMMAND;
+        frame.dlc = 1;
+        for (std::size_t i = 0; i < count; i++) {
+            frame.data[0] = static_cast<uint8_t>(i);
+            driver.push_receive_frame(frame);
+        }
+    }
+
+    MockDriver driver;
+    CANBus bus{driver};
+    MockDevice device{bus, id::DeviceType::MotorDriver, 1};
+};
+
+TEST_F(CANBusBudgetTest, FrameBudgetCarriesBacklogOver)
+{
+    push_frames(20);
+
+    UpdateResult result = bus.update(5);
+    EXPECT_EQ(result.processed, 5);
+    EXPECT_EQ(result.pending, 15);
+    EXPECT_EQ(device.received_frames.size(), 5);
+
+    // 持ち越したフレームは順序を保って次回に配送される
+    result = bus.update(100);
+    EXPECT_EQ(result.processed, 15);
+    EXPECT_EQ(result.pending, 0);
+    ASSERT_EQ(device.received_frames.size(), 20);
+    for (std::size_t i = 0; i < device.received_frames.size(); i++) {
+        EXPECT_EQ(device.received_frames[i].data[0], i);
+    }
+}
+
+TEST_F(CANBusBudgetTest, DeadlineStopsProcessing)
+{
+    push_frames(20);
+
+    StepClock::ticks = 0;
+    UpdateResult result = bus.update(StepClock::time_point(StepClock::duration(4)));
+    EXPECT_EQ(result.processed, 4);
+    EXPECT_EQ(result.pending, 16);
+
+    // 期限と上限の両方を指定した場合は先に達した方で打ち切る
+    StepClock::ticks = 0;
+    result           = bus.update(StepClock::time_point(StepClock::duration(100)), 3);
+    EXPECT_EQ(result.processed, 3);
+    EXPECT_EQ(result.pending, 13);
+}
+
+TEST_F(CANBusBudgetTest, SteadyClockDeadline)
+{
+    push_frames(3);
+
+    UpdateResult result = bus.update(std::chrono::steady_clock::now() + std::chrono::seconds(1));
+    EXPECT_EQ(result.processed, 3);
+    EXPECT_EQ(result.pending, 0);
+}
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <limits>
+
 #include "gn10_can/utils/can_converter.hpp"
 
 using namespace gn10_can::converter;
@@ -51,3 +54,209 @@ TEST(ConverterTest, ArrayPack)
 
     EXPECT_EQ(value, unpacked_value);
 }
+
+enum class Mode : uint8_t { Idle = 0, Run = 5, Fault = 7 };
+
+// コンパイル時にも使用できる
+constexpr std::array<uint8_t, 2> make_flags()
+{
+    std::array<uint8_t, 2> buffer{};
+    pack_bits(buffer, 0, 1, true);
+    pack_bits(buffer, 1, 3, Mode::Run);
+    pack_bits(buffer, 6, 4, uint8_t{0x0F});
+    return buffer;
+}
+static_assert(make_flags()[0] == 0xCB, "bits are numbered from the LSB of the first byte");
+static_assert(make_flags()[1] == 0x03, "fields may cross a byte boundary");
+
+TEST(ConverterTest, PackUnpackBits)
+{
+    std::array<uint8_t, 8> buffer{};
+    EXPECT_TRUE(pack_bits(buffer, 0, 1, true));
+    EXPECT_TRUE(pack_bits(buffer, 1, 1, false));
+    EXPECT_TRUE(pack_bits(buffer, 2, 3, Mode::Fault));
+    EXPECT_TRUE(pack_bits(buffer, 5, 12, uint16_t{0xABC}));
+    EXPECT_TRUE(pack_bits(buffer, 17, 7, int8_t{-3}));
+
+    bool flag_a      = false;
+    bool flag_b      = true;
+    Mode mode        = Mode::Idle;
+    uint16_t counter = 0;
+    int8_t offset    = 0;
+    EXPECT_TRUE(unpack_bits(buffer, 0, 1, flag_a));
+    EXPECT_TRUE(unpack_bits(buffer, 1, 1, flag_b));
+    EXPECT_TRUE(unpack_bits(buffer, 2, 3, mode));
+    EXPECT_TRUE(unpack_bits(buffer, 5, 12, counter));
+    EXPECT_TRUE(unpack_bits(buffer, 17, 7, offset));
+    EXPECT_TRUE(flag_a);
+    EXPECT_FALSE(flag_b);
+    EXPECT_EQ(mode, Mode::Fault);
+    EXPECT_EQ(counter, 0xABC);
+    EXPECT_EQ(offset, -3);
+
+    // 24 ビットに収まり、残りのバイトは変更しない
+    for (size_t i = 3; i < buffer.size(); i++) {
+        EXPECT_EQ(buffer[i], 0);
+    }
+}
+
+TEST(ConverterTest, PackBitsKeepsNeighbouringBits)
+{
+    std::array<uint8_t, 2> buffer{0xFF, 0xFF};
+    EXPECT_TRUE(pack_bits(buffer, 6, 4, uint8_t{0}));
+    EXPECT_EQ(buffer[0], 0x3F);
+    EXPECT_EQ(buffer[1], 0xFC);
+
+    // ビット幅に収まらない値は上位ビットを切り捨てる
+    EXPECT_TRUE(pack_bits(buffer, 6, 4, uint8_t{0x35}));
+    uint8_t value = 0;
+    EXPECT_TRUE(unpack_bits(buffer, 6, 4, value));
+    EXPECT_EQ(value, 0x05);
+}
+
+TEST(ConverterTest, PackBitsFullWidth)
+{
+    std::array<uint8_t, 9> buffer{};
+    const uint64_t value = 0x0123456789ABCDEFull;
+    EXPECT_TRUE(pack_bits(buffer, 4, 64, value));
+
+    uint64_t unpacked_value = 0;
+    EXPECT_TRUE(unpack_bits(buffer, 4, 64, unpacked_value));
+    EXPECT_EQ(unpacked_value, value);
+}
+
+TEST(ConverterTest, BitsOutOfBounds)
+{
+    std::array<uint8_t, 2> buffer{};
+    uint8_t value = 0;
+    EXPECT_FALSE(pack_bits(buffer, 14, 3, uint8_t{1}));
+    EXPECT_FALSE(unpack_bits(buffer, 14, 3, value));
+    EXPECT_FALSE(pack_bits(buffer, 0, 0, uint8_t{1}));
+    EXPECT_FALSE(pack_bits(buffer, 0, 9, uint8_t{1}));
+    EXPECT_TRUE(pack_bits(buffer, 13, 3, uint8_t{7}));
+    EXPECT_EQ(buffer[1], 0xE0);
+}
+
+TEST(ConverterTest, HalfFloatConversion)
+{
+    // 半精度で表せる値は誤差なく往復する
+    const float exact[] = {
+        0.0f, 1.0f, -2.5f, 0.099975586f, 65504.0f, 6.1035156e-05f, 5.9604645e-08f
+    };
+    for (float value : exact) {
+        EXPECT_EQ(half_to_float(float_to_half(value)), value);
+    }
+    EXPECT_EQ(float_to_half(1.0f), 0x3C00);
+    EXPECT_EQ(float_to_half(-2.0f), 0xC000);
+    EXPECT_EQ(float_to_half(-0.0f), 0x8000);
+
+    // 最も近い値に丸め、同距離の場合は偶数側
+    EXPECT_EQ(float_to_half(1.0f + 1.0f / 2048.0f), 0x3C00);
+    EXPECT_EQ(float_to_half(1.0f + 3.0f / 2048.0f), 0x3C02);
+    EXPECT_EQ(float_to_half(1.0f + 1.1f / 1024.0f), 0x3C01);
+
+    // 範囲外の有限値は飽和、無限大と NaN は保持
+    EXPECT_EQ(float_to_half(1.0e6f), 0x7BFF);
+    EXPECT_EQ(float_to_half(-65520.0f), 0xFBFF);
+    EXPECT_EQ(float_to_half(std::numeric_limits<float>::infinity()), 0x7C00);
+    EXPECT_TRUE(std::isnan(half_to_float(float_to_half(std::nanf("")))));
+    EXPECT_EQ(float_to_half(1.0e-9f), 0x0000);
+}
+
+TEST(ConverterTest, PackUnpackHalf)
+{
+    std::array<uint8_t, 4> buffer{};
+    EXPECT_TRUE(pack_half(buffer, 2, 12.34f));
+    EXPECT_FALSE(pack_half(buffer, 3, 1.0f));
+
+    float value = 0.0f;
+    EXPECT_TRUE(unpack_half(buffer, 2, value));
+    EXPECT_NEAR(value, 12.34f, 0.01f);
+}
+
+TEST(ConverterTest, FixedPointRoundsAndSaturates)
+{
+    EXPECT_EQ(to_fixed<int16_t>(1.234f, 0.01f), 123);
+    EXPECT_EQ(to_fixed<int16_t>(1.235f, 0.01f), 124);
+    EXPECT_EQ(to_fixed<int16_t>(-1.236f, 0.01f), -124);
+    EXPECT_EQ(to_fixed<int16_t>(500.0f, 0.01f), 32767);
+    EXPECT_EQ(to_fixed<int16_t>(-500.0f, 0.01f), -32768);
+    EXPECT_EQ(to_fixed<uint8_t>(-1.0f, 0.5f), 0);
+    EXPECT_EQ(to_fixed<uint8_t>(std::nanf(""), 0.5f), 0);
+    EXPECT_EQ(to_fixed<int32_t>(1.0e12f, 1.0f), std::numeric_limits<int32_t>::max());
+
+    std::array<uint8_t, 4> buffer{};
+    EXPECT_TRUE(pack_fixed<int16_t>(buffer, 1, -3.21f, 0.01f));
+    float value = 0.0f;
+    EXPECT_TRUE(unpack_fixed<int16_t>(buffer, 1, 0.01f, value));
+    EXPECT_NEAR(value, -3.21f, 1e-5f);
+    EXPECT_FALSE(unpack_fixed<int32_t>(buffer, 1, 0.01f, value));
+}
+
+static_assert(byte_swap(uint16_t{0x1234}) == 0x3412, "byte_swap is usable at compile time");
+static_assert(byte_swap(uint32_t{0x12345678}) == 0x78563412, "byte_swap is usable at compile time");
+static_assert(byte_swap(uint64_t{0x0102030405060708}) == 0x0807060504030201,
+              "byte_swap is usable at compile time");
+
+TEST(ConverterTest, PackArrayByteOrder)
+{
+    const uint32_t values[2] = {0x11223344, 0xAABBCCDD};
+
+    std::array<uint8_t, 9> little{};
+    EXPECT_TRUE(pack_array(little, 1, values, 2));
+    const std::array<uint8_t, 9> expected_little{
+        0x00, 0x44, 0x33, 0x22, 0x11, 0xDD, 0xCC, 0xBB, 0xAA
+    };
+    EXPECT_EQ(little, expected_little);
+
+    std::array<uint8_t, 9> big{};
+    EXPECT_TRUE(pack_array<Endian::Big>(big, 1, values, 2));
+    const std::array<uint8_t, 9> expected_big{
+        0x00, 0x11, 0x22, 0x33, 0x44, 0xAA, 0xBB, 0xCC, 0xDD
+    };
+    EXPECT_EQ(big, expected_big);
+
+    uint32_t unpacked[2] = {};
+    EXPECT_TRUE(unpack_array<Endian::Big>(big, 1, unpacked, 2));
+    EXPECT_EQ(unpacked[0], values[0]);
+    EXPECT_EQ(unpacked[1], values[1]);
+}
+
+TEST(ConverterTest, PackArrayRoundTrip)
+{
+    // CAN FD の64バイトのペイロードに float 16個
+    std::array<float, 16> values{};
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<float>(i) * -1.5f;
+    }
+    std::array<uint8_t, 64> buffer{};
+    EXPECT_TRUE(pack_array<Endian::Big>(buffer, 0, values));
+
+    std::array<float, 16> unpacked{};
+    EXPECT_TRUE(unpack_array<Endian::Big>(buffer, 0, unpacked));
+    EXPECT_EQ(unpacked, values);
+
+    // 各要素は1つずつ converter::pack() した場合と同じ (リトルエンディアンのマイコン・PC)
+    const int16_t small[3] = {-2, 300, 7};
+    std::array<uint8_t, 6> bulk{};
+    std::array<uint8_t, 6> single{};
+    EXPECT_TRUE(pack_array(bulk, 0, small, 3));
+    for (uint8_t i = 0; i < 3; i++) {
+        pack(single, static_cast<uint8_t>(i * 2), small[i]);
+    }
+    if (NATIVE_ENDIAN == Endian::Little) {
+        EXPECT_EQ(bulk, single);
+    }
+}
+
+TEST(ConverterTest, PackArrayOutOfBounds)
+{
+    const float values[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+    std::array<uint8_t, 16> buffer{};
+    EXPECT_FALSE(pack_array(buffer, 1, values, 4));
+    EXPECT_TRUE(pack_array(buffer, 0, values, 4));
+
+    float unpacked[4] = {};
+    EXPECT_FALSE(unpack_array(buffer.data(), 15, 0, unpacked, 4));
+    EXPECT_EQ(unpacked[0], 0.0f);
+}
@@ -2,6 +2,7 @@
 
 #include "gn10_can/core/can_frame.hpp"
 #include "gn10_can/core/can_id.hpp"
+#include "gn10_can/core/fdcan_frame.hpp"
 
 using namespace gn10_can;
 
@@ -51,3 +52,18 @@ TEST(CANFrameTest, SetData)
     EXPECT_EQ(frame.dlc, 8);
     EXPECT_EQ(frame.data[7], 0x80);
 }
+
+TEST(CANFrameTest, ShortFramesUseClassicFormatOnFDBus)
+{
+    // 8バイト以下のフレームは CAN FD のバスでもクラシックCANのフレームで送る
+    FDCANFrame frame = FDCANFrame::make(
+        id::DeviceType::MotorDriver, 1, id::MsgTypeMotorDriver::Target, {1, 2, 3, 4, 5, 6, 7, 8}
+    );
+    EXPECT_EQ(frame.dlc, 8);
+    EXPECT_FALSE(fd::requires_fd_format(frame.dlc));
+    EXPECT_FALSE(fd::requires_fd_format(0));
+
+    frame.dlc = 9;
+    EXPECT_TRUE(fd::requires_fd_format(frame.dlc));
+    EXPECT_TRUE(fd::requires_fd_format(64));
+}
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <linux/can.h>
+
+#include <chrono>
+#include <thread>
+
+#include "drivers/socketcan/driver_socketcan.hpp"
+#include "drivers/socketcan/epoll_executor.hpp"
+#include "gn10_can/core/can_bus.hpp"
+#include "gn10_can/core/can_device.hpp"
+#include "gn10_can/core/fdcan_bus.hpp"
+#include "counting_device.hpp"
+#include "socket_pair.hpp"
+
+using namespace gn10_can;
+using drivers::DriverSocketCAN;
+using drivers::DriverSocketCANFD;
+using drivers::EpollExecutor;
+
+static uint32_t motor_id(uint8_t dev_id)
+{
+    return id::pack(id::DeviceType::MotorDriver, dev_id, id::MsgTypeMotorDriver::Feedback);
+}
+
+TEST(EpollExecutorTest, IdleWaitReturnsNothing)
+{
+    EpollExecutor executor;
+    ASSERT_TRUE(executor.valid());
+
+    SocketPair pair;
+    DriverSocketCAN driver;
+    ASSERT_TRUE(driver.adopt(pair.driver_fd));
+    CANBus bus(driver);
+    ASSERT_TRUE(executor.add_bus(bus, driver.fd()));
+
+    EXPECT_EQ(executor.run_once(0), 0u);
+    EXPECT_EQ(executor.run_once(5), 0u);
+}
+
+TEST(EpollExecutorTest, ServesSeveralBusesFromOneThread)
+{
+    EpollExecutor executor;
+
+    SocketPair pair_a;
+    DriverSocketCAN driver_a;
+    ASSERT_TRUE(driver_a.adopt(pair_a.driver_fd));
+    CANBus bus_a(driver_a);
+    CountingDevice motor_a(bus_a, 1);
+
+    SocketPair pair_b;
+    DriverSocketCANFD driver_b;
+    ASSERT_TRUE(driver_b.adopt(pair_b.driver_fd));
+    FDCANBus bus_b(driver_b);
+    CountingDevice motor_b(bus_b, 2);
+
+    ASSERT_TRUE(executor.add_bus(bus_a, driver_a.fd()));
+    ASSERT_TRUE(executor.add_bus(bus_b, driver_b.fd()));
+    EXPECT_FALSE(executor.add_bus(bus_a, driver_a.fd()));
+
+    pair_b.write_classic(motor_id(2), nullptr, 8);
+    EXPECT_EQ(executor.run_once(1000), 1u);
+    EXPECT_EQ(motor_a.count, 0);
+    EXPECT_EQ(motor_b.count, 1);
+
+    pair_a.write_classic(motor_id(1), nullptr, 8);
+    pair_b.write_classic(motor_id(2), nullptr, 8);
+    EXPECT_EQ(executor.run_once(1000), 2u);
+    EXPECT_EQ(motor_a.count, 1);
+    EXPECT_EQ(motor_b.count, 2);
+
+    // 登録を解除したバスは処理しない
+    EXPECT_TRUE(executor.remove(driver_a.fd()));
+    pair_a.write_classic(motor_id(1), nullptr, 8);
+    EXPECT_EQ(executor.run_once(5), 0u);
+    EXPECT_EQ(motor_a.count, 1);
+}
+
+TEST(EpollExecutorTest, ContinuesBacklogWithoutWaiting)
+{
+    EpollExecutor executor(2);
+
+    SocketPair pair;
+    DriverSocketCAN driver;
+    ASSERT_TRUE(driver.adopt(pair.driver_fd));
+    CANBus bus(driver);
+    CountingDevice motor(bus, 1);
+    ASSERT_TRUE(executor.add_bus(bus, driver.fd()));
+
+    for (int i = 0; i < 5; i++) {
+        pair.write_classic(motor_id(1), nullptr, 1);
+    }
+
+    EXPECT_EQ(executor.run_once(1000), 1u);
+    EXPECT_EQ(motor.count, 2);
+    EXPECT_EQ(executor.run_once(1000), 1u);
+    EXPECT_EQ(motor.count, 4);
+    EXPECT_EQ(executor.run_once(1000), 1u);
+    EXPECT_EQ(motor.count, 5);
+    EXPECT_EQ(executor.run_once(0), 0u);
+}
+
+TEST(EpollExecutorTest, FlushesTxQueueWhenWritable)
+{
+    EpollExecutor executor;
+
+    SocketPair pair;
+    DriverSocketCAN driver;
+    ASSERT_TRUE(driver.adopt(pair.driver_fd));
+    CANBus bus(driver);
+    ASSERT_TRUE(executor.add_bus(bus, driver.fd()));
+
+    // ソケットの送信バッファを埋め、残りを送信キューに保持させる
+    CANFrame frame;
+    frame.id  = 0x100;
+    frame.dlc = 8;
+    int sent  = 0;
+    while (bus.tx_queue_size() < 4 && sent < 100000) {
+        ASSERT_TRUE(bus.send_frame(frame));
+        sent++;
+    }
+    ASSERT_EQ(bus.tx_queue_size(), 4u);
+
+    executor.run_once(0);
+    int received = pair.drain();
+    for (int i = 0; i < 10 && bus.tx_queue_size() > 0; i++) {
+        executor.run_once(100);
+    }
+    EXPECT_EQ(bus.tx_queue_size(), 0u);
+    EXPECT_EQ(received + pair.drain(), sent);
+}
+
+TEST(EpollExecutorTest, RunsPeriodicTimers)
+{
+    EpollExecutor executor;
+
+    int ticks    = 0;
+    auto on_tick = [](void* context) { (*static_cast<int*>(context))++; };
+    const int timer = executor.add_timer(std::chrono::milliseconds(1), on_tick, &ticks);
+    ASSERT_GE(timer, 0);
+
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(executor.run_once(1000), 1u);
+    }
+    EXPECT_EQ(ticks, 3);
+
+    EXPECT_TRUE(executor.remove(timer));
+    EXPECT_FALSE(executor.remove(timer));
+    EXPECT_EQ(executor.run_once(5), 0u);
+    EXPECT_EQ(ticks, 3);
+}
+
+TEST(EpollExecutorTest, StopWakesRunningLoop)
+{
+    EpollExecutor executor;
+
+    SocketPair pair;
+    DriverSocketCAN driver;
+    ASSERT_TRUE(driver.adopt(pair.driver_fd));
+    CANBus bus(driver);
+    CountingDevice motor(bus, 1);
+    ASSERT_TRUE(executor.add_bus(bus, driver.fd()));
+
+    std::thread loop([&executor]() { executor.run(); });
+    pair.write_classic(motor_id(1), nullptr, 8);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    executor.stop();
+    loop.join();
+
+    EXPECT_EQ(motor.count, 1);
+}
+
+TEST(EpollExecutorTest, StopsWatchingClosedSocket)
+{
+    EpollExecutor executor;
+
+    SocketPair pair;
+    DriverSocketCAN driver;
+    ASSERT_TRUE(driver.adopt(pair.driver_fd));
+    CANBus bus(driver);
+    ASSERT_TRUE(executor.add_bus(bus, driver.fd()));
+
+    pair.close_peer();
+    EXPECT_EQ(executor.run_once(1000), 1u);
+    EXPECT_EQ(executor.run_once(5), 0u);
+}
@@ -0,0 +1,273 @@
+#include <gtest/gtest.h>
+
+#include <ratio>
+
+#include "gn10_can/core/fdcan_bus.hpp"
+#include "gn10_can/devices/esc_hub_client.hpp"
+#include "gn10_can/devices/esc_hub_server.hpp"
+#include "mock_driver.hpp"
+
+using namespace gn10_can;
+using namespace gn10_can::devices;
+
+// 送信したフレームを折り返して配送する
+static void loopback(MockFDDriver& driver, FDCANBus& bus)
+{
+    for (const auto& frame : driver.sent_frames) {
+        driver.push_receive_frame(frame);
+    }
+    driver.sent_frames.clear();
+    bus.update();
+}
+
+TEST(ESCHubTest, DefaultHubHasFourMotors)
+{
+    MockFDDriver driver;
+    FDCANBus bus{driver};
+    ESCHubClient client{bus, 1};
+    ESCHubServer server{bus, 1};
+    static_assert(ESCHubClient::MOTOR_COUNT == 4, "ESCHubClient keeps four motors");
+
+    const float velocities[4] = {1.0f, -2.0f, 3.0f, -4.0f};
+    client.set_angular_velocities(velocities);
+    ASSERT_EQ(driver.sent_frames.size(), 1u);
+    EXPECT_EQ(driver.sent_frames[0].dlc, 16);
+    loopback(driver, bus);
+
+    float received[4] = {};
+    ASSERT_TRUE(server.get_angular_velocities(received));
+    EXPECT_FLOAT_EQ(received[1], -2.0f);
+    EXPECT_FLOAT_EQ(received[3], -4.0f);
+
+    // 範囲外のモーターIDは送信も受信もしない
+    client.set_gains(4, 1.0f, 2.0f, 3.0f, 4.0f);
+    EXPECT_TRUE(driver.sent_frames.empty());
+    float kp, ki, kd, ff;
+    EXPECT_FALSE(server.get_gains(4, kp, ki, kd, ff));
+}
+
+TEST(ESCHubTest, SixteenMotorsInOneFrame)
+{
+    using Client = BasicESCHubClient<16>;
+    using Server = BasicESCHubServer<16>;
+
+    MockFDDriver driver;
+    FDCANBus bus{driver};
+    Client client{bus, 2};
+    Server server{bus, 2};
+
+    float velocities[16];
+    for (int i = 0; i < 16; i++) {
+        velocities[i] = static_cast<float>(i) - 7.5f;
+    }
+    client.set_angular_velocities(velocities);
+    ASSERT_EQ(driver.sent_frames.size(), 1u);
+    EXPECT_EQ(driver.sent_frames[0].dlc, 64);
+    loopback(driver, bus);
+
+    float received[16] = {};
+    ASSERT_TRUE(server.get_angular_velocities(received));
+    for (int i = 0; i < 16; i++) {
+        EXPECT_FLOAT_EQ(received[i], velocities[i]);
+    }
+
+    // フィードバックも1フレームで全モーター分
+    server.set_angular_velocity_feedbacks(received);
+    ASSERT_EQ(driver.sent_frames.size(), 1u);
+    loopback(driver, bus);
+    float feedbacks[16] = {};
+    ASSERT_TRUE(client.get_angular_velocity_feedbacks(feedbacks));
+    EXPECT_FLOAT_EQ(feedbacks[15], 7.5f);
+
+    // モーター15のゲイン・設定を送受信できる
+    client.set_gains(15, 1.0f, 2.0f, 3.0f, 4.0f);
+    MotorConfig config;
+    config.set_feedback_cycle(5);
+    client.set_init(15, config);
+    loopback(driver, bus);
+    float kp, ki, kd, ff;
+    ASSERT_TRUE(server.get_gains(15, kp, ki, kd, ff));
+    EXPECT_FLOAT_EQ(ff, 4.0f);
+    MotorConfig received_config;
+    ASSERT_TRUE(server.get_init(15, received_config));
+    EXPECT_EQ(received_config.get_feedback_cycle(), 5);
+}
+
+TEST(ESCHubTest, CompactEncodingHalvesPayload)
+{
+    using Encoding = schema::Fixed<int16_t, std::centi>;
+    using Client   = BasicESCHubClient<16, Encoding>;
+    using Server   = BasicESCHubServer<16, Encoding>;
+
+    MockFDDriver driver;
+    FDCANBus bus{driver};
+    Client client{bus, 3};
+    Server server{bus, 3};
+
+    float velocities[16] = {};
+    velocities[0]        = 12.34f;
+    velocities[15]       = -500.0f;
+    client.set_angular_velocities(velocities);
+    ASSERT_EQ(driver.sent_frames.size(), 1u);
+    EXPECT_EQ(driver.sent_frames[0].dlc, 32);
+    loopback(driver, bus);
+
+    float received[16] = {};
+    ASSERT_TRUE(server.get_angular_velocities(received));
+    EXPECT_NEAR(received[0], 12.34f, 1e-4f);
+    EXPECT_FLOAT_EQ(received[15], -327.68f);  // 範囲外は飽和
+}
+
+TEST(ESCHubTest, RejectsShortFrames)
+{
+    MockFDDriver driver;
+    FDCANBus bus{driver};
+    BasicESCHubServer<8> server{bus, 1};
+
+    // 4モーター分の角速度は8モーターのハブでは受け取らない
+    FDCANFrame frame =
+        FDCANFrame::make(id::DeviceType::ESCHub, 1, id::MsgTypeESCHub::AngularVelocities);
+    frame.dlc = 16;
+    driver.push_receive_frame(frame);
+    bus.update();
+
+    float received[8];
+    EXPECT_FALSE(server.get_angular_velocities(received));
+}
+
+TEST(ESCHubTest, FullStateSnapshotInOneFrame)
+{
+    MockFDDriver driver;
+    FDCANBus bus{driver};
+    ESCHubClient client{bus, 1};
+    ESCHubServer server{bus, 1};
+
+    esc_hub::MotorFullState states[4];
+    for (int i = 0; i < 4; i++) {
+        states[i].angular_velocity = 10.0f * static_cast<float>(i) - 15.0f;
+        states[i].position         = 1234.567f * static_cast<float>(i);
+        states[i].current          = 0.5f * static_cast<float>(i);
+        states[i].temperature      = static_cast<int8_t>(25 + i);
+    }
+    server.set_full_state_feedbacks(states);
+    ASSERT_EQ(driver.sent_frames.size(), 1u);
+    EXPECT_EQ(driver.sent_frames[0].dlc, 1 + 4 * esc_hub::MotorFullStateSchema::DLC);
+    loopback(driver, bus);
+
+    esc_hub::MotorFullState received[4];
+    ASSERT_TRUE(client.get_full_state_feedbacks(received));
+    for (int i = 0; i < 4; i++) {
+        EXPECT_FLOAT_EQ(received[i].angular_velocity, states[i].angular_velocity);
+        EXPECT_NEAR(received[i].position, states[i].position, 1e-3f);
+        EXPECT_FLOAT_EQ(received[i].current, states[i].current);
+        EXPECT_EQ(received[i].temperature, states[i].temperature);
+    }
+    EXPECT_FALSE(client.get_full_state_feedbacks(received));
+}
+
+TEST(ESCHubTest, FullStateByteOrder)
+{
+    MockFDDriver driver;
+    FDCANBus bus{driver};
+    ESCHubServer server{bus, 1};
+
+    esc_hub::MotorFullState states[4];
+    states[1].angular_velocity = -7.5f;
+    states[1].position         = -2.5f;
+    states[1].current          = 1.0f;
+    states[1].temperature      = -2;
+    server.set_full_state_feedbacks(states);
+    ASSERT_EQ(driver.sent_frames.size(), 1u);
+
+    // モーター1の9バイト: 半精度、0.001 単位の int32_t、半精度、int8_t をリトルエンディアンで
+    const FDCANFrame& frame  = driver.sent_frames[0];
+    const std::size_t offset = 1 + esc_hub::MotorFullStateSchema::DLC;
+    const uint8_t expected[esc_hub::MotorFullStateSchema::DLC] = {
+        0x80, 0xC7, 0x3C, 0xF6, 0xFF, 0xFF, 0x00, 0x3C, 0xFE
+    };
+    EXPECT_EQ(frame.data[0], 0);
+    for (std::size_t i = 0; i < esc_hub::MotorFullStateSchema::DLC; i++) {
+        EXPECT_EQ(frame.data[offset + i], expected[i]) << "byte " << i;
+    }
+}
+
+TEST(ESCHubTest, FullStateSnapshotSpansFrames)
+{
+    MockFDDriver driver;
+    FDCANBus bus{driver};
+    BasicESCHubClient<16> client{bus, 4};
+    BasicESCHubServer<16> server{bus, 4};
+
+    esc_hub::MotorFullState states[16];
+    for (int i = 0; i < 16; i++) {
+        states[i].temperature = static_cast<int8_t>(i);
+    }
+    server.set_full_state_feedbacks(states);
+    ASSERT_EQ(driver.sent_frames.size(), 3u);  // 7 + 7 + 2
+    EXPECT_EQ(driver.sent_frames[2].dlc, 1 + 2 * esc_hub::MotorFullStateSchema::DLC);
+
+    // 最後のフレームがそろうまでスナップショットは更新しない
+    auto frames = driver.sent_frames;
+    driver.sent_frames.clear();
+    driver.push_receive_frame(frames[0]);
+    driver.push_receive_frame(frames[1]);
+    bus.update();
+    EXPECT_EQ(client.full_state_feedback_mailbox().update_count(), 0u);
+    esc_hub::MotorFullState received[16];
+    EXPECT_FALSE(client.get_full_state_feedbacks(received));
+
+    frames[2].timestamp = 42;
+    driver.push_receive_frame(frames[2]);
+    bus.update();
+    EXPECT_EQ(client.full_state_feedback_mailbox().timestamp(), 42u);
+    ASSERT_TRUE(client.get_full_state_feedbacks(received));
+    EXPECT_EQ(received[0].temperature, 0);
+    EXPECT_EQ(received[8].temperature, 8);
+    EXPECT_EQ(received[15].temperature, 15);
+
+    // 途中のフレームだけでは組み立てない
+    driver.push_receive_frame(frames[2]);
+    bus.update();
+    EXPECT_FALSE(client.get_full_state_feedbacks(received));
+}
+
+TEST(ESCHubTest, FullStateSnapshotDoesNotMixCycles)
+{
+    MockFDDriver driver;
+    FDCANBus bus{driver};
+    BasicESCHubClient<16> client{bus, 5};
+    BasicESCHubServer<16> server{bus, 5};
+
+    esc_hub::MotorFullState states[16];
+    server.set_full_state_feedbacks(states);
+    auto old_cycle = driver.sent_frames;
+    driver.sent_frames.clear();
+    for (int i = 0; i < 16; i++) {
+        states[i].temperature = 1;
+    }
+    server.set_full_state_feedbacks(states);
+    auto new_cycle = driver.sent_frames;
+    driver.sent_frames.clear();
+    ASSERT_EQ(old_cycle.size(), 3u);
+    ASSERT_EQ(new_cycle.size(), 3u);
+
+    // 前の周期はフレーム1を、次の周期はフレーム0を失う
+    driver.push_receive_frame(old_cycle[0]);
+    driver.push_receive_frame(old_cycle[2]);
+    driver.push_receive_frame(new_cycle[1]);
+    driver.push_receive_frame(new_cycle[2]);
+    bus.update();
+    esc_hub::MotorFullState received[16];
+    EXPECT_FALSE(client.get_full_state_feedbacks(received));
+    EXPECT_EQ(client.full_state_feedback_mailbox().update_count(), 0u);
+
+    // 順番どおりにそろった周期だけを格納する
+    for (const auto& frame : new_cycle) {
+        driver.push_receive_frame(frame);
+    }
+    bus.update();
+    ASSERT_TRUE(client.get_full_state_feedbacks(received));
+    for (int i = 0; i < 16; i++) {
+        EXPECT_EQ(received[i].temperature, 1);
+    }
+}
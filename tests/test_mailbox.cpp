@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+#include "gn10_can/core/can_bus.hpp"
+#include "gn10_can/core/mailbox.hpp"
+#include "gn10_can/devices/motor_driver_server.hpp"
+#include "gn10_can/devices/solenoid_driver_server.hpp"
+#include "mock_driver.hpp"
+
+using namespace gn10_can;
+
+struct Sample {
+    uint32_t sequence;
+    float values[5];
+};
+
+TEST(MailboxTest, TakesOnlyNewValues)
+{
+    Mailbox<Sample> mailbox;
+    Sample sample{};
+    EXPECT_FALSE(mailbox.take(sample));
+    EXPECT_FALSE(mailbox.peek(sample));
+    EXPECT_FALSE(mailbox.has_new());
+
+    mailbox.post(Sample{1, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f}}, 100);
+    EXPECT_TRUE(mailbox.has_new());
+    ASSERT_TRUE(mailbox.take(sample));
+    EXPECT_EQ(sample.sequence, 1u);
+    EXPECT_FLOAT_EQ(sample.values[4], 5.0f);
+
+    // 取り出した値は再び取り出せないが、peek() では読み出せる
+    EXPECT_FALSE(mailbox.has_new());
+    EXPECT_FALSE(mailbox.take(sample));
+    Sample latest{};
+    ASSERT_TRUE(mailbox.peek(latest));
+    EXPECT_EQ(latest.sequence, 1u);
+    EXPECT_EQ(mailbox.update_count(), 1u);
+    EXPECT_EQ(mailbox.overwritten_count(), 0u);
+}
+
+TEST(MailboxTest, CountsOverwrittenValues)
+{
+    Mailbox<uint8_t> mailbox;
+    mailbox.post(1);
+    mailbox.post(2);
+    mailbox.post(3);
+    EXPECT_EQ(mailbox.overwritten_count(), 2u);
+
+    uint8_t value = 0;
+    ASSERT_TRUE(mailbox.take(value));
+    EXPECT_EQ(value, 3);
+
+    // 取り出した後の書き込みは上書きにならない
+    mailbox.post(4);
+    EXPECT_EQ(mailbox.overwritten_count(), 2u);
+    EXPECT_EQ(mailbox.update_count(), 4u);
+}
+
+TEST(MailboxTest, ReportsAgeOfLatestValue)
+{
+    Mailbox<float> mailbox;
+    EXPECT_EQ(mailbox.age(1000), 0u);
+
+    mailbox.post(1.0f, 1000);
+    EXPECT_EQ(mailbox.timestamp(), 1000u);
+    EXPECT_EQ(mailbox.age(1250), 250u);
+    EXPECT_EQ(mailbox.age(900), 0u);
+
+    // 受信時刻のない値の古さは求めない
+    mailbox.post(2.0f);
+    EXPECT_EQ(mailbox.age(2000), 0u);
+}
+
+TEST(MailboxTest, ReaderNeverSeesTornValue)
+{
+    Mailbox<Sample> mailbox;
+    std::atomic<bool> done{false};
+
+    std::thread writer([&]() {
+        for (uint32_t i = 1; i <= 100000; i++) {
+            const float value = static_cast<float>(i);
+            mailbox.post(Sample{i, {value, value, value, value, value}}, i);
+        }
+        done = true;
+    });
+
+    uint32_t last = 0;
+    while (!done) {
+        Sample sample{};
+        if (!mailbox.take(sample)) {
+            continue;
+        }
+        const float expected = static_cast<float>(sample.sequence);
+        for (float value : sample.values) {
+            ASSERT_FLOAT_EQ(value, expected);
+        }
+        ASSERT_GT(sample.sequence, last);
+        last = sample.sequence;
+    }
+    writer.join();
+
+    EXPECT_EQ(mailbox.update_count(), 100000u);
+    EXPECT_LT(mailbox.overwritten_count(), 100000u);
+}
+
+TEST(MailboxTest, DeviceExposesOverwrittenTargets)
+{
+    MockDriver driver;
+    CANBus bus{driver};
+    devices::MotorDriverServer server{bus, 1};
+
+    // 制御ループが取り出す前に目標値が3回届く
+    for (int i = 0; i < 3; i++) {
+        CANFrame frame =
+            CANFrame::make(id::DeviceType::MotorDriver, 1, id::MsgTypeMotorDriver::Target);
+        frame.dlc          = 4;
+        frame.timestamp    = static_cast<uint64_t>(1000 + i);
+        const float target = static_cast<float>(i);
+        std::memcpy(frame.data.data(), &target, sizeof(target));
+        driver.push_receive_frame(frame);
+    }
+    bus.update();
+
+    float target = 0.0f;
+    ASSERT_TRUE(server.get_new_target(target));
+    EXPECT_FLOAT_EQ(target, 2.0f);
+    EXPECT_FALSE(server.get_new_target(target));
+    EXPECT_EQ(server.target_mailbox().overwritten_count(), 2u);
+    EXPECT_EQ(server.target_mailbox().timestamp(), 1002u);
+}
+
+TEST(MailboxTest, SolenoidInitIsReportedOnce)
+{
+    MockDriver driver;
+    CANBus bus{driver};
+    devices::SolenoidDriverServer server{bus, 1};
+    EXPECT_FALSE(server.get_new_init());
+
+    CANFrame frame =
+        CANFrame::make(id::DeviceType::SolenoidDriver, 1, id::MsgTypeSolenoidDriver::Init);
+    frame.dlc = 1;
+    driver.push_receive_frame(frame);
+    bus.update();
+
+    EXPECT_TRUE(server.get_new_init());
+    EXPECT_FALSE(server.get_new_init());
+}
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstring>
+#include <ratio>
+
+#include "gn10_can/core/can_bus.hpp"
+#include "gn10_can/devices/power_manager_client.hpp"
+#include "gn10_can/devices/power_manager_server.hpp"
+#include "gn10_can/utils/can_converter.hpp"
+#include "gn10_can/utils/message_schema.hpp"
+#include "mock_driver.hpp"
+
+using namespace gn10_can;
+namespace pm = devices::power_manager;
+
+struct Sample {
+    uint8_t mode;
+    int16_t position;
+    bool enabled;
+    float speed;
+};
+
+using SampleSchema = schema::Message<
+    Sample,
+    schema::Field<&Sample::mode>,
+    schema::Field<&Sample::position>,
+    schema::Reserved<2>,
+    schema::Field<&Sample::enabled>,
+    schema::Field<&Sample::speed>>;
+
+// データ長とオフセットはコンパイル時に決まる
+static_assert(SampleSchema::DLC == 10, "DLC is the sum of the field sizes");
+static_assert(SampleSchema::offset(2) == 3, "Reserved bytes follow the previous field");
+static_assert(SampleSchema::offset(4) == 6, "Fields are packed without padding");
+static_assert(pm::ConfigSchema::DLC == 3, "Config layout must not change");
+static_assert(pm::StatusSchema::DLC == 4, "Status layout must not change");
+static_assert(pm::SensorSchema::DLC == 8, "Sensor layout must not change");
+
+struct Telemetry {
+    float current;
+    float angle;
+};
+
+using TelemetrySchema = schema::Message<
+    Telemetry,
+    schema::Field<&Telemetry::current, schema::Half>,
+    schema::Field<&Telemetry::angle, schema::Fixed<int16_t, std::milli>>>;
+
+static_assert(TelemetrySchema::DLC == 4, "Half and Fixed<int16_t> take two bytes each");
+
+TEST(MessageSchemaTest, PacksFieldsAtTheirOffsets)
+{
+    const Sample sample{7, -1234, true, 2.5f};
+    const SampleSchema::Payload payload = SampleSchema::pack(sample);
+
+    // converter で1フィールドずつ詰めた場合と同じバイト列になる
+    std::array<uint8_t, 10> expected{};
+    converter::pack(expected, 0, sample.mode);
+    converter::pack(expected, 1, sample.position);
+    converter::pack(expected, 5, sample.enabled);
+    converter::pack(expected, 6, sample.speed);
+    EXPECT_EQ(payload, expected);
+}
+
+TEST(MessageSchemaTest, PacksLittleEndian)
+{
+    // このマイコン・PC のバイト順によらず同じバイト列になる
+    const SampleSchema::Payload raw_payload = SampleSchema::pack(Sample{7, -1234, true, 2.5f});
+    const SampleSchema::Payload expected_raw{
+        0x07, 0x2E, 0xFB, 0x00, 0x00, 0x01, 0x00, 0x00, 0x20, 0x40
+    };
+    EXPECT_EQ(raw_payload, expected_raw);
+
+    const TelemetrySchema::Payload compact_payload =
+        TelemetrySchema::pack(Telemetry{-7.5f, 1.234f});
+    const TelemetrySchema::Payload expected_compact{0x80, 0xC7, 0xD2, 0x04};
+    EXPECT_EQ(compact_payload, expected_compact);
+}
+
+TEST(MessageSchemaTest, UnpacksWhatWasPacked)
+{
+    const Sample sample{3, 32000, true, -0.125f};
+    const SampleSchema::Payload payload = SampleSchema::pack(sample);
+
+    Sample unpacked{};
+    ASSERT_TRUE(SampleSchema::unpack(payload.data(), payload.size(), unpacked));
+    EXPECT_EQ(unpacked.mode, 3);
+    EXPECT_EQ(unpacked.position, 32000);
+    EXPECT_TRUE(unpacked.enabled);
+    EXPECT_FLOAT_EQ(unpacked.speed, -0.125f);
+}
+
+TEST(MessageSchemaTest, RejectsShortFrame)
+{
+    CANFrame frame;
+    frame.dlc = 3;
+    frame.data.fill(0xFF);
+
+    pm::Status status{false, false, false, false};
+    EXPECT_FALSE(pm::StatusSchema::unpack(CANFrameView(frame), status));
+    EXPECT_FALSE(status.emergency_stop_enabled);
+
+    frame.dlc = 4;
+    EXPECT_TRUE(pm::StatusSchema::unpack(CANFrameView(frame), status));
+    EXPECT_TRUE(status.emergency_stop_enabled);
+}
+
+TEST(MessageSchemaTest, NormalizesBoolBytes)
+{
+    const std::array<uint8_t, 4> payload{0x00, 0x02, 0x80, 0x01};
+    pm::Status status{};
+    ASSERT_TRUE(pm::StatusSchema::unpack(payload.data(), payload.size(), status));
+    EXPECT_EQ(status, (pm::Status{false, true, true, true}));
+}
+
+TEST(MessageSchemaTest, PowerManagerClientAndServerAgree)
+{
+    MockDriver client_driver;
+    CANBus client_bus{client_driver};
+    devices::PowerManagerClient client{client_bus, 1};
+
+    MockDriver server_driver;
+    CANBus server_bus{server_driver};
+    devices::PowerManagerServer server{server_bus, 1};
+
+    // クライアント → サーバー
+    pm::Config config;
+    config.use_remote_emergency_stop = true;
+    config.sensor_rate_ms            = 250;
+    client.set_init(config);
+    client_bus.update();
+    ASSERT_EQ(client_driver.sent_frames.size(), 1u);
+    EXPECT_EQ(client_driver.sent_frames[0].dlc, pm::ConfigSchema::DLC);
+    server_driver.push_receive_frame(client_driver.sent_frames[0]);
+    server_bus.update();
+
+    pm::Config received_config{};
+    ASSERT_TRUE(server.get_new_init(received_config));
+    EXPECT_TRUE(received_config.use_remote_emergency_stop);
+    EXPECT_EQ(received_config.sensor_rate_ms, 250);
+
+    // サーバー → クライアント
+    const pm::Status status{true, false, true, false};
+    server.set_status(status);
+    server.set_sensor(pm::Sensor{24.5f, 3.25f});
+    server_bus.update();
+    ASSERT_EQ(server_driver.sent_frames.size(), 2u);
+    for (const CANFrame& frame : server_driver.sent_frames) {
+        client_driver.push_receive_frame(frame);
+    }
+    client_bus.update();
+
+    pm::Status received_status{};
+    ASSERT_TRUE(client.get_new_status(received_status));
+    EXPECT_EQ(received_status, status);
+
+    pm::Sensor received_sensor{};
+    ASSERT_TRUE(client.get_new_sensor(received_sensor));
+    EXPECT_FLOAT_EQ(received_sensor.voltage, 24.5f);
+    EXPECT_FLOAT_EQ(received_sensor.current, 3.25f);
+}
+
+TEST(MessageSchemaTest, CompactEncodings)
+{
+    const TelemetrySchema::Payload payload = TelemetrySchema::pack(Telemetry{-7.5f, 40.0f});
+
+    // 固定小数点数は範囲外の値を飽和させる
+    Telemetry unpacked{};
+    ASSERT_TRUE(TelemetrySchema::unpack(payload.data(), payload.size(), unpacked));
+    EXPECT_FLOAT_EQ(unpacked.current, -7.5f);
+    EXPECT_FLOAT_EQ(unpacked.angle, 32.767f);
+
+    int16_t raw_angle = 0;
+    ASSERT_TRUE(converter::unpack(payload, 2, raw_angle));
+    EXPECT_EQ(raw_angle, 32767);
+}
@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <ratio>
+
 #include "gn10_can/core/can_bus.hpp"
+#include "gn10_can/core/fdcan_bus.hpp"
+#include "gn10_can/devices/motor_driver_group.hpp"
 #include "gn10_can/devices/motor_driver_client.hpp"
 #include "gn10_can/devices/motor_driver_server.hpp"
 #include "mock_driver.hpp"
@@ -74,6 +79,32 @@ TEST_F(MotorDriverTest, InitConfig)
     EXPECT_EQ(received_config.get_feedback_cycle(), 10);
 }
 
+TEST_F(MotorDriverTest, LimitSwitchConfigBits)
+{
+    MotorConfig config;
+    config.set_forward_limit_switch(true, 5);
+    config.set_reverse_limit_switch(false, 2);
+
+    // forward: enable (bit 7) + id (bit 6-4)、reverse: enable (bit 3) + id (bit 2-0)
+    const std::array<uint8_t, 8> bytes = config.to_bytes();
+    const MotorConfig decoded          = MotorConfig::from_bytes(bytes);
+    bool enable_stop                   = false;
+    uint8_t switch_id                  = 0;
+    decoded.get_forward_limit_switch(enable_stop, switch_id);
+    EXPECT_TRUE(enable_stop);
+    EXPECT_EQ(switch_id, 5);
+    decoded.get_reverse_limit_switch(enable_stop, switch_id);
+    EXPECT_FALSE(enable_stop);
+    EXPECT_EQ(switch_id, 2);
+
+    // 一方の設定は他方のビットを変更しない
+    config.set_reverse_limit_switch(true, 7);
+    config.get_forward_limit_switch(enable_stop, switch_id);
+    EXPECT_TRUE(enable_stop);
+    EXPECT_EQ(switch_id, 5);
+    EXPECT_NE(std::find(bytes.begin(), bytes.end(), 0xD2), bytes.end());
+}
+
 TEST_F(MotorDriverTest, Target)
 {
     float target = 0.8f;
@@ -131,3 +162,116 @@ TEST_F(MotorDriverTest, HardwareStatus)
     EXPECT_FLOAT_EQ(client.load_current(), current);
     EXPECT_EQ(client.temperature(), temp);
 }
+
+TEST_F(MotorDriverTest, State)
+{
+    MotorState state;
+    state.feedback       = -1234.5f;
+    state.load_current   = 3.3f;
+    state.temperature    = -12;
+    state.limit_switches = 0x81;
+
+    // Feedback と HardwareStatus の内容が1フレームで届く
+    server.send_state(state);
+    ASSERT_EQ(driver.sent_frames.size(), 1u);
+    EXPECT_EQ(driver.sent_frames[0].dlc, 8);
+
+    ProcessBus();
+
+    EXPECT_FLOAT_EQ(client.feedback_value(), state.feedback);
+    EXPECT_NEAR(client.load_current(), state.load_current, 0.002f);
+    EXPECT_EQ(client.temperature(), state.temperature);
+    EXPECT_EQ(client.limit_switches(), state.limit_switches);
+}
+
+TEST_F(MotorDriverTest, GroupTargetFloat)
+{
+    // 制御側と同じバスに、グループ0のスロット0・1としてモーター1・2を置く
+    MotorDriverServer server_2{bus, 2};
+    MotorDriverGroupClient group{bus, 0};
+    MotorDriverGroupMember member_1{bus, 0, 0, server};
+    MotorDriverGroupMember member_2{bus, 0, 1, server_2};
+
+    // CAN の1フレームには float 2つまで
+    EXPECT_TRUE(group.set_targets(std::array<float, 2>{0.5f, -0.25f}));
+    ASSERT_EQ(driver.sent_frames.size(), 1u);
+    EXPECT_EQ(driver.sent_frames[0].dlc, 8);
+    const float too_many[3] = {1.0f, 2.0f, 3.0f};
+    EXPECT_FALSE(group.set_targets(too_many, 3));
+
+    ProcessBus();
+
+    float target = 0.0f;
+    ASSERT_TRUE(server.get_new_target(target));
+    EXPECT_FLOAT_EQ(target, 0.5f);
+    ASSERT_TRUE(server_2.get_new_target(target));
+    EXPECT_FLOAT_EQ(target, -0.25f);
+
+    // 同じIDのモータードライバー (デバイスID 0) には届かない
+    MotorDriverServer server_0{bus, 0};
+    group.set_targets(std::array<float, 1>{9.0f});
+    ProcessBus();
+    EXPECT_FALSE(server_0.get_new_target(target));
+
+    // スロットを含まないフレームではモーター2の目標値は更新しない
+    ASSERT_TRUE(server.get_new_target(target));
+    EXPECT_FLOAT_EQ(target, 9.0f);
+    EXPECT_FALSE(server_2.get_new_target(target));
+}
+
+TEST_F(MotorDriverTest, GroupTargetScaledInt16)
+{
+    using Encoding = schema::Fixed<int16_t, std::centi>;
+
+    MotorDriverServer servers[3] = {{bus, 2}, {bus, 3}, {bus, 4}};
+    BasicMotorDriverGroupClient<Encoding> group{bus, 1};
+    BasicMotorDriverGroupMember<Encoding> members[4] = {
+        {bus, 1, 0, server},
+        {bus, 1, 1, servers[0]},
+        {bus, 1, 2, servers[1]},
+        {bus, 1, 3, servers[2]},
+    };
+
+    // 4モーター分が CAN の1フレームに入る
+    const std::array<float, 4> targets{1.25f, -3.5f, 400.0f, 0.004f};
+    EXPECT_TRUE(group.set_targets(targets));
+    ASSERT_EQ(driver.sent_frames.size(), 1u);
+    EXPECT_EQ(driver.sent_frames[0].dlc, 8);
+
+    ProcessBus();
+
+    float target = 0.0f;
+    ASSERT_TRUE(server.get_new_target(target));
+    EXPECT_FLOAT_EQ(target, 1.25f);
+    ASSERT_TRUE(servers[0].get_new_target(target));
+    EXPECT_FLOAT_EQ(target, -3.5f);
+    ASSERT_TRUE(servers[1].get_new_target(target));
+    EXPECT_FLOAT_EQ(target, 327.67f);  // 範囲外は飽和
+    ASSERT_TRUE(servers[2].get_new_target(target));
+    EXPECT_FLOAT_EQ(target, 0.0f);
+    EXPECT_EQ(members[3].slot(), 3);
+}
+
+TEST(MotorDriverGroupTest, SixteenMotorsOnFD)
+{
+    MockFDDriver driver;
+    FDCANBus bus{driver};
+    MotorDriverGroupClient group{bus, 0};
+
+    std::array<float, 16> targets{};
+    for (std::size_t i = 0; i < targets.size(); i++) {
+        targets[i] = static_cast<float>(i) * 0.5f;
+    }
+    EXPECT_TRUE(group.set_targets(targets));
+    ASSERT_EQ(driver.sent_frames.size(), 1u);
+    EXPECT_EQ(driver.sent_frames[0].dlc, 64);
+
+    MotorDriverServer server{bus, 15};
+    MotorDriverGroupMember member{bus, 0, 15, server};
+    driver.push_receive_frame(driver.sent_frames[0]);
+    bus.update();
+
+    float target = 0.0f;
+    ASSERT_TRUE(server.get_new_target(target));
+    EXPECT_FLOAT_EQ(target, 7.5f);
+}
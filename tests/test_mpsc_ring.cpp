@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <thread>
+#include <vector>
+
+#include "gn10_can/core/mpsc_ring.hpp"
+
+using namespace gn10_can;
+
+TEST(MPSCRingTest, PushPopKeepsOrder)
+{
+    MPSCRing<int, 4> ring;
+    EXPECT_TRUE(ring.empty());
+
+    EXPECT_TRUE(ring.push(1));
+    EXPECT_TRUE(ring.push(2));
+    EXPECT_TRUE(ring.push(3));
+    EXPECT_EQ(ring.size(), 3u);
+
+    int value = 0;
+    EXPECT_TRUE(ring.pop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(ring.pop(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_TRUE(ring.pop(value));
+    EXPECT_EQ(value, 3);
+    EXPECT_FALSE(ring.pop(value));
+}
+
+TEST(MPSCRingTest, OverflowIsCountedAndDropsNewest)
+{
+    MPSCRing<int, 4> ring;
+    for (int i = 0; i < 6; i++) {
+        ring.push(i);
+    }
+    EXPECT_EQ(ring.size(), 4u);
+    EXPECT_EQ(ring.overflow_count(), 2u);
+
+    std::array<int, 8> values{};
+    ASSERT_EQ(ring.pop_many(values.data(), values.size()), 4u);
+    EXPECT_EQ(values[0], 0);
+    EXPECT_EQ(values[3], 3);
+}
+
+TEST(MPSCRingTest, PopManyWrapsAround)
+{
+    MPSCRing<int, 4> ring;
+    std::array<int, 3> values{};
+    for (int round = 0; round < 10; round++) {
+        ASSERT_TRUE(ring.push(round * 3));
+        ASSERT_TRUE(ring.push(round * 3 + 1));
+        ASSERT_TRUE(ring.push(round * 3 + 2));
+        ASSERT_EQ(ring.pop_many(values.data(), 2), 2u);
+        ASSERT_EQ(ring.pop_many(values.data() + 2, 2), 1u);
+        EXPECT_EQ(values[0], round * 3);
+        EXPECT_EQ(values[2], round * 3 + 2);
+    }
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(MPSCRingTest, ConcurrentProducers)
+{
+    constexpr int PRODUCERS = 4;
+    constexpr int COUNT     = 20000;
+    MPSCRing<uint32_t, 64> ring;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; p++) {
+        producers.emplace_back([&ring, p]() {
+            for (uint32_t i = 0; i < COUNT; i++) {
+                // 満杯の間は消費者が取り出すのを待つ
+                while (!ring.push((static_cast<uint32_t>(p) << 24) | i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // 生産者ごとに順序が保たれ、欠けも重複もない
+    std::array<uint32_t, PRODUCERS> next{};
+    int received = 0;
+    while (received < PRODUCERS * COUNT) {
+        uint32_t value;
+        if (!ring.pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        const uint32_t producer = value >> 24;
+        ASSERT_LT(producer, static_cast<uint32_t>(PRODUCERS));
+        ASSERT_EQ(value & 0xFFFFFF, next[producer]);
+        next[producer]++;
+        received++;
+    }
+
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    EXPECT_TRUE(ring.empty());
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "gn10_can/core/seqlock.hpp"
+
+using namespace gn10_can;
+
+struct Sample {
+    uint32_t sequence;
+    float values[5];
+    uint8_t flags;
+};
+
+TEST(SeqLockTest, ReadsWrittenValue)
+{
+    SeqLock<Sample> lock(Sample{7, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f}, 0x5A});
+    EXPECT_EQ(lock.version(), 0u);
+    EXPECT_EQ(lock.read().sequence, 7u);
+    EXPECT_EQ(lock.read().flags, 0x5A);
+
+    lock.write(Sample{8, {6.0f, 7.0f, 8.0f, 9.0f, 10.0f}, 0xA5});
+    EXPECT_EQ(lock.version(), 1u);
+
+    Sample sample{};
+    ASSERT_TRUE(lock.try_read(sample));
+    EXPECT_EQ(sample.sequence, 8u);
+    EXPECT_FLOAT_EQ(sample.values[4], 10.0f);
+    EXPECT_EQ(sample.flags, 0xA5);
+}
+
+TEST(SeqLockTest, ReaderNeverSeesTornValue)
+{
+    SeqLock<Sample> lock;
+    std::atomic<bool> done{false};
+
+    std::thread writer([&lock, &done]() {
+        for (uint32_t i = 1; i <= 200000; i++) {
+            const float value = static_cast<float>(i);
+            lock.write(Sample{i, {value, value, value, value, value}, static_cast<uint8_t>(i)});
+        }
+        done.store(true);
+    });
+
+    // 全てのフィールドが同じ書き込みのものであること
+    uint32_t last = 0;
+    while (!done.load()) {
+        const Sample sample = lock.read();
+        const float value   = static_cast<float>(sample.sequence);
+        for (float v : sample.values) {
+            ASSERT_EQ(v, value);
+        }
+        ASSERT_EQ(sample.flags, static_cast<uint8_t>(sample.sequence));
+        ASSERT_GE(sample.sequence, last);
+        last = sample.sequence;
+    }
+    writer.join();
+    EXPECT_EQ(lock.read().sequence, 200000u);
+}
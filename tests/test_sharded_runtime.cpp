@@ -0,0 +1,260 @@
+#include <gtest/gtest.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <linux/can.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "drivers/socketcan/driver_socketcan.hpp"
+#include "drivers/socketcan/sharded_runtime.hpp"
+#include "gn10_can/core/bus_stats.hpp"
+#include "gn10_can/core/can_bus.hpp"
+#include "gn10_can/core/can_device.hpp"
+#include "counting_device.hpp"
+#include "socket_pair.hpp"
+
+using namespace gn10_can;
+using drivers::DriverSocketCAN;
+using drivers::ShardedCANRuntime;
+
+// 受信したフレームを他のバスへ送信する
+class GatewayDevice : public CANDevice
+{
+public:
+    GatewayDevice(CANBusBase& bus, uint8_t id, ShardedCANRuntime& runtime, std::size_t target)
+        : CANDevice(bus, id::DeviceType::MotorDriver, id), runtime_(runtime), target_(target)
+    {
+    }
+
+    void on_receive(const CANFrameView& frame) override
+    {
+        EXPECT_TRUE(runtime_.send(target_, frame));
+    }
+
+private:
+    ShardedCANRuntime& runtime_;
+    std::size_t target_;
+};
+
+using StatsBus = InstrumentedCANBus<BusStats<>>;
+
+static uint32_t motor_id(uint8_t dev_id)
+{
+    return id::pack(id::DeviceType::MotorDriver, dev_id, id::MsgTypeMotorDriver::Feedback);
+}
+
+// 条件が満たされるまで待つ
+template <typename Condition>
+static bool wait_until(Condition condition)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    return true;
+}
+
+TEST(ShardedRuntimeTest, ServesBusesOnSeparateShards)
+{
+    ShardedCANRuntime runtime;
+    const int shard_a = runtime.add_shard();
+    const int shard_b = runtime.add_shard();
+    ASSERT_EQ(shard_a, 0);
+    ASSERT_EQ(shard_b, 1);
+
+    SocketPair pair_a;
+    DriverSocketCAN driver_a;
+    ASSERT_TRUE(driver_a.adopt(pair_a.driver_fd));
+    StatsBus bus_a(driver_a);
+    CountingDevice motor_a(bus_a, 1);
+
+    SocketPair pair_b;
+    DriverSocketCAN driver_b;
+    ASSERT_TRUE(driver_b.adopt(pair_b.driver_fd));
+    StatsBus bus_b(driver_b);
+    CountingDevice motor_b(bus_b, 2);
+
+    ASSERT_EQ(runtime.add_bus(shard_a, bus_a, driver_a.fd()), 0);
+    ASSERT_EQ(runtime.add_bus(shard_b, bus_b, driver_b.fd()), 1);
+    ASSERT_TRUE(runtime.start());
+    EXPECT_FALSE(runtime.start());
+
+    for (int i = 0; i < 10; i++) {
+        const uint8_t value = static_cast<uint8_t>(i);
+        pair_a.write_classic(motor_id(1), &value, 1);
+        pair_b.write_classic(motor_id(2), &value, 1);
+        pair_b.write_classic(motor_id(2), &value, 1);
+    }
+    EXPECT_TRUE(wait_until([&]() { return motor_a.count == 10 && motor_b.count == 20; }));
+    runtime.stop();
+    EXPECT_FALSE(runtime.running());
+
+    // 停止時点の統計情報がシャードごとと合計で読み出せる
+    EXPECT_EQ(runtime.shard_stats(0).rx_frames, 10u);
+    EXPECT_EQ(runtime.shard_stats(1).rx_frames, 20u);
+    const drivers::ShardStats stats = runtime.stats();
+    EXPECT_EQ(stats.rx_frames, 30u);
+    EXPECT_EQ(stats.rx_bytes, 30u);
+    EXPECT_GT(stats.wakeups, 0u);
+}
+
+TEST(ShardedRuntimeTest, ForwardsFramesAcrossShards)
+{
+    ShardedCANRuntime runtime;
+    const int shard_a = runtime.add_shard();
+    const int shard_b = runtime.add_shard();
+
+    SocketPair pair_a;
+    DriverSocketCAN driver_a;
+    ASSERT_TRUE(driver_a.adopt(pair_a.driver_fd));
+    CANBus bus_a(driver_a);
+
+    SocketPair pair_b;
+    DriverSocketCAN driver_b;
+    ASSERT_TRUE(driver_b.adopt(pair_b.driver_fd));
+    StatsBus bus_b(driver_b);
+
+    ASSERT_EQ(runtime.add_bus(shard_a, bus_a, driver_a.fd()), 0);
+    const int target = runtime.add_bus(shard_b, bus_b, driver_b.fd());
+    ASSERT_EQ(target, 1);
+    GatewayDevice gateway(bus_a, 1, runtime, static_cast<std::size_t>(target));
+    ASSERT_TRUE(runtime.start());
+
+    // シャード A で受信したフレームがシャード B のバスから順番どおりに送信される
+    constexpr int FRAMES = 20;
+    int received         = 0;
+    for (int i = 0; i < FRAMES; i++) {
+        const uint8_t value = static_cast<uint8_t>(i);
+        pair_a.write_classic(motor_id(1), &value, 1);
+    }
+    EXPECT_TRUE(wait_until([&]() {
+        struct canfd_frame raw;
+        while (pair_b.read(raw) > 0) {
+            EXPECT_EQ(raw.can_id, motor_id(1));
+            EXPECT_EQ(raw.data[0], static_cast<uint8_t>(received));
+            received++;
+        }
+        return received == FRAMES;
+    }));
+    runtime.stop();
+
+    EXPECT_EQ(runtime.shard_stats(0).forwarded_frames, 0u);
+    EXPECT_EQ(runtime.shard_stats(1).forwarded_frames, static_cast<uint32_t>(FRAMES));
+    EXPECT_EQ(runtime.stats().tx_frames, static_cast<uint32_t>(FRAMES));
+    EXPECT_EQ(runtime.stats().forward_drops, 0u);
+}
+
+TEST(ShardedRuntimeTest, SendsFromOtherThreads)
+{
+    ShardedCANRuntime runtime;
+    const int shard = runtime.add_shard();
+
+    SocketPair pair;
+    DriverSocketCAN driver;
+    ASSERT_TRUE(driver.adopt(pair.driver_fd));
+    CANBus bus(driver);
+    const int target = runtime.add_bus(shard, bus, driver.fd());
+    ASSERT_GE(target, 0);
+    ASSERT_TRUE(runtime.start());
+
+    constexpr int THREADS = 2;
+    constexpr int FRAMES  = 300;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([&runtime, target, t]() {
+            for (int i = 0; i < FRAMES; i++) {
+                CANFrame frame;
+                frame.id      = static_cast<uint32_t>(0x100 + t);
+                frame.dlc     = 1;
+                frame.data[0] = static_cast<uint8_t>(i);
+                // 受け渡し用のバッファが満杯の間はシャードが送信するのを待つ
+                while (!runtime.send(static_cast<std::size_t>(target), CANFrameView(frame))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // 送信元スレッドごとの順番が保たれ、送信が詰まっても破棄されない
+    std::array<int, THREADS> next{};
+    int received = 0;
+    EXPECT_TRUE(wait_until([&]() {
+        struct canfd_frame raw;
+        while (pair.read(raw) > 0) {
+            const int t = static_cast<int>(raw.can_id) - 0x100;
+            EXPECT_GE(t, 0);
+            EXPECT_LT(t, THREADS);
+            if (t < 0 || t >= THREADS) {
+                continue;
+            }
+            EXPECT_EQ(raw.data[0], static_cast<uint8_t>(next[t]));
+            next[t]++;
+            received++;
+        }
+        return received == THREADS * FRAMES;
+    }));
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    runtime.stop();
+    EXPECT_EQ(runtime.stats().forwarded_frames, static_cast<uint32_t>(THREADS * FRAMES));
+}
+
+TEST(ShardedRuntimeTest, RejectsInvalidConfiguration)
+{
+    ShardedCANRuntime runtime;
+    EXPECT_FALSE(runtime.start());
+
+    SocketPair pair;
+    DriverSocketCAN driver;
+    ASSERT_TRUE(driver.adopt(pair.driver_fd));
+    CANBus bus(driver);
+
+    // 存在しないシャード、無効な fd
+    EXPECT_EQ(runtime.add_bus(0, bus, driver.fd()), -1);
+    const int shard = runtime.add_shard();
+    ASSERT_EQ(shard, 0);
+    EXPECT_EQ(runtime.add_bus(shard, bus, -1), -1);
+    ASSERT_EQ(runtime.add_bus(shard, bus, driver.fd()), 0);
+
+    CANFrame frame;
+    frame.id  = 0x100;
+    frame.dlc = 1;
+    EXPECT_FALSE(runtime.send(1, CANFrameView(frame)));
+
+    // 動作中はシャードとバスを追加できない
+    ASSERT_TRUE(runtime.start());
+    EXPECT_EQ(runtime.add_shard(), -1);
+    EXPECT_EQ(runtime.add_bus(0, bus, driver.fd()), -1);
+    EXPECT_FALSE(runtime.pinned(0));
+    EXPECT_FALSE(runtime.pinned(1));
+    runtime.stop();
+    EXPECT_EQ(runtime.shard_count(), 1u);
+    EXPECT_EQ(runtime.bus_count(), 1u);
+}
+
+TEST(ShardedRuntimeTest, PinsShardToCpu)
+{
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+    int cpu = 0;
+    while (!CPU_ISSET(cpu, &allowed)) {
+        cpu++;
+    }
+
+    ShardedCANRuntime runtime;
+    ASSERT_EQ(runtime.add_shard(cpu), 0);
+    ASSERT_TRUE(runtime.start());
+    runtime.stop();
+    EXPECT_TRUE(runtime.pinned(0));
+}
@@ -0,0 +1,315 @@
+#include <gtest/gtest.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <linux/can.h>
+#include <linux/can/error.h>
+#include <linux/can/raw.h>
+
+#include <cstring>
+#include <ctime>
+
+#include "drivers/socketcan/driver_socketcan.hpp"
+#include "gn10_can/core/can_bus.hpp"
+#include "gn10_can/core/can_device.hpp"
+#include "gn10_can/core/fdcan_bus.hpp"
+#include "counting_device.hpp"
+#include "socket_pair.hpp"
+
+using namespace gn10_can;
+using drivers::DriverSocketCAN;
+using drivers::DriverSocketCANFD;
+
+template <std::size_t MaxDLC>
+static detail::CANFrame<MaxDLC> make_frame(uint32_t id, const uint8_t* data, std::size_t length)
+{
+    detail::CANFrame<MaxDLC> frame;
+    frame.id = id;
+    frame.set_data(data, length);
+    return frame;
+}
+
+TEST(SocketCANTest, ReceivesBatchOfFrames)
+{
+    SocketPair pair;
+    DriverSocketCAN driver;
+    ASSERT_TRUE(driver.adopt(pair.driver_fd));
+
+    const uint8_t data[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    for (uint8_t i = 0; i < 20; i++) {
+        pair.write_classic(0x100 + i, data, i % 9);
+    }
+    pair.write_classic(0x1ABCDE | CAN_EFF_FLAG, data, 8);
+
+    std::array<CANFrame, 32> frames;
+    ASSERT_EQ(driver.receive_many(frames.data(), frames.size()), 21u);
+    for (uint8_t i = 0; i < 20; i++) {
+        EXPECT_EQ(frames[i].id, 0x100u + i);
+        EXPECT_FALSE(frames[i].is_extended);
+        EXPECT_EQ(frames[i].dlc, i % 9);
+        EXPECT_GT(frames[i].timestamp, 0u);
+    }
+
+    // 受信時刻は CLOCK_MONOTONIC [ns] で、受信順に戻らない
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    const uint64_t now_ns =
+        static_cast<uint64_t>(now.tv_sec) * 1000000000u + static_cast<uint64_t>(now.tv_nsec);
+    EXPECT_LE(frames[20].timestamp, now_ns);
+    EXPECT_GT(frames[0].timestamp, now_ns - 1000000000u);
+    for (uint8_t i = 1; i < 21; i++) {
+        EXPECT_GE(frames[i].timestamp, frames[i - 1].timestamp);
+    }
+    EXPECT_EQ(frames[20].id, 0x1ABCDEu);
+    EXPECT_TRUE(frames[20].is_extended);
+    EXPECT_EQ(frames[20].data[7], 8);
+
+    // ノンブロッキングで、受信データがなければすぐに戻る
+    CANFrame frame;
+    EXPECT_FALSE(driver.receive(frame));
+}
+
+TEST(SocketCANTest, SkipsFramesItCannotHandle)
+{
+    SocketPair pair;
+    DriverSocketCAN driver;
+    ASSERT_TRUE(driver.adopt(pair.driver_fd));
+
+    const uint8_t data[8]    = {};
+    const uint8_t garbage[5] = {};
+    ASSERT_EQ(::send(pair.peer_fd, garbage, sizeof(garbage), 0), 5);
+    pair.write_classic(0x123 | CAN_RTR_FLAG, data, 0);
+    pair.write_classic(CAN_ERR_FLAG | CAN_ERR_BUSOFF, data, 8);
+    pair.write_classic(0x124, data, 2);
+
+    CANFrame frame;
+    ASSERT_TRUE(driver.receive(frame));
+    EXPECT_EQ(frame.id, 0x124u);
+    EXPECT_FALSE(driver.receive(frame));
+}
+
+TEST(SocketCANTest, ClassicDriverDropsFDFrames)
+{
+    SocketPair pair;
+    DriverSocketCAN driver;
+    ASSERT_TRUE(driver.adopt(pair.driver_fd));
+
+    uint8_t data[64];
+    for (uint8_t i = 0; i < 64; i++) {
+        data[i] = i;
+    }
+    // 8バイトを超えるフレームは切り詰めずに破棄し、次のフレームを受信する
+    pair.write_fd(0x200, data, 12);
+    pair.write_fd(0x201, data, 8);
+
+    CANFrame frame;
+    ASSERT_TRUE(driver.receive(frame));
+    EXPECT_EQ(frame.id, 0x201u);
+    EXPECT_EQ(frame.dlc, 8);
+    EXPECT_EQ(frame.data[7], 7);
+    EXPECT_FALSE(driver.receive(frame));
+    EXPECT_EQ(driver.rx_oversize_count(), 1u);
+    EXPECT_EQ(driver.rx_overrun_count(), 1u);
+}
+
+TEST(SocketCANTest, FDDriverReceivesLongFrames)
+{
+    SocketPair pair;
+    DriverSocketCANFD driver;
+    ASSERT_TRUE(driver.adopt(pair.driver_fd));
+
+    uint8_t data[64];
+    for (uint8_t i = 0; i < 64; i++) {
+        data[i] = static_cast<uint8_t>(0xFF - i);
+    }
+    pair.write_fd(0x200, data, 48);
+    pair.write_classic(0x201, data, 8);
+
+    std::array<FDCANFrame, 4> frames;
+    ASSERT_EQ(driver.receive_many(frames.data(), frames.size()), 2u);
+    EXPECT_EQ(frames[0].dlc, 48);
+    EXPECT_EQ(frames[0].data[47], 0xFF - 47);
+    EXPECT_EQ(frames[1].dlc, 8);
+}
+
+TEST(SocketCANTest, SendsBatchOfClassicFrames)
+{
+    SocketPair pair;
+    DriverSocketCAN driver;
+    ASSERT_TRUE(driver.adopt(pair.driver_fd));
+
+    std::array<CANFrame, 40> frames;
+    for (std::size_t i = 0; i < frames.size(); i++) {
+        const uint8_t value = static_cast<uint8_t>(i);
+        frames[i]           = make_frame<8>(0x300 + static_cast<uint32_t>(i), &value, 1);
+    }
+    frames[39].id          = 0x12345;
+    frames[39].is_extended = true;
+    ASSERT_EQ(driver.send_many(frames.data(), frames.size()), frames.size());
+
+    struct canfd_frame raw;
+    for (std::size_t i = 0; i < 39; i++) {
+        ASSERT_EQ(pair.read(raw), static_cast<ssize_t>(CAN_MTU));
+        EXPECT_EQ(raw.can_id, 0x300u + i);
+        EXPECT_EQ(raw.len, 1);
+        EXPECT_EQ(raw.data[0], i);
+    }
+    ASSERT_EQ(pair.read(raw), static_cast<ssize_t>(CAN_MTU));
+    EXPECT_EQ(raw.can_id, 0x12345u | CAN_EFF_FLAG);
+    EXPECT_LT(pair.read(raw), 0);
+}
+
+TEST(SocketCANTest, SendsPaddedFDFrames)
+{
+    SocketPair pair;
+    DriverSocketCANFD driver;
+    ASSERT_TRUE(driver.adopt(pair.driver_fd));
+
+    uint8_t data[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    ASSERT_TRUE(driver.send(make_frame<64>(0x400, data, sizeof(data))));
+
+    struct canfd_frame raw;
+    ASSERT_EQ(pair.read(raw), static_cast<ssize_t>(CANFD_MTU));
+    EXPECT_EQ(raw.can_id, 0x400u);
+    EXPECT_EQ(raw.len, 12);
+    EXPECT_EQ(raw.flags & CANFD_BRS, CANFD_BRS);
+    EXPECT_EQ(raw.data[9], 10);
+    EXPECT_EQ(raw.data[10], fd::PADDING_BYTE);
+    EXPECT_EQ(raw.data[11], fd::PADDING_BYTE);
+
+    DriverSocketCANFD no_brs(false);
+    SocketPair other;
+    ASSERT_TRUE(no_brs.adopt(other.driver_fd));
+    ASSERT_TRUE(no_brs.send(make_frame<64>(0x401, data, 9)));
+    ASSERT_EQ(other.read(raw), static_cast<ssize_t>(CANFD_MTU));
+    EXPECT_EQ(raw.flags & CANFD_BRS, 0);
+}
+
+TEST(SocketCANTest, FDDriverSendsShortFramesAsClassic)
+{
+    SocketPair pair;
+    DriverSocketCANFD driver;
+    ASSERT_TRUE(driver.adopt(pair.driver_fd));
+
+    // クラシックCANのノードも受信できるように、8バイト以下は CAN_MTU で送る
+    uint8_t data[16] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    std::array<FDCANFrame, 3> frames = {
+        make_frame<64>(0x500, data, 8),
+        make_frame<64>(0x501, data, 16),
+        make_frame<64>(0x502, data, 0),
+    };
+    ASSERT_TRUE(driver.send(frames[0]));
+    ASSERT_EQ(driver.send_many(frames.data(), frames.size()), frames.size());
+
+    struct canfd_frame raw;
+    ASSERT_EQ(pair.read(raw), static_cast<ssize_t>(CAN_MTU));
+    EXPECT_EQ(raw.can_id, 0x500u);
+    EXPECT_EQ(raw.len, 8);
+    EXPECT_EQ(raw.data[7], 8);
+    ASSERT_EQ(pair.read(raw), static_cast<ssize_t>(CAN_MTU));
+    ASSERT_EQ(pair.read(raw), static_cast<ssize_t>(CANFD_MTU));
+    EXPECT_EQ(raw.len, 16);
+    EXPECT_EQ(raw.flags & CANFD_BRS, CANFD_BRS);
+    ASSERT_EQ(pair.read(raw), static_cast<ssize_t>(CAN_MTU));
+    EXPECT_EQ(raw.len, 0);
+}
+
+TEST(SocketCANTest, TxEventsAreOptIn)
+{
+    SocketPair pair;
+    DriverSocketCAN driver;
+    TxEvent event;
+
+    // 無効の間はエラーキューを読まない
+    ASSERT_TRUE(driver.adopt(pair.driver_fd));
+    EXPECT_FALSE(driver.receive_tx_event(event));
+
+    // 有効にしても受信フレームの制御メッセージは取りこぼさない
+    ASSERT_TRUE(driver.enable_tx_events());
+    const uint8_t data[8] = {1, 2, 3};
+    pair.write_classic(0x123, data, 3);
+    CANFrame frame;
+    ASSERT_TRUE(driver.receive(frame));
+    EXPECT_EQ(frame.id, 0x123u);
+    EXPECT_GT(frame.timestamp, 0u);
+    EXPECT_EQ(driver.rx_overrun_count(), 0u);
+
+    // socketpair にはエラーキューの送信時刻がない
+    ASSERT_TRUE(driver.send(frame));
+    EXPECT_FALSE(driver.receive_tx_event(event));
+}
+
+TEST(SocketCANTest, ClosedDriverDoesNothing)
+{
+    DriverSocketCAN driver;
+    EXPECT_EQ(driver.fd(), -1);
+    EXPECT_FALSE(driver.open("gn10-no-such-if"));
+
+    CANFrame frame;
+    EXPECT_FALSE(driver.send(frame));
+    EXPECT_FALSE(driver.receive(frame));
+    EXPECT_EQ(driver.send_many(&frame, 1), 0u);
+
+    // 開く前の受信フィルタは保持するだけ
+    AcceptanceFilter filter{0x080, 0x7E0};
+    EXPECT_TRUE(driver.set_filters(&filter, 1));
+    EXPECT_TRUE(driver.clear_filters());
+}
+
+TEST(SocketCANTest, DispatchesThroughBus)
+{
+    SocketPair pair;
+    DriverSocketCANFD driver;
+    ASSERT_TRUE(driver.adopt(pair.driver_fd));
+    FDCANBus bus(driver);
+    CountingDevice motor(bus, 2);
+
+    const uint8_t data[20] = {};
+    const uint32_t motor_id =
+        id::pack(id::DeviceType::MotorDriver, 2, id::MsgTypeMotorDriver::Feedback);
+    pair.write_fd(motor_id, data, 20);
+    pair.write_classic(motor_id, data, 8);
+    pair.write_classic(0x7FF, data, 8);
+
+    bus.update();
+    EXPECT_EQ(motor.count, 2);
+    EXPECT_EQ(motor.last_dlc, 8);
+}
+
+TEST(SocketCANTest, VirtualInterfaceRoundTrip)
+{
+    if (if_nametoindex("vcan0") == 0) {
+        GTEST_SKIP() << "vcan0 is not available";
+    }
+
+    DriverSocketCANFD sender;
+    DriverSocketCANFD receiver;
+    sender.enable_tx_events();
+    if (!sender.open("vcan0") || !receiver.open("vcan0")) {
+        GTEST_SKIP() << "vcan0 does not support CAN FD";
+    }
+
+    // カーネルの受信フィルタで他の ID を落とす
+    AcceptanceFilter filter{0x080, 0x7F8};
+    ASSERT_TRUE(receiver.set_filters(&filter, 1));
+
+    const uint8_t data[16] = {0xAA};
+    ASSERT_TRUE(sender.send(make_frame<64>(0x100, data, 16)));
+    ASSERT_TRUE(sender.send(make_frame<64>(0x081, data, 16)));
+    usleep(10000);
+
+    FDCANFrame frame;
+    ASSERT_TRUE(receiver.receive(frame));
+    EXPECT_EQ(frame.id, 0x081u);
+    EXPECT_EQ(frame.dlc, 16);
+    EXPECT_GT(frame.timestamp, 0u);
+    EXPECT_FALSE(receiver.receive(frame));
+
+    // 送出時刻はインターフェースのドライバが対応している場合のみ積まれる
+    TxEvent event;
+    while (sender.receive_tx_event(event)) {
+        EXPECT_TRUE(event.id == 0x100u || event.id == 0x081u);
+        EXPECT_GT(event.timestamp, 0u);
+    }
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <thread>
+#include <vector>
+
+#include "gn10_can/core/can_bus.hpp"
+#include "gn10_can/core/can_device.hpp"
+#include "gn10_can/core/spsc_ring.hpp"
+#include "counting_device.hpp"
+
+using namespace gn10_can;
+
+TEST(SPSCRingTest, PushPopKeepsOrder)
+{
+    SPSCRing<int, 4> ring;
+    EXPECT_TRUE(ring.empty());
+
+    EXPECT_TRUE(ring.push(1));
+    EXPECT_TRUE(ring.push(2));
+    EXPECT_TRUE(ring.push(3));
+    EXPECT_EQ(ring.size(), 3);
+
+    int value = 0;
+    EXPECT_TRUE(ring.pop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(ring.pop(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_TRUE(ring.pop(value));
+    EXPECT_EQ(value, 3);
+    EXPECT_FALSE(ring.pop(value));
+}
+
+TEST(SPSCRingTest, OverflowIsCountedAndDropsNewest)
+{
+    SPSCRing<int, 4> ring;
+    for (int i = 0; i < 6; i++) {
+        ring.push(i);
+    }
+
+    EXPECT_EQ(ring.size(), 4);
+    EXPECT_EQ(ring.overflow_count(), 2);
+    EXPECT_EQ(ring.high_water_mark(), 4);
+
+    std::array<int, 8> out{};
+    ASSERT_EQ(ring.pop_many(out.data(), out.size()), 4);
+    EXPECT_EQ(out[0], 0);
+    EXPECT_EQ(out[3], 3);
+}
+
+TEST(SPSCRingTest, PopManyWrapsAround)
+{
+    SPSCRing<int, 4> ring;
+    std::array<int, 4> out{};
+    int next = 0;
+
+    // 容量を何周もしてインデックスの折り返しを確認する
+    for (int round = 0; round < 10; round++) {
+        ring.push(next++);
+        ring.push(next++);
+        ring.push(next++);
+        ASSERT_EQ(ring.pop_many(out.data(), 2), 2);
+        EXPECT_EQ(out[0], next - 3);
+        EXPECT_EQ(out[1], next - 2);
+        ASSERT_EQ(ring.pop_many(out.data(), out.size()), 1);
+        EXPECT_EQ(out[0], next - 1);
+    }
+    EXPECT_EQ(ring.overflow_count(), 0);
+    EXPECT_EQ(ring.high_water_mark(), 3);
+}
+
+TEST(SPSCRingTest, ConcurrentProducerConsumer)
+{
+    constexpr int COUNT = 100000;
+    SPSCRing<int, 64> ring;
+
+    std::thread producer([&ring]() {
+        for (int i = 0; i < COUNT; i++) {
+            while (!ring.push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::array<int, 16> out{};
+    int expected = 0;
+    while (expected < COUNT) {
+        std::size_t count = ring.pop_many(out.data(), out.size());
+        if (count == 0) {
+            std::this_thread::yield();
+        }
+        for (std::size_t i = 0; i < count; i++) {
+            ASSERT_EQ(out[i], expected);
+            expected++;
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(ring.empty());
+}
+
+// 受信割り込みがリングバッファへ積み、update() がまとめて取り出すドライバ
+class RingDriver : public drivers::ICANDriver
+{
+public:
+    bool send(const CANFrame&) override
+    {
+        return true;
+    }
+
+    bool receive(CANFrame& out_frame) override
+    {
+        return rx_ring.pop(out_frame);
+    }
+
+    std::size_t receive_many(CANFrame* out_frames, std::size_t max_count) override
+    {
+        return rx_ring.pop_many(out_frames, max_count);
+    }
+
+    // 受信割り込みハンドラ相当
+    void on_rx_interrupt(const CANFrame& frame)
+    {
+        rx_ring.push(frame);
+    }
+
+    SPSCRing<CANFrame, 16> rx_ring;
+};
+
+TEST(SPSCRingTest, BusUpdateDrainsInterruptRing)
+{
+    RingDriver driver;
+    CANBus bus(driver);
+    CountingDevice device(bus, 1);
+
+    CANFrame frame;
+    frame.id  = device.get_routing_id() << id::BIT_WIDTH_COMMAND;
+    frame.dlc = 1;
+    for (uint8_t i = 0; i < 20; i++) {
+        frame.data[0] = i;
+        driver.on_rx_interrupt(frame);
+    }
+    bus.update();
+
+    // 容量を超えた分は破棄され、残りは順序通り配送される
+    ASSERT_EQ(device.values.size(), 16);
+    EXPECT_EQ(device.values.front(), 0);
+    EXPECT_EQ(device.values.back(), 15);
+    EXPECT_EQ(driver.rx_ring.overflow_count(), 4);
+}
@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "drivers/socketcan/driver_socketcan.hpp"
+#include "drivers/socketcan/threaded_bus.hpp"
+#include "gn10_can/core/can_bus.hpp"
+#include "gn10_can/devices/motor_driver_client.hpp"
+#include "gn10_can/devices/motor_driver_server.hpp"
+
+using namespace gn10_can;
+using drivers::DeviceSnapshot;
+using drivers::DriverSocketCAN;
+using drivers::ThreadedCANBus;
+
+struct MotorState {
+    float feedback;
+    uint8_t limit_switches;
+};
+
+// 制御側 (ThreadedCANBus) とモータードライバ側 (CANBus) をソケットの組でつなぐ
+class ThreadedBusTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        int fds[2];
+        ASSERT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds), 0);
+        ASSERT_TRUE(host_driver.adopt(fds[0]));
+        ASSERT_TRUE(node_driver.adopt(fds[1]));
+    }
+
+    // 条件が満たされるまで待つ
+    template <typename Condition>
+    bool wait_until(Condition condition)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (!condition()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            node_bus.update();
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        return true;
+    }
+
+    DriverSocketCAN host_driver;
+    DriverSocketCAN node_driver;
+    CANBus node_bus{node_driver};
+};
+
+TEST_F(ThreadedBusTest, ReceivesOnIOThreadAndPublishesSnapshots)
+{
+    ThreadedCANBus bus(host_driver, host_driver.fd());
+    devices::MotorDriverClient motor(bus, 1);
+    devices::MotorDriverServer node(node_bus, 1);
+
+    DeviceSnapshot<devices::MotorDriverClient, MotorState> snapshot(
+        motor, [](const devices::MotorDriverClient& client) {
+            return MotorState{client.feedback_value(), client.limit_switches()};
+        }
+    );
+    ASSERT_TRUE(bus.add_snapshot(snapshot));
+    ASSERT_TRUE(bus.start());
+    EXPECT_FALSE(bus.start());
+    EXPECT_FALSE(bus.add_snapshot(snapshot));
+
+    node.send_feedback(12.5f, 0x03);
+    ASSERT_TRUE(wait_until([&snapshot]() { return snapshot.version() > 0; }));
+    MotorState state = snapshot.read();
+    EXPECT_FLOAT_EQ(state.feedback, 12.5f);
+    EXPECT_EQ(state.limit_switches, 0x03);
+
+    bus.stop();
+    EXPECT_FALSE(bus.running());
+}
+
+TEST_F(ThreadedBusTest, ControlThreadsSendWithoutTouchingDriver)
+{
+    ThreadedCANBus bus(host_driver, host_driver.fd());
+    devices::MotorDriverClient motor(bus, 2);
+    devices::MotorDriverServer node(node_bus, 2);
+    ASSERT_TRUE(bus.start());
+
+    motor.set_target(3.0f);
+    float target = 0.0f;
+    ASSERT_TRUE(wait_until([&node, &target]() { return node.get_new_target(target); }));
+    EXPECT_FLOAT_EQ(target, 3.0f);
+}
+
+TEST_F(ThreadedBusTest, ManyControlThreadsShareTheBus)
+{
+    constexpr int THREADS = 4;
+    constexpr int FRAMES  = 500;
+
+    ThreadedCANBus bus(host_driver, host_driver.fd());
+    ASSERT_TRUE(bus.start());
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([&bus, t]() {
+            for (int i = 0; i < FRAMES; i++) {
+                CANFrame frame;
+                frame.id      = static_cast<uint32_t>(0x100 + t);
+                frame.dlc     = 1;
+                frame.data[0] = static_cast<uint8_t>(i);
+                // 受け渡し用のバッファが満杯の間は I/O スレッドが送信するのを待つ
+                while (!bus.send_frame(CANFrameView(frame))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // スレッドごとの送信順が保たれ、送信が詰まっても破棄されない
+    std::array<int, THREADS> next{};
+    int received        = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (received < THREADS * FRAMES && std::chrono::steady_clock::now() < deadline) {
+        CANFrame frame;
+        if (!node_driver.receive(frame)) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+            continue;
+        }
+        const int t = static_cast<int>(frame.id) - 0x100;
+        ASSERT_GE(t, 0);
+        ASSERT_LT(t, THREADS);
+        EXPECT_EQ(frame.data[0], static_cast<uint8_t>(next[t]));
+        next[t]++;
+        received++;
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(received, THREADS * FRAMES);
+}
+
+TEST_F(ThreadedBusTest, FramesSentDuringStopAreNotLost)
+{
+    constexpr int FRAMES = 150;
+
+    ThreadedCANBus bus(host_driver, host_driver.fd());
+    ASSERT_TRUE(bus.start());
+
+    // 送信の途中で stop() する (受け付けた送信フレームは全て送信される)
+    std::atomic<bool> halfway{false};
+    int accepted = 0;
+    std::thread sender([&bus, &halfway, &accepted]() {
+        for (int i = 0; i < FRAMES; i++) {
+            if (i == FRAMES / 2) {
+                halfway.store(true);
+            }
+            CANFrame frame;
+            frame.id      = 0x200;
+            frame.dlc     = 1;
+            frame.data[0] = static_cast<uint8_t>(i);
+            // 受け渡し用のバッファが満杯の間は I/O スレッドが送信するのを待つ
+            while (!bus.send_frame(CANFrameView(frame))) {
+                std::this_thread::yield();
+            }
+            accepted++;
+        }
+    });
+    while (!halfway.load()) {
+        std::this_thread::yield();
+    }
+    bus.stop();
+    sender.join();
+    EXPECT_FALSE(bus.running());
+
+    // 停止後の送信キューの残りは呼び出し側の update() で送信する
+    bus.update();
+    int received = 0;
+    CANFrame frame;
+    while (node_driver.receive(frame)) {
+        EXPECT_EQ(frame.data[0], static_cast<uint8_t>(received));
+        received++;
+    }
+    EXPECT_EQ(received, accepted);
+    EXPECT_EQ(accepted, FRAMES);
+}
+
+TEST_F(ThreadedBusTest, SendsDirectlyWhenStopped)
+{
+    ThreadedCANBus bus(host_driver);
+    EXPECT_FALSE(bus.running());
+
+    CANFrame frame;
+    frame.id  = 0x123;
+    frame.dlc = 2;
+    ASSERT_TRUE(bus.send_frame(CANFrameView(frame)));
+
+    CANFrame received;
+    ASSERT_TRUE(node_driver.receive(received));
+    EXPECT_EQ(received.id, 0x123u);
+}
+
+TEST_F(ThreadedBusTest, PollsDriverWithoutDescriptor)
+{
+    ThreadedCANBus bus(host_driver);
+    devices::MotorDriverClient motor(bus, 3);
+    devices::MotorDriverServer node(node_bus, 3);
+
+    DeviceSnapshot<devices::MotorDriverClient, MotorState> snapshot(
+        motor, [](const devices::MotorDriverClient& client) {
+            return MotorState{client.feedback_value(), client.limit_switches()};
+        }
+    );
+    ASSERT_TRUE(bus.add_snapshot(snapshot));
+    ASSERT_TRUE(bus.start());
+
+    node.send_feedback(-1.0f, 0);
+    ASSERT_TRUE(wait_until([&snapshot]() { return snapshot.version() > 0; }));
+    EXPECT_FLOAT_EQ(snapshot.read().feedback, -1.0f);
+}
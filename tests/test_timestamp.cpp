@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include "gn10_can/core/can_bus.hpp"
+#include "gn10_can/devices/motor_driver_client.hpp"
+#include "gn10_can/utils/can_converter.hpp"
+#include "gn10_can/utils/timestamp_extender.hpp"
+#include "mock_driver.hpp"
+
+using namespace gn10_can;
+
+TEST(TimestampExtenderTest, ExtendsAcrossWrapAround)
+{
+    TimestampExtender extender;
+    uint64_t first  = extender.extend(0xFFF0);
+    uint64_t second = extender.extend(0x0010);
+
+    EXPECT_NE(first, 0u);
+    EXPECT_EQ(second - first, 0x20u);
+}
+
+TEST(TimestampExtenderTest, LateSampleReturnsPastTime)
+{
+    // 送信完了イベントのように、直前の受信より古い時刻が後から届く場合
+    TimestampExtender extender;
+    uint64_t rx      = extender.extend(0x0100);
+    uint64_t tx      = extender.extend(0x00F0);
+    uint64_t rx_next = extender.extend(0x0110);
+
+    EXPECT_EQ(rx - tx, 0x10u);
+    EXPECT_EQ(rx_next - rx, 0x10u);
+}
+
+TEST(TimestampTest, FrameViewCarriesTimestamp)
+{
+    CANFrame frame;
+    frame.timestamp = 12345;
+
+    CANFrameView view = frame;
+    EXPECT_EQ(view.timestamp, 12345u);
+    EXPECT_EQ(CANFrame(view).timestamp, 12345u);
+}
+
+TEST(TimestampTest, DeviceExposesReceiveTimePerCommand)
+{
+    MockDriver driver;
+    CANBus bus{driver};
+    devices::MotorDriverClient motor(bus, 1);
+
+    std::array<uint8_t, 5> payload{};
+    converter::pack(payload, 0, 0.5f);
+    CANFrame feedback = CANFrame::make(
+        id::DeviceType::MotorDriver,
+        1,
+        id::MsgTypeMotorDriver::Feedback,
+        payload.data(),
+        payload.size()
+    );
+    feedback.timestamp = 1000;
+    driver.push_receive_frame(feedback);
+    bus.update();
+
+    EXPECT_FLOAT_EQ(motor.feedback_value(), 0.5f);
+    EXPECT_EQ(motor.rx_timestamp(id::MsgTypeMotorDriver::Feedback), 1000u);
+    EXPECT_EQ(motor.rx_timestamp(id::MsgTypeMotorDriver::HardwareStatus), 0u);
+}
+
+TEST(TimestampTest, TxEventsPassThroughBus)
+{
+    class TxEventDriver : public MockDriver
+    {
+    public:
+        bool receive_tx_event(TxEvent& out_event) override
+        {
+            if (!has_event) {
+                return false;
+            }
+            out_event = event;
+            has_event = false;
+            return true;
+        }
+
+        TxEvent event;
+        bool has_event = false;
+    };
+
+    TxEventDriver driver;
+    CANBus bus{driver};
+
+    TxEvent event;
+    EXPECT_FALSE(bus.receive_tx_event(event));
+
+    driver.event.id        = 0x123;
+    driver.event.timestamp = 42;
+    driver.has_event       = true;
+    ASSERT_TRUE(bus.receive_tx_event(event));
+    EXPECT_EQ(event.id, 0x123u);
+    EXPECT_EQ(event.timestamp, 42u);
+}
@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "gn10_can/core/can_bus.hpp"
+#include "gn10_can/core/tx_queue.hpp"
+#include "gn10_can/devices/motor_driver_client.hpp"
+#include "gn10_can/utils/can_converter.hpp"
+#include "mock_driver.hpp"
+
+using namespace gn10_can;
+
+// 送信メールボックスの数を制限したドライバ
+class MailboxDriver : public MockDriver
+{
+public:
+    bool send(const CANFrame& frame) override
+    {
+        if (free_mailboxes == 0) {
+            return false;
+        }
+        free_mailboxes--;
+        return MockDriver::send(frame);
+    }
+
+    // 送信完了割り込み相当
+    void complete(std::size_t count)
+    {
+        free_mailboxes += count;
+    }
+
+    std::size_t free_mailboxes = 3;
+};
+
+static CANFrame make_frame(uint32_t id, bool is_extended = false)
+{
+    CANFrame frame;
+    frame.id          = id;
+    frame.is_extended = is_extended;
+    return frame;
+}
+
+TEST(TxQueueTest, PopsInArbitrationOrder)
+{
+    detail::TxQueue<CANFrame, 8> queue;
+    queue.push(make_frame(0x300));
+    queue.push(make_frame(0x010));
+    queue.push(make_frame(0x7FF));
+    queue.push(make_frame(0x100));
+
+    std::vector<uint32_t> ids;
+    while (!queue.empty()) {
+        ids.push_back(queue.top().id);
+        queue.pop();
+    }
+    EXPECT_EQ(ids, (std::vector<uint32_t>{0x010, 0x100, 0x300, 0x7FF}));
+}
+
+TEST(TxQueueTest, SameIdKeepsFifoOrder)
+{
+    detail::TxQueue<CANFrame, 8> queue;
+    for (uint8_t i = 0; i < 5; i++) {
+        CANFrame frame = make_frame(0x123);
+        frame.dlc      = 1;
+        frame.data[0]  = i;
+        queue.push(frame);
+    }
+
+    for (uint8_t i = 0; i < 5; i++) {
+        EXPECT_EQ(queue.top().data[0], i);
+        queue.pop();
+    }
+}
+
+TEST(TxQueueTest, StandardBeatsExtendedWithSameBaseId)
+{
+    // 拡張ID 0x04000000 のベースIDは 0x100
+    detail::TxQueue<CANFrame, 8> queue;
+    queue.push(make_frame(0x04000000, true));
+    queue.push(make_frame(0x100));
+    queue.push(make_frame(0x03FFFFFF, true));  // ベースID 0x0FF
+
+    EXPECT_EQ(queue.top().id, 0x03FFFFFFu);
+    queue.pop();
+    EXPECT_EQ(queue.top().id, 0x100u);
+    EXPECT_FALSE(queue.top().is_extended);
+    queue.pop();
+    EXPECT_EQ(queue.top().id, 0x04000000u);
+}
+
+TEST(TxQueueTest, RejectsWhenFull)
+{
+    detail::TxQueue<CANFrame, 2> queue;
+    EXPECT_TRUE(queue.push(make_frame(1)));
+    EXPECT_TRUE(queue.push(make_frame(2)));
+    EXPECT_FALSE(queue.push(make_frame(3)));
+    EXPECT_EQ(queue.high_water_mark(), 2);
+}
+
+TEST(CANBusTxQueueTest, BurstIsQueuedInsteadOfDropped)
+{
+    MailboxDriver driver;
+    CANBus bus{driver};
+
+    // 8台分の目標値を1制御周期でまとめて送信する
+    std::vector<std::unique_ptr<devices::MotorDriverClient>> motors;
+    for (uint8_t i = 0; i < 8; i++) {
+        motors.push_back(std::make_unique<devices::MotorDriverClient>(bus, i));
+    }
+    for (auto& motor : motors) {
+        motor->set_target(0.5f);
+    }
+
+    EXPECT_EQ(driver.sent_frames.size(), 3);
+    EXPECT_EQ(bus.tx_queue_size(), 5);
+    EXPECT_EQ(bus.tx_queue_high_water_mark(), 5);
+
+    // 送信完了ごとに空いたメールボックスへ補充される
+    driver.complete(3);
+    bus.on_tx_complete();
+    EXPECT_EQ(driver.sent_frames.size(), 6);
+
+    driver.complete(3);
+    bus.on_tx_complete();
+    EXPECT_EQ(driver.sent_frames.size(), 8);
+    EXPECT_EQ(bus.tx_queue_size(), 0);
+    EXPECT_EQ(bus.tx_dropped_count(), 0);
+}
+
+TEST(CANBusTxQueueTest, UrgentFrameOvertakesQueuedTelemetry)
+{
+    MailboxDriver driver;
+    driver.free_mailboxes = 0;
+    CANBus bus{driver};
+
+    bus.send_frame(make_frame(0x700));
+    bus.send_frame(make_frame(0x600));
+    bus.send_frame(make_frame(0x010));
+
+    driver.complete(1);
+    bus.on_tx_complete();
+    ASSERT_EQ(driver.sent_frames.size(), 1);
+    EXPECT_EQ(driver.sent_frames[0].id, 0x010u);
+
+    // update() でも送信キューが処理される
+    driver.complete(2);
+    bus.update();
+    ASSERT_EQ(driver.sent_frames.size(), 3);
+    EXPECT_EQ(driver.sent_frames[1].id, 0x600u);
+    EXPECT_EQ(driver.sent_frames[2].id, 0x700u);
+}
+
+TEST(CANBusTxQueueTest, OverflowIsCountedAndReported)
+{
+    MailboxDriver driver;
+    driver.free_mailboxes = 0;
+    CANBus bus{driver};
+
+    for (std::size_t i = 0; i < CANBus::TX_QUEUE_SIZE; i++) {
+        EXPECT_TRUE(bus.send_frame(make_frame(0x100)));
+    }
+    EXPECT_FALSE(bus.send_frame(make_frame(0x100)));
+    EXPECT_EQ(bus.tx_dropped_count(), 1);
+    EXPECT_EQ(bus.tx_queue_size(), CANBus::TX_QUEUE_SIZE);
+}
+
+TEST(CANBusTxQueueTest, LockedBusAcceptsCustomLock)
+{
+    MailboxDriver driver;
+    LockedCANBus<std::mutex> bus{driver};
+
+    EXPECT_TRUE(bus.send_frame(make_frame(0x100)));
+    EXPECT_EQ(driver.sent_frames.size(), 1);
+}
+
+TEST(TxQueueTest, ReplaceKeepsPositionAndUpdatesData)
+{
+    detail::TxQueue<CANFrame, 8> queue;
+    queue.push(make_frame(0x200));
+    CANFrame target = make_frame(0x100);
+    target.dlc      = 1;
+    target.data[0]  = 1;
+    queue.push(target);
+
+    target.data[0] = 2;
+    EXPECT_TRUE(queue.replace(target));
+    EXPECT_FALSE(queue.replace(make_frame(0x300)));
+    EXPECT_EQ(queue.size(), 2);
+
+    EXPECT_EQ(queue.top().id, 0x100u);
+    EXPECT_EQ(queue.top().data[0], 2);
+}
+
+TEST(CANBusTxQueueTest, SetpointsCoalesceToLatestValue)
+{
+    MailboxDriver driver;
+    driver.free_mailboxes = 0;
+    CANBus bus{driver};
+
+    std::vector<std::unique_ptr<devices::MotorDriverClient>> motors;
+    for (uint8_t i = 0; i < 8; i++) {
+        motors.push_back(std::make_unique<devices::MotorDriverClient>(bus, i));
+    }
+
+    // 過負荷中に何度も目標値を更新しても、保持数はモーター数で頭打ちになる
+    for (int cycle = 1; cycle <= 10; cycle++) {
+        for (auto& motor : motors) {
+            motor->set_target(0.1f * static_cast<float>(cycle));
+        }
+    }
+    EXPECT_EQ(bus.tx_queue_size(), 8);
+    EXPECT_EQ(bus.tx_coalesced_count(), 72);
+    EXPECT_EQ(bus.tx_dropped_count(), 0);
+
+    driver.complete(8);
+    bus.on_tx_complete();
+    ASSERT_EQ(driver.sent_frames.size(), 8);
+    for (const auto& frame : driver.sent_frames) {
+        float target = 0.0f;
+        ASSERT_TRUE(converter::unpack(frame.data, 0, target));
+        EXPECT_FLOAT_EQ(target, 1.0f);
+    }
+}
+
+TEST(CANBusTxQueueTest, PlainSendIsNotCoalesced)
+{
+    MailboxDriver driver;
+    driver.free_mailboxes = 0;
+    CANBus bus{driver};
+
+    bus.send_frame(make_frame(0x100));
+    bus.send_frame(make_frame(0x100));
+    EXPECT_EQ(bus.tx_queue_size(), 2);
+    EXPECT_EQ(bus.tx_coalesced_count(), 0);
+}